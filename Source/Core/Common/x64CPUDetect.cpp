@@ -198,6 +198,8 @@ void CPUInfo::Detect()
     if (func_id_max >= 7)
     {
       info = cpuid(7);
+      if (((info.ebx >> 5) & 1) && bAVX)
+        bAVX2 = true;
       if ((info.ebx >> 3) & 1)
         bBMI1 = true;
       if ((info.ebx >> 8) & 1)
@@ -258,6 +260,8 @@ std::string CPUInfo::Summarize()
     sum.push_back("HTT");
   if (bAVX)
     sum.push_back("AVX");
+  if (bAVX2)
+    sum.push_back("AVX2");
   if (bBMI1)
     sum.push_back("BMI1");
   if (bBMI2)
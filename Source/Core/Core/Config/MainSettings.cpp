@@ -41,6 +41,13 @@ const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_FASTMEM_ARENA{{System::Main, "Core", "FastmemArena"}, true};
 const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP{{System::Main, "Core", "LargeEntryPointsMap"}, true};
+const Info<bool> MAIN_JIT_BLOCK_PROFILE{{System::Main, "Core", "JITBlockProfile"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
+const Info<int> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 1000};
+const Info<bool> MAIN_JIT_HOT_TRACES{{System::Main, "Core", "JITHotTraces"}, false};
+const Info<bool> MAIN_JIT_PINNED_REGISTERS{{System::Main, "Core", "JITPinnedRegisters"},
+                                          false};
 const Info<bool> MAIN_ACCURATE_CPU_CACHE{{System::Main, "Core", "AccurateCPUCache"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_MAX_FALLBACK{{System::Main, "Core", "MaxFallback"}, 100};
@@ -141,6 +148,11 @@ const Info<std::string> MAIN_BBA_TAPSERVER_DESTINATION{
     {System::Main, "Core", "BBA_TAPSERVER_DESTINATION"}, "/tmp/dolphin-tap"};
 const Info<std::string> MAIN_MODEM_TAPSERVER_DESTINATION{
     {System::Main, "Core", "MODEM_TAPSERVER_DESTINATION"}, "/tmp/dolphin-modem-tap"};
+const Info<bool> MAIN_TRIFORCE_VIRTUAL_LAN{{System::Main, "Core", "TriforceVirtualLAN"}, false};
+const Info<std::string> MAIN_TRIFORCE_VIRTUAL_LAN_IP{
+    {System::Main, "Core", "TriforceVirtualLANIP"}, ""};
+const Info<bool> MAIN_TRIFORCE_COMMAND_TRACE{{System::Main, "Core", "TriforceCommandTrace"},
+                                             false};
 const Info<std::string> MAIN_BBA_BUILTIN_IP{{System::Main, "Core", "BBA_BUILTIN_IP"}, ""};
 
 const Info<SerialInterface::SIDevices>& GetInfoForSIDevice(int channel)
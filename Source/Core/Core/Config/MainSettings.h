@@ -58,6 +58,11 @@ extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
+extern const Info<bool> MAIN_JIT_BLOCK_PROFILE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<int> MAIN_JIT_TIER_UP_THRESHOLD;
+extern const Info<bool> MAIN_JIT_HOT_TRACES;
+extern const Info<bool> MAIN_JIT_PINNED_REGISTERS;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -98,6 +103,9 @@ extern const Info<std::string> MAIN_BBA_BUILTIN_DNS;
 extern const Info<std::string> MAIN_BBA_BUILTIN_IP;
 extern const Info<std::string> MAIN_BBA_TAPSERVER_DESTINATION;
 extern const Info<std::string> MAIN_MODEM_TAPSERVER_DESTINATION;
+extern const Info<bool> MAIN_TRIFORCE_VIRTUAL_LAN;
+extern const Info<std::string> MAIN_TRIFORCE_VIRTUAL_LAN_IP;
+extern const Info<bool> MAIN_TRIFORCE_COMMAND_TRACE;
 const Info<SerialInterface::SIDevices>& GetInfoForSIDevice(int channel);
 const Info<bool>& GetInfoForAdapterRumble(int channel);
 const Info<bool>& GetInfoForSimulateKonga(int channel);
@@ -4,9 +4,11 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -102,6 +104,7 @@ void CoreTimingManager::Init()
   m_globals.slice_length = MAX_SLICE_LENGTH;
   m_globals.global_timer = 0;
   m_idled_cycles = 0;
+  m_idle_loop_stats.clear();
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -118,6 +121,8 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
+  LogIdleLoopStats();
+
   std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
@@ -231,6 +236,34 @@ u64 CoreTimingManager::GetIdleTicks() const
   return static_cast<u64>(m_idled_cycles);
 }
 
+const std::unordered_map<u32, IdleLoopStats>& CoreTimingManager::GetIdleLoopStats() const
+{
+  return m_idle_loop_stats;
+}
+
+void CoreTimingManager::LogIdleLoopStats() const
+{
+  if (m_idle_loop_stats.empty())
+    return;
+
+  std::vector<std::pair<u32, IdleLoopStats>> loops(m_idle_loop_stats.begin(),
+                                                   m_idle_loop_stats.end());
+  std::ranges::sort(loops, std::greater{}, [](const auto& loop) { return loop.second.cycles; });
+
+  u64 loop_cycles = 0;
+  for (const auto& loop : loops)
+    loop_cycles += loop.second.cycles;
+
+  constexpr size_t MAX_LOOPS = 10;
+  INFO_LOG_FMT(POWERPC, "Skipped {} idle cycles, {} of them in {} busy wait loops:", m_idled_cycles,
+               loop_cycles, loops.size());
+  for (size_t i = 0; i < std::min(loops.size(), MAX_LOOPS); ++i)
+  {
+    const auto& [address, stats] = loops[i];
+    INFO_LOG_FMT(POWERPC, "  {:08x}: {} cycles in {} skips", address, stats.cycles, stats.skips);
+  }
+}
+
 void CoreTimingManager::ClearPendingEvents()
 {
   m_event_queue.clear();
@@ -461,7 +494,7 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
   }
 }
 
-void CoreTimingManager::Idle()
+void CoreTimingManager::Idle(u32 loop_address)
 {
   if (m_config_sync_on_skip_idle)
   {
@@ -473,8 +506,16 @@ void CoreTimingManager::Idle()
 
   auto& ppc_state = m_system.GetPPCState();
   PowerPC::UpdatePerformanceMonitor(ppc_state.downcount, 0, 0, ppc_state);
-  m_idled_cycles += DowncountToCycles(ppc_state.downcount);
+  const s64 cycles = DowncountToCycles(ppc_state.downcount);
+  m_idled_cycles += cycles;
   ppc_state.downcount = 0;
+
+  if (loop_address != 0)
+  {
+    IdleLoopStats& stats = m_idle_loop_stats[loop_address];
+    ++stats.skips;
+    stats.cycles += cycles;
+  }
 }
 
 std::string CoreTimingManager::GetScheduledEventsSummary() const
@@ -536,9 +577,9 @@ void GlobalAdvance()
   Core::System::GetInstance().GetCoreTiming().Advance();
 }
 
-void GlobalIdle()
+void GlobalIdle(u32 loop_address)
 {
-  Core::System::GetInstance().GetCoreTiming().Idle();
+  Core::System::GetInstance().GetCoreTiming().Idle(loop_address);
 }
 
 }  // namespace CoreTiming
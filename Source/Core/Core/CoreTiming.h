@@ -69,9 +69,16 @@ enum class FromThread
   ANY
 };
 
+// The cycles skipped while the CPU was spinning in one busy wait loop
+struct IdleLoopStats
+{
+  u64 skips = 0;
+  u64 cycles = 0;
+};
+
 // helpers until the JIT is updated to use the instance
 void GlobalAdvance();
-void GlobalIdle();
+void GlobalIdle(u32 loop_address);
 
 class CoreTimingManager
 {
@@ -87,6 +94,8 @@ public:
   // doing something evil
   u64 GetTicks() const;
   u64 GetIdleTicks() const;
+  // The skipped cycles of each busy wait loop since Init, keyed by the address of the loop
+  const std::unordered_map<u32, IdleLoopStats>& GetIdleLoopStats() const;
 
   void RefreshConfig();
 
@@ -117,8 +126,9 @@ public:
   void Advance();
   void MoveEvents();
 
-  // Pretend that the main CPU has executed enough cycles to reach the next event.
-  void Idle();
+  // Pretend that the main CPU has executed enough cycles to reach the next event. loop_address is
+  // the start of the busy wait loop the CPU is spinning in, or 0 if it isn't in one.
+  void Idle(u32 loop_address = 0);
 
   // Clear all pending events. This should ONLY be done on exit or state load.
   void ClearPendingEvents();
@@ -154,6 +164,8 @@ public:
   bool UseSyncOnSkipIdle() const;
 
 private:
+  void LogIdleLoopStats() const;
+
   Globals m_globals;
 
   Core::System& m_system;
@@ -175,6 +187,7 @@ private:
   float m_last_oc_factor = 0.0f;
 
   s64 m_idled_cycles = 0;
+  std::unordered_map<u32, IdleLoopStats> m_idle_loop_stats;
   u32 m_fake_dec_start_value = 0;
   u64 m_fake_dec_start_ticks = 0;
 
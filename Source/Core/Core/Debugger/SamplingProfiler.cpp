@@ -0,0 +1,415 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Debugger/SamplingProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/HookableEvent.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/MachineContext.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "VideoCommon/VideoEvents.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <csignal>
+#include <pthread.h>
+#include <unistd.h>  // Needed for _POSIX_VERSION
+#endif
+
+namespace SamplingProfiler
+{
+namespace
+{
+struct Sample
+{
+  uintptr_t host_pc;
+  u32 guest_pc;
+};
+
+constexpr u32 RING_SIZE = 4096;
+// Pending samples are attributed on the CPU thread once there are this many of them, or after
+// DRAIN_FIELDS fields, whichever comes first. Looking up the blocks walks the whole block cache.
+constexpr u32 DRAIN_THRESHOLD = RING_SIZE / 2;
+constexpr u32 DRAIN_FIELDS = 60;
+
+// Single producer (the sampler), single consumer (whoever drains the samples)
+std::array<Sample, RING_SIZE> s_ring;
+std::atomic<u32> s_ring_head{0};
+std::atomic<u32> s_ring_tail{0};
+std::atomic<u64> s_dropped{0};
+
+std::atomic<bool> s_active{false};
+const PowerPC::PowerPCState* s_ppc_state = nullptr;
+
+Core::System* s_system = nullptr;
+std::chrono::microseconds s_interval;
+Common::EventHook s_end_field_hook;
+int s_state_changed_callback = -1;
+bool s_attach_failed = false;
+u32 s_fields_since_drain = 0;
+std::thread s_timer_thread;
+Common::Event s_stop_event;
+
+struct SampleCounts
+{
+  u64 jit = 0;
+  u64 host = 0;
+};
+
+std::vector<Sample> s_pending;
+std::vector<uintptr_t> s_pending_host_pcs;
+std::vector<std::optional<u32>> s_pending_blocks;
+std::map<std::string, u64> s_stacks;
+std::map<std::string, SampleCounts> s_functions;
+u64 s_total_samples = 0;
+
+void PushSample(uintptr_t host_pc, u32 guest_pc)
+{
+  const u32 head = s_ring_head.load(std::memory_order_relaxed);
+  if (head - s_ring_tail.load(std::memory_order_acquire) == RING_SIZE)
+  {
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  s_ring[head % RING_SIZE] = {host_pc, guest_pc};
+  s_ring_head.store(head + 1, std::memory_order_release);
+}
+
+#if defined(_M_GENERIC) || defined(__APPLE__)
+
+bool AttachToCPUThread()
+{
+  return false;
+}
+
+void DetachFromCPUThread()
+{
+}
+
+void SampleCPUThread()
+{
+}
+
+#elif defined(_WIN32)
+
+HANDLE s_cpu_thread = nullptr;
+
+bool AttachToCPUThread()
+{
+  return DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(),
+                         &s_cpu_thread, THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, 0);
+}
+
+void DetachFromCPUThread()
+{
+  CloseHandle(s_cpu_thread);
+  s_cpu_thread = nullptr;
+}
+
+void SampleCPUThread()
+{
+  if (SuspendThread(s_cpu_thread) == static_cast<DWORD>(-1))
+    return;
+
+  // Don't allocate anything while the thread is suspended, it may be holding the heap lock
+  CONTEXT context{};
+  context.ContextFlags = CONTEXT_CONTROL;
+  const bool got_context = GetThreadContext(s_cpu_thread, &context);
+  const u32 guest_pc = s_ppc_state->pc;
+  ResumeThread(s_cpu_thread);
+
+  if (got_context)
+    PushSample(static_cast<uintptr_t>(context.CTX_PC), guest_pc);
+}
+
+#elif defined(_POSIX_VERSION)
+
+pthread_t s_cpu_thread;
+
+void SignalHandler(int, siginfo_t*, void* raw_context)
+{
+  if (!s_active.load(std::memory_order_relaxed))
+    return;
+
+  const ucontext_t* context = static_cast<const ucontext_t*>(raw_context);
+#ifdef __OpenBSD__
+  const ucontext_t* ctx = context;
+#else
+  const mcontext_t* ctx = &context->uc_mcontext;
+#endif
+  PushSample(static_cast<uintptr_t>(ctx->CTX_PC), s_ppc_state->pc);
+}
+
+bool AttachToCPUThread()
+{
+  s_cpu_thread = pthread_self();
+
+  // The handler stays installed afterwards. A SIGPROF still in flight when sampling stops must not
+  // reach the default action, which terminates the process.
+  static bool s_handler_installed = false;
+  if (s_handler_installed)
+    return true;
+
+  struct sigaction sa;
+  sa.sa_sigaction = &SignalHandler;
+  sa.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  s_handler_installed = sigaction(SIGPROF, &sa, nullptr) == 0;
+  return s_handler_installed;
+}
+
+void DetachFromCPUThread()
+{
+}
+
+void SampleCPUThread()
+{
+  pthread_kill(s_cpu_thread, SIGPROF);
+}
+
+#else
+
+bool AttachToCPUThread()
+{
+  return false;
+}
+
+void DetachFromCPUThread()
+{
+}
+
+void SampleCPUThread()
+{
+}
+
+#endif
+
+void TimerThread()
+{
+  Common::SetCurrentThreadName("Sampling Profiler");
+
+  while (!s_stop_event.WaitFor(s_interval))
+    SampleCPUThread();
+}
+
+void AddSample(PPCSymbolDB& symbol_db, u32 address, const std::string& leaf, bool in_jit)
+{
+  const Common::Symbol* symbol = symbol_db.GetSymbolFromAddr(address);
+  std::string function = symbol ? symbol->name : fmt::format("{:08x}", address);
+  // Semicolons separate the frames in the folded format
+  std::ranges::replace(function, ';', ':');
+
+  ++s_stacks[fmt::format("{};{}", function, leaf)];
+  SampleCounts& samples = s_functions[std::move(function)];
+  ++(in_jit ? samples.jit : samples.host);
+  ++s_total_samples;
+}
+
+void DrainSamples(const Core::CPUThreadGuard& guard, Core::System& system)
+{
+  s_fields_since_drain = 0;
+
+  const u32 tail = s_ring_tail.load(std::memory_order_relaxed);
+  const u32 head = s_ring_head.load(std::memory_order_acquire);
+  if (head == tail)
+    return;
+
+  s_pending.clear();
+  for (u32 i = tail; i != head; ++i)
+    s_pending.push_back(s_ring[i % RING_SIZE]);
+  s_ring_tail.store(head, std::memory_order_release);
+
+  std::ranges::sort(s_pending, {}, &Sample::host_pc);
+  s_pending_host_pcs.clear();
+  for (const Sample& sample : s_pending)
+    s_pending_host_pcs.push_back(sample.host_pc);
+  s_pending_blocks.resize(s_pending.size());
+  system.GetJitInterface().GetBlocksFromHostCode(guard, s_pending_host_pcs, s_pending_blocks);
+
+  PPCSymbolDB& symbol_db = system.GetPPCSymbolDB();
+  for (size_t i = 0; i < s_pending.size(); ++i)
+  {
+    if (const std::optional<u32> block = s_pending_blocks[i])
+      AddSample(symbol_db, *block, fmt::format("block {:08x}", *block), true);
+    else
+      AddSample(symbol_db, s_pending[i].guest_pc, "[host]", false);
+  }
+}
+
+// Stops the timer thread. Returns false if sampling never started.
+bool StopSampling()
+{
+  // Once this returns, the CPU thread won't run OnEndField anymore, which starts the timer thread
+  s_end_field_hook.reset();
+
+  if (!s_timer_thread.joinable())
+    return false;
+
+  s_stop_event.Set();
+  s_timer_thread.join();
+  s_active.store(false, std::memory_order_relaxed);
+  DetachFromCPUThread();
+  return true;
+}
+
+void OnStateChanged(Core::State state)
+{
+  if (state != Core::State::Stopping && state != Core::State::Uninitialized)
+    return;
+
+  // Sampling has to end while the CPU thread is still around to be signalled, and the samples
+  // have to be attributed before the JIT shuts down with its blocks
+  if (!StopSampling())
+    return;
+
+  if (state == Core::State::Uninitialized)
+  {
+    // The JIT is gone already, this is only reached if the emulation ended without stopping
+    const u32 head = s_ring_head.load(std::memory_order_acquire);
+    s_dropped.fetch_add(head - s_ring_tail.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    s_ring_tail.store(head, std::memory_order_release);
+    return;
+  }
+
+  if (Core::IsCPUThread())
+  {
+    const Core::CPUThreadGuard guard(*s_system);
+    DrainSamples(guard, *s_system);
+    return;
+  }
+
+  // The core doesn't pause the CPU thread for a CPUThreadGuard once it is stopping, so this does
+  // it by hand. The CPU thread only stops running after the Stopping callbacks.
+  CPU::CPUManager& cpu = s_system->GetCPU();
+  const bool was_unpaused = cpu.PauseAndLock(true, false);
+  {
+    const Core::CPUThreadGuard guard(*s_system);
+    DrainSamples(guard, *s_system);
+  }
+  cpu.PauseAndLock(false, was_unpaused);
+}
+
+void OnEndField()
+{
+  if (s_attach_failed)
+    return;
+
+  if (!s_timer_thread.joinable())
+  {
+    if (!AttachToCPUThread())
+    {
+      ERROR_LOG_FMT(POWERPC, "The sampling profiler is not supported on this host");
+      s_attach_failed = true;
+      return;
+    }
+
+    s_ppc_state = &s_system->GetPPCState();
+    s_active.store(true, std::memory_order_relaxed);
+    s_stop_event.Reset();
+    s_timer_thread = std::thread(TimerThread);
+    return;
+  }
+
+  const u32 pending =
+      s_ring_head.load(std::memory_order_acquire) - s_ring_tail.load(std::memory_order_relaxed);
+  if (++s_fields_since_drain < DRAIN_FIELDS && pending < DRAIN_THRESHOLD)
+    return;
+
+  const Core::CPUThreadGuard guard(*s_system);
+  DrainSamples(guard, *s_system);
+}
+}  // namespace
+
+bool IsSupported()
+{
+#if defined(_M_GENERIC) || defined(__APPLE__)
+  return false;
+#elif defined(_WIN32) || defined(_POSIX_VERSION)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Start(Core::System& system, std::chrono::microseconds interval)
+{
+  s_system = &system;
+  s_interval = interval;
+  s_attach_failed = false;
+  s_fields_since_drain = 0;
+  s_dropped.store(0, std::memory_order_relaxed);
+  s_stacks.clear();
+  s_functions.clear();
+  s_total_samples = 0;
+
+  s_end_field_hook = VIEndFieldEvent::Register([] { OnEndField(); }, "SamplingProfiler");
+  s_state_changed_callback = Core::AddOnStateChangedCallback(OnStateChanged);
+}
+
+void Stop(Core::System& system)
+{
+  Core::RemoveOnStateChangedCallback(&s_state_changed_callback);
+
+  // Normally the emulation has stopped already, and sampling with it
+  if (!StopSampling())
+    return;
+
+  const Core::CPUThreadGuard guard(system);
+  DrainSamples(guard, system);
+}
+
+bool WriteFoldedStacks(const std::string& path)
+{
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(POWERPC, "Could not open {} for writing", path);
+    return false;
+  }
+
+  for (const auto& [stack, count] : s_stacks)
+    file.WriteString(fmt::format("{} {}\n", stack, count));
+  return file.IsGood();
+}
+
+Summary GetTopFunctions(std::size_t count)
+{
+  Summary summary;
+  summary.total_samples = s_total_samples;
+  summary.dropped_samples = s_dropped.load(std::memory_order_relaxed);
+
+  for (const auto& [name, samples] : s_functions)
+    summary.functions.push_back({name, samples.jit, samples.host});
+
+  std::ranges::stable_sort(summary.functions, [](const auto& a, const auto& b) {
+    return a.jit + a.host > b.jit + b.host;
+  });
+  if (summary.functions.size() > count)
+    summary.functions.resize(count);
+
+  return summary;
+}
+}  // namespace SamplingProfiler
@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+// Periodically samples where the CPU thread is executing on the host and attributes each sample
+// to the guest function it was running, through the JIT block containing the host PC. Samples
+// outside of any block (the dispatcher, interpreters, hardware emulation and so on) are
+// attributed to the guest function at the current PC instead.
+//
+// Sampling starts at the first field after Start, so that it runs on the CPU thread.
+namespace SamplingProfiler
+{
+struct FunctionSamples
+{
+  std::string name;
+  // Samples in the function's JIT code, and in host code while the guest was in the function
+  u64 jit = 0;
+  u64 host = 0;
+};
+
+struct Summary
+{
+  u64 total_samples = 0;
+  // Samples lost because the ring buffer was full
+  u64 dropped_samples = 0;
+  // Most samples first
+  std::vector<FunctionSamples> functions;
+};
+
+// Whether the CPU thread can be sampled on this host
+bool IsSupported();
+
+void Start(Core::System& system, std::chrono::microseconds interval);
+// Sampling also stops when the emulation is stopped, before the JIT blocks go away. Either way
+// the samples which are still pending are attributed then.
+void Stop(Core::System& system);
+
+// Writes the samples as folded stacks, one "frame;frame count" line per stack, which
+// flamegraph.pl and speedscope read directly.
+bool WriteFoldedStacks(const std::string& path);
+// Returns the count guest functions with the most samples
+Summary GetTopFunctions(std::size_t count);
+}  // namespace SamplingProfiler
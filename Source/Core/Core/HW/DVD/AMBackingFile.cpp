@@ -0,0 +1,299 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMBackingFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "Common/ChunkFile.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace AMMediaboard
+{
+// How long the guest has to stop writing before pending changes are written back
+constexpr auto WRITE_BACK_DELAY = std::chrono::milliseconds(500);
+
+BackingFile::~BackingFile()
+{
+  Close();
+}
+
+bool BackingFile::Open(const std::string& filename, WriteBack write_back, Sharing sharing)
+{
+  Close();
+
+  if (sharing == Sharing::Exclusive && !Lock(filename))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: {} is in use by another instance", filename);
+    return false;
+  }
+
+  std::vector<u8> data;
+  if (write_back == WriteBack::InPlace)
+  {
+    const bool exists = File::Exists(filename);
+    if (!m_file.Open(filename, exists ? "rb+" : "wb+"))
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to open/create {}", filename);
+      Unlock();
+      return false;
+    }
+
+    data.resize(m_file.GetSize());
+    if (!data.empty() && !m_file.ReadBytes(data.data(), data.size()))
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to read {}", filename);
+  }
+  else if (File::Exists(filename))
+  {
+    File::IOFile file(filename, "rb");
+    data.resize(file.GetSize());
+    if (!file.IsOpen() || (!data.empty() && !file.ReadBytes(data.data(), data.size())))
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to read {}", filename);
+      Unlock();
+      return false;
+    }
+  }
+
+  m_filename = filename;
+  m_write_back = write_back;
+  {
+    std::lock_guard lk(m_data_lock);
+    m_data = std::move(data);
+    m_dirty.clear();
+    m_resized = false;
+  }
+
+  m_writer_stop.Clear();
+  m_writer_thread = std::thread(&BackingFile::WriterThread, this);
+  return true;
+}
+
+void BackingFile::Close()
+{
+  if (m_writer_thread.joinable())
+  {
+    m_writer_stop.Set();
+    m_write_event.Set();
+    m_writer_thread.join();
+  }
+
+  if (!IsOpen())
+    return;
+
+  Flush();
+  m_file.Close();
+  Unlock();
+  m_filename.clear();
+
+  std::lock_guard lk(m_data_lock);
+  m_data.clear();
+  m_data.shrink_to_fit();
+}
+
+u64 BackingFile::GetSize() const
+{
+  std::lock_guard lk(m_data_lock);
+  return m_data.size();
+}
+
+void BackingFile::Read(u64 offset, u8* data, u64 length) const
+{
+  std::lock_guard lk(m_data_lock);
+
+  const u64 available = offset < m_data.size() ? std::min<u64>(length, m_data.size() - offset) : 0;
+  if (available != 0)
+    std::memcpy(data, m_data.data() + offset, available);
+  if (available != length)
+    std::memset(data + available, 0, length - available);
+}
+
+void BackingFile::Write(u64 offset, const u8* data, u64 length)
+{
+  if (length == 0)
+    return;
+
+  {
+    std::lock_guard lk(m_data_lock);
+    if (offset + length > m_data.size())
+      m_data.resize(offset + length);
+    std::memcpy(m_data.data() + offset, data, length);
+    m_dirty.insert(offset, offset + length);
+  }
+
+  m_write_event.Set();
+}
+
+void BackingFile::Assign(const u8* data, u64 length)
+{
+  {
+    std::lock_guard lk(m_data_lock);
+    if (length < m_data.size())
+      m_resized = true;
+    m_data.assign(data, data + length);
+    m_dirty.clear();
+    if (length != 0)
+      m_dirty.insert(0, length);
+  }
+
+  m_write_event.Set();
+}
+
+void BackingFile::Flush()
+{
+  std::lock_guard file_lk(m_file_lock);
+  if (!IsOpen())
+    return;
+
+  if (m_write_back == WriteBack::Atomic)
+  {
+    WriteAtomically();
+    return;
+  }
+
+  // Only copy out the dirty ranges while holding the data lock so the CPU thread never waits on
+  // the disk.
+  std::vector<std::pair<u64, std::vector<u8>>> pending;
+  std::optional<u64> new_size;
+  {
+    std::lock_guard lk(m_data_lock);
+    for (auto it = m_dirty.begin(); it != m_dirty.end(); ++it)
+    {
+      pending.emplace_back(it.from(), std::vector<u8>(m_data.begin() + it.from(),
+                                                       m_data.begin() + it.to()));
+    }
+    m_dirty.clear();
+
+    if (std::exchange(m_resized, false))
+      new_size = m_data.size();
+  }
+
+  if (new_size && !m_file.Resize(*new_size))
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to resize {}", m_filename);
+
+  if (pending.empty())
+    return;
+
+  for (const auto& [offset, data] : pending)
+  {
+    if (!m_file.Seek(offset, File::SeekOrigin::Begin) ||
+        !m_file.WriteBytes(data.data(), data.size()))
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to write back {}", m_filename);
+    }
+  }
+  m_file.Flush();
+}
+
+void BackingFile::WriteAtomically()
+{
+  std::vector<u8> data;
+  {
+    std::lock_guard lk(m_data_lock);
+    if (m_dirty.empty() && !m_resized)
+      return;
+
+    m_dirty.clear();
+    m_resized = false;
+    data = m_data;
+  }
+
+  const std::string temp = m_filename + ".tmp";
+  File::IOFile file(temp, "wb");
+  if (!file.WriteBytes(data.data(), data.size()) || !file.Close() ||
+      !File::RenameSync(temp, m_filename))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to write back {}", m_filename);
+  }
+}
+
+bool BackingFile::Lock(const std::string& filename)
+{
+  const std::string path = filename + ".lock";
+
+  // Both kinds of lock go away with the process, so a crashed instance doesn't keep it
+#ifdef _WIN32
+  const HANDLE handle =
+      CreateFileW(UTF8ToWString(path).c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                  OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+  if (handle == INVALID_HANDLE_VALUE)
+    return false;
+  m_lock_handle = handle;
+#else
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd == -1)
+    return false;
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+  {
+    close(fd);
+    return false;
+  }
+  m_lock_fd = fd;
+#endif
+  return true;
+}
+
+void BackingFile::Unlock()
+{
+#ifdef _WIN32
+  if (m_lock_handle)
+    CloseHandle(m_lock_handle);
+  m_lock_handle = nullptr;
+#else
+  if (m_lock_fd != -1)
+    close(m_lock_fd);
+  m_lock_fd = -1;
+#endif
+}
+
+void BackingFile::DoState(PointerWrap& p)
+{
+  {
+    std::lock_guard lk(m_data_lock);
+    const u64 old_size = m_data.size();
+    p.Do(m_data);
+    if (!p.IsReadMode())
+      return;
+
+    if (m_data.size() < old_size)
+      m_resized = true;
+    if (!m_data.empty())
+      m_dirty.insert(0, m_data.size());
+  }
+
+  m_write_event.Set();
+}
+
+void BackingFile::WriterThread()
+{
+  Common::SetCurrentThreadName("AM Backing File Writer");
+
+  while (!m_writer_stop.IsSet())
+  {
+    m_write_event.Wait();
+
+    // Wait for the guest to go idle, so bursts of small writes turn into a single write back
+    while (!m_writer_stop.IsSet() && m_write_event.WaitFor(WRITE_BACK_DELAY))
+    {
+    }
+
+    Flush();
+  }
+}
+}  // namespace AMMediaboard
@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rangeset/rangeset.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
+
+class PointerWrap;
+
+namespace AMMediaboard
+{
+// In-memory copy of a file the Triforce boards use as persistent storage (DIMM, backup, network
+// settings and IC cards). Guest accesses only touch memory. Written ranges are tracked and written
+// back by a background thread once the guest has stopped writing for a while, or on Flush().
+class BackingFile
+{
+public:
+  enum class WriteBack
+  {
+    // Only the written ranges are written, to a file kept open for the whole session
+    InPlace,
+    // The whole file is written to a temporary file which then replaces the original, so it is
+    // never left half written. The file is only created by the first write back.
+    Atomic,
+  };
+
+  enum class Sharing
+  {
+    Shared,
+    // The file is locked for the session, so other instances fail to open it at the same time
+    Exclusive,
+  };
+
+  BackingFile() = default;
+  ~BackingFile();
+
+  BackingFile(const BackingFile&) = delete;
+  BackingFile& operator=(const BackingFile&) = delete;
+
+  // Loads the file, creating it if it doesn't exist yet and write_back is InPlace
+  bool Open(const std::string& filename, WriteBack write_back = WriteBack::InPlace,
+            Sharing sharing = Sharing::Shared);
+  void Close();
+  bool IsOpen() const { return !m_filename.empty(); }
+
+  u64 GetSize() const;
+
+  // Bytes past the end of the file read as zero
+  void Read(u64 offset, u8* data, u64 length) const;
+  void Write(u64 offset, const u8* data, u64 length);
+  // Replaces the whole contents, shrinking the file if needed
+  void Assign(const u8* data, u64 length);
+
+  // Writes all pending changes back to disk
+  void Flush();
+
+  // Loading a state replaces the contents, which are then written back like any guest write
+  void DoState(PointerWrap& p);
+
+private:
+  void WriterThread();
+  void WriteAtomically();
+
+  // Atomic write backs replace the file, so the lock is taken on a separate file next to it
+  bool Lock(const std::string& filename);
+  void Unlock();
+
+  std::string m_filename;
+  WriteBack m_write_back = WriteBack::InPlace;
+
+  // Guards m_data and m_dirty
+  mutable std::mutex m_data_lock;
+  std::vector<u8> m_data;
+  HyoutaUtilities::RangeSet<u64> m_dirty;
+  // Set when the contents shrank, so an in place write back has to truncate the file
+  bool m_resized = false;
+
+  // Guards m_file and keeps write backs in order. Only open for in place write backs.
+  std::mutex m_file_lock;
+  File::IOFile m_file;
+
+  // Only held for Sharing::Exclusive
+#ifdef _WIN32
+  void* m_lock_handle = nullptr;
+#else
+  int m_lock_fd = -1;
+#endif
+
+  std::thread m_writer_thread;
+  Common::Event m_write_event;
+  Common::Flag m_writer_stop;
+};
+}  // namespace AMMediaboard
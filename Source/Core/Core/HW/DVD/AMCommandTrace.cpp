@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMCommandTrace.h"
+
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+
+namespace AMMediaboard
+{
+u64 HashTracePayload(const u8* data, u32 length)
+{
+  if (!data || length == 0)
+    return 0;
+  return Common::GetHash64(data, length, 0);
+}
+
+bool CommandTraceWriter::Open(const std::string& filename, u32 game_type)
+{
+  if (!m_file.Open(filename, "wb"))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to create command trace {}", filename);
+    return false;
+  }
+
+  const TraceHeader header{TRACE_MAGIC, TRACE_VERSION, game_type, 0};
+  m_file.WriteArray(&header, 1);
+
+  NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: Recording media board commands to {}", filename);
+  return true;
+}
+
+void CommandTraceWriter::Close()
+{
+  m_file.Close();
+}
+
+void CommandTraceWriter::Write(const TraceRecord& record, std::span<const u8> payload)
+{
+  TraceRecord out = record;
+  out.payload_size = static_cast<u32>(payload.size());
+
+  bool written = m_file.WriteArray(&out, 1);
+  if (written && !payload.empty())
+    written = m_file.WriteBytes(payload.data(), payload.size());
+
+  if (!written)
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to write the command trace, stopping");
+    m_file.Close();
+  }
+}
+
+bool CommandTraceReader::Open(const std::string& filename)
+{
+  if (!m_file.Open(filename, "rb") || !m_file.ReadArray(&m_header, 1))
+    return false;
+
+  return m_header.magic == TRACE_MAGIC && m_header.version == TRACE_VERSION;
+}
+
+bool CommandTraceReader::Read(TraceRecord* record, std::vector<u8>* payload)
+{
+  if (!m_file.ReadArray(record, 1))
+    return false;
+
+  payload->resize(record->payload_size);
+  return payload->empty() || m_file.ReadBytes(payload->data(), payload->size());
+}
+}  // namespace AMMediaboard
@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace AMMediaboard
+{
+// A trace of the decrypted commands the guest sent to the media board, along with everything
+// else that changed the media board's state, so it can be replayed without running the game.
+constexpr u32 TRACE_MAGIC = 0x52544D41;  // "AMTR"
+constexpr u32 TRACE_VERSION = 1;
+
+struct TraceHeader
+{
+  u32 magic;
+  u32 version;
+  u32 game_type;
+  u32 reserved;
+};
+static_assert(sizeof(TraceHeader) == 16);
+
+enum class TraceRecordKind : u8
+{
+  // An ExecuteCommand call. Writes carry the DMA payload, reads the hash of the data returned.
+  Command,
+  // A socket command completed by the network thread. The payload is the serialized reply.
+  NetworkReply,
+  // FirmwareMap was called, flags holds the new state
+  FirmwareMap,
+};
+
+enum TraceFlags : u8
+{
+  // The command made the guest enter test mode, which maps the firmware
+  TRACE_TEST_MODE = 0x01,
+  TRACE_FIRMWARE_MAPPED = 0x02,
+};
+
+struct TraceRecord
+{
+  u64 hash;
+  u32 command;
+  u32 offset;
+  u32 address;
+  u32 length;
+  u32 result;
+  u32 payload_size;
+  TraceRecordKind kind;
+  u8 flags;
+  u8 reserved[6];
+};
+static_assert(sizeof(TraceRecord) == 40);
+
+u64 HashTracePayload(const u8* data, u32 length);
+
+class CommandTraceWriter
+{
+public:
+  bool Open(const std::string& filename, u32 game_type);
+  void Close();
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  void Write(const TraceRecord& record, std::span<const u8> payload = {});
+
+private:
+  File::IOFile m_file;
+};
+
+class CommandTraceReader
+{
+public:
+  bool Open(const std::string& filename);
+  u32 GetGameType() const { return m_header.game_type; }
+
+  // Returns false at the end of the trace or if it is truncated
+  bool Read(TraceRecord* record, std::vector<u8>* payload);
+
+private:
+  File::IOFile m_file;
+  TraceHeader m_header{};
+};
+}  // namespace AMMediaboard
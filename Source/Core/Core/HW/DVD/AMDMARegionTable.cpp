@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMDMARegionTable.h"
+
+#include <algorithm>
+
+#include "Common/Logging/Log.h"
+
+namespace AMMediaboard
+{
+void DMARegionTable::Register(const char* name, u32 start, u32 end, u32 length,
+                              DMAHandler handler)
+{
+  m_regions.push_back({name, start, end, length, handler});
+  BuildSegments();
+}
+
+void DMARegionTable::Clear()
+{
+  m_regions.clear();
+  m_segments.clear();
+  m_candidates.clear();
+  m_last_segment = 0;
+}
+
+void DMARegionTable::BuildSegments()
+{
+  // Every region boundary starts a new segment. Ends are stored exclusive, in 64 bits so that
+  // regions reaching the top of the address space don't wrap.
+  std::vector<u64> bounds;
+  for (const DMARegion& region : m_regions)
+  {
+    bounds.push_back(region.start);
+    bounds.push_back(u64{region.end} + 1);
+  }
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+  m_segments.clear();
+  m_candidates.clear();
+  m_last_segment = 0;
+
+  for (size_t i = 0; i + 1 < bounds.size(); ++i)
+  {
+    const u32 start = static_cast<u32>(bounds[i]);
+    const u32 end = static_cast<u32>(bounds[i + 1] - 1);
+    const u32 first_candidate = static_cast<u32>(m_candidates.size());
+
+    for (u32 j = 0; j < m_regions.size(); ++j)
+    {
+      if (m_regions[j].start <= start && m_regions[j].end >= end)
+        m_candidates.push_back(j);
+    }
+
+    const u32 candidate_count = static_cast<u32>(m_candidates.size()) - first_candidate;
+    if (candidate_count != 0)
+      m_segments.push_back({start, end, first_candidate, candidate_count});
+  }
+}
+
+const DMARegionTable::Segment* DMARegionTable::FindSegment(u32 offset)
+{
+  if (m_last_segment < m_segments.size())
+  {
+    const Segment& last = m_segments[m_last_segment];
+    if (offset >= last.start && offset <= last.end)
+      return &last;
+  }
+
+  auto it = std::upper_bound(m_segments.begin(), m_segments.end(), offset,
+                             [](u32 value, const Segment& segment) {
+                               return value < segment.start;
+                             });
+  if (it == m_segments.begin())
+    return nullptr;
+
+  --it;
+  if (offset > it->end)
+    return nullptr;
+
+  m_last_segment = it - m_segments.begin();
+  return &*it;
+}
+
+bool DMARegionTable::Dispatch(const DMATransfer& transfer)
+{
+  const Segment* segment = FindSegment(transfer.offset);
+  if (!segment)
+    return false;
+
+  for (u32 i = 0; i < segment->candidate_count; ++i)
+  {
+    DMARegion& region = m_regions[m_candidates[segment->first_candidate + i]];
+    if (region.length != 0 && region.length != transfer.length)
+      continue;
+
+    if (!region.handler(transfer, transfer.offset - region.start, region))
+      continue;
+
+    ++region.hits;
+    region.bytes += transfer.length;
+    return true;
+  }
+
+  return false;
+}
+
+void DMARegionTable::ResetCounters()
+{
+  for (DMARegion& region : m_regions)
+  {
+    region.hits = 0;
+    region.bytes = 0;
+  }
+}
+
+void DMARegionTable::LogCounters(std::string_view kind) const
+{
+  for (const DMARegion& region : m_regions)
+  {
+    if (region.hits == 0)
+      continue;
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: {} {} ({:08x}-{:08x}): {} transfers, {} bytes", kind,
+                   region.name, region.start, region.end, region.hits, region.bytes);
+  }
+}
+}  // namespace AMMediaboard
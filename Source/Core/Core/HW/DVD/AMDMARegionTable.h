@@ -0,0 +1,84 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace AMMediaboard
+{
+struct DMARegion;
+
+// A media board read or write issued through the DI DMA registers
+struct DMATransfer
+{
+  Core::System& system;
+  // Offset the guest asked for, regions get the offset relative to their start separately
+  u32 offset;
+  u32 address;
+  u32 length;
+  // Guest memory at address
+  u8* data;
+};
+
+// Returns false to pass the transfer on to the next region covering the offset
+using DMAHandler = bool (*)(const DMATransfer& transfer, u32 region_offset,
+                            const DMARegion& region);
+
+struct DMARegion
+{
+  const char* name;
+  u32 start;
+  // Inclusive
+  u32 end;
+  // Transfer length the region responds to, 0 for any length
+  u32 length;
+  DMAHandler handler;
+
+  u64 hits = 0;
+  u64 bytes = 0;
+};
+
+// Maps media board offsets to handlers. Regions may overlap, in which case the one registered
+// first is tried first. The regions are flattened into sorted, disjoint segments so that a lookup
+// is a binary search, and repeated transfers to the same segment skip the search entirely.
+class DMARegionTable
+{
+public:
+  void Register(const char* name, u32 start, u32 end, u32 length, DMAHandler handler);
+  void Clear();
+
+  // Returns false if no region handled the transfer
+  bool Dispatch(const DMATransfer& transfer);
+
+  void ResetCounters();
+  // Logs the hit and byte counts of every region that was used
+  void LogCounters(std::string_view kind) const;
+
+private:
+  struct Segment
+  {
+    u32 start;
+    u32 end;
+    // Range in m_candidates, in priority order
+    u32 first_candidate;
+    u32 candidate_count;
+  };
+
+  void BuildSegments();
+  const Segment* FindSegment(u32 offset);
+
+  std::vector<DMARegion> m_regions;
+  std::vector<Segment> m_segments;
+  std::vector<u32> m_candidates;
+  size_t m_last_segment = 0;
+};
+}  // namespace AMMediaboard
@@ -6,20 +6,29 @@
 #include "Core/HW/EXI/EXI_DeviceAMBaseboard.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
 
-#include "Common/CommonTypes.h"
+#include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/Flag.h"
 #include "Common/IOFile.h"
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
 #include "Core/Config/MainSettings.h"
@@ -28,8 +37,14 @@
 #include "Core/ConfigLoaders/NetPlayConfigLoader.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
+#include "Core/HW/DVD/AMBackingFile.h"
+#include "Core/HW/DVD/AMCommandTrace.h"
+#include "Core/HW/DVD/AMDMARegionTable.h"
 #include "Core/HW/DVD/AMMediaboard.h"
+#include "Core/HW/DVD/AMNetwork.h"
+#include "Core/HW/DVD/AMTimings.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/DVDThread.h"
 #include "Core/HW/EXI/EXI.h"
@@ -38,6 +53,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/HW/Sram.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 #include "Core/IOS/Network/Socket.h"
 #include "Core/Movie.h"
@@ -48,109 +64,324 @@
 #include "Core/WiiRoot.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/Enums.h"
+#include "DiscIO/Volume.h"
 #include "DiscIO/VolumeDisc.h"
 
-#if defined(__linux__) or defined(__APPLE__) or defined(__FreeBSD__) or defined(__NetBSD__) or     \
-    defined(__HAIKU__)
-
-#include <unistd.h>
-
-#define closesocket close
-#define ioctlsocket ioctl
-
-#define WSAEWOULDBLOCK 10035L
-#define SOCKET_ERROR (-1)
-
-typedef int SOCKET;
-
-static int WSAGetLastError(void)
-{
-  switch (errno)
-  {
-  case EWOULDBLOCK:
-    return WSAEWOULDBLOCK;
-  default:
-    break;
-  }
-
-  return errno;
-}
-
-#endif
-
 namespace AMMediaboard
 {
 
 static u32 s_firmwaremap = 0;
 static u32 s_segaboot = 0;
-static u32 s_namco_cam = 0;
-static u32 s_timeouts[3] = {20000, 20000, 20000};
 static u32 s_last_error  = SSC_SUCCESS;
 
+// Faked game loading reported to SegaBoot, see GetMediaBoardStatus
+static u32 s_board_status = 4;
+static u32 s_load_progress = 80;
+
+static CoreTiming::EventType* s_network_reply_event = nullptr;
+// Set while s_network_reply_event is scheduled. A single event picks up the replies to all the
+// commands in flight, so it isn't scheduled again for commands submitted in the meantime.
+static bool s_network_reply_pending = false;
+
 static u32 s_GCAM_key_a = 0;
 static u32 s_GCAM_key_b = 0;
 static u32 s_GCAM_key_c = 0;
 
-static File::IOFile* s_netcfg = nullptr;
-static File::IOFile* s_netctrl = nullptr;
-static File::IOFile* s_extra = nullptr;
-static File::IOFile* s_backup = nullptr;
-static File::IOFile* s_dimm = nullptr;
+static BackingFile s_netcfg;
+static BackingFile s_netctrl;
+static BackingFile s_extra;
+static BackingFile s_backup;
+static BackingFile s_dimm;
+
+// The game image is copied into the 512MB DIMM on a real Triforce. We back it with a lazily
+// committed allocation that is filled one chunk at a time, either on first access or by the
+// prefetch thread, so booting doesn't wait for the whole image and unused space stays unmapped.
+constexpr u32 DIMM_DISC_SIZE = 0x20000000;
+constexpr u32 DIMM_CHUNK_SIZE = 0x100000;
+constexpr u32 DIMM_CHUNK_COUNT = DIMM_DISC_SIZE / DIMM_CHUNK_SIZE;
 
 static u8* s_dimm_disc = nullptr;
+static u32 s_dimm_disc_data_size = 0;
+static std::unique_ptr<DiscIO::Volume> s_dimm_disc_volume;
+static std::mutex s_dimm_disc_mutex;
+static std::array<std::atomic<bool>, DIMM_CHUNK_COUNT> s_dimm_disc_loaded;
+static std::thread s_dimm_prefetch_thread;
+static Common::Flag s_dimm_prefetch_stop;
 
 static u8 s_firmware[2 * 1024 * 1024];
 static u8 s_media_buffer[0x300];
 static u8 s_network_command_buffer[0x4FFE00];
 static u8 s_network_buffer[128 * 1024];
 
-// Sockets FDs are required to go from 0 to 63
-// Games use the FD as indexes so we have to workaround it.
+// Set while a command trace is replayed, see InitReplay. There is no emulated console and no
+// network then, so the commands only touch the media board's own state.
+static bool s_replaying = false;
+static u32 s_replay_game_type = 0;
+
+static CommandTraceWriter s_trace;
 
-static SOCKET s_sockets[64];
+// Handlers for the 0xA8 read and 0xAA write offsets, see RegisterDMARegions
+static DMARegionTable s_read_regions;
+static DMARegionTable s_write_regions;
+static void RegisterDMARegions();
+static u32 ExecuteDecryptedCommand(Core::System& system, u32 command, u32 offset, u32 address,
+                                   u32 length, u8* data);
 
-static SOCKET socket_(int af, int type, int protocol)
+static inline void PrintMBBuffer(const u8* data, u32 length)
 {
-  for (u32 i = 1; i < 64; ++i)
+  if (!data)
+    return;
+
+  for (u32 i = 0; i + 0x10 <= length; i += 0x10)
   {
-    if (s_sockets[i] == SOCKET_ERROR)
-    {
-      s_sockets[i] = socket(af, type, protocol);
-      return i;
-    }
+    INFO_LOG_FMT(DVDINTERFACE, "GC-AM: {:08x} {:08x} {:08x} {:08x}", Common::swap32(data + i),
+                 Common::swap32(data + i + 4), Common::swap32(data + i + 8),
+                 Common::swap32(data + i + 12));
+  }
+}
+
+static bool IsSocketCommand(AMMBCommand command)
+{
+  switch (command)
+  {
+  case AMMBCommand::Accept:
+  case AMMBCommand::Bind:
+  case AMMBCommand::Closesocket:
+  case AMMBCommand::Connect:
+  case AMMBCommand::Listen:
+  case AMMBCommand::Recv:
+  case AMMBCommand::Send:
+  case AMMBCommand::Socket:
+  case AMMBCommand::Select:
+  case AMMBCommand::SetSockOpt:
+  case AMMBCommand::SetTimeOuts:
+    return true;
+  default:
+    return false;
   }
+}
 
-  // Out of sockets
-  return SOCKET_ERROR;
+// Returns the part of the network command buffer mapped at the given address, if it is in range
+static u8* GetNetworkCommandBuffer(u32 address, u32 length)
+{
+  const u32 offset = address - NetworkCommandAddress2;
+  if (offset >= sizeof(s_network_command_buffer) ||
+      length > sizeof(s_network_command_buffer) - offset)
+  {
+    return nullptr;
+  }
+  return s_network_command_buffer + offset;
 }
 
-static SOCKET accept_(int fd, struct sockaddr* addr, int* len)
+static void CompleteNetworkCommand(const NetworkReply& reply)
 {
-  for (u32 i = 1; i < 64; ++i)
+  // Recast for easier access
+  u32* media_buffer_32 = (u32*)(s_media_buffer);
+  const std::array<u32, 5>& params = reply.params;
+
+  switch (reply.command)
+  {
+  case AMMBCommand::Accept:
+    // The peer address is followed by its length
+    if (reply.data.size() >= sizeof(int))
+    {
+      const u32 addr_len = static_cast<u32>(reply.data.size() - sizeof(int));
+      if (u8* addr = GetNetworkCommandBuffer(params[1], addr_len))
+        memcpy(addr, reply.data.data(), addr_len);
+      if (u8* len = GetNetworkCommandBuffer(params[2], sizeof(int)))
+        memcpy(len, reply.data.data() + addr_len, sizeof(int));
+    }
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: accept( {}({}) ):{}\n", reply.host_fd, params[0],
+                   reply.result);
+    break;
+  case AMMBCommand::Recv:
+    memcpy(s_network_buffer + params[1] - NetworkBufferAddress4, reply.data.data(),
+           reply.data.size());
+    break;
+  case AMMBCommand::Select:
   {
-    if (s_sockets[i] == SOCKET_ERROR)
+    // Either of these can be zero
+    if (auto* readfds = (fd_set*)GetNetworkCommandBuffer(params[1], sizeof(fd_set));
+        params[1] && readfds)
     {
-      s_sockets[i] = accept(fd, addr, (socklen_t*)len);
-      if (s_sockets[i] == SOCKET_ERROR)
-        return SOCKET_ERROR;
-      return i;
+      FD_ZERO(readfds);
+      if (reply.readable)
+        FD_SET(reply.host_fd, readfds);
     }
+
+    if (auto* writefds = (fd_set*)GetNetworkCommandBuffer(params[2], sizeof(fd_set));
+        params[2] && writefds)
+    {
+      FD_ZERO(writefds);
+      if (reply.writable)
+        FD_SET(reply.host_fd, writefds);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  switch (reply.command)
+  {
+  case AMMBCommand::Connect:
+  case AMMBCommand::Listen:
+  case AMMBCommand::Recv:
+  case AMMBCommand::Send:
+  case AMMBCommand::SetSockOpt:
+  case AMMBCommand::SetTimeOuts:
+    s_media_buffer[1] = s_media_buffer[8];
+    break;
+  case AMMBCommand::Socket:
+  case AMMBCommand::Select:
+    s_media_buffer[1] = 0;
+    break;
+  default:
+    break;
   }
 
-  // Out of sockets
-  return SOCKET_ERROR;
+  media_buffer_32[1] = reply.result;
+  if (reply.last_error)
+    s_last_error = *reply.last_error;
+
+  s_media_buffer[3] |= 0x80;  // Command complete flag
+
+  if (!s_replaying)
+    ExpansionInterface::GenerateInterrupt(0x10);
 }
 
-static inline void PrintMBBuffer(u32 address, u32 length)
+static void TraceNetworkReply(NetworkReply reply)
 {
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
+  u8* ptr = nullptr;
+  PointerWrap measure(&ptr, 0, PointerWrap::Mode::Measure);
+  reply.DoState(measure);
+
+  std::vector<u8> payload(reinterpret_cast<size_t>(ptr));
+  ptr = payload.data();
+  PointerWrap writer(&ptr, payload.size(), PointerWrap::Mode::Write);
+  reply.DoState(writer);
+
+  TraceRecord record{};
+  record.kind = TraceRecordKind::NetworkReply;
+  record.command = static_cast<u32>(reply.command);
+  record.result = static_cast<u32>(reply.result);
+  s_trace.Write(record, payload);
+}
+
+static s64 GetNetworkReplyPollTicks(Core::System& system)
+{
+  return system.GetSystemTimers().GetTicksPerSecond() / 10000;
+}
+
+static void NetworkReplyCallback(Core::System& system, u64 userdata, s64 cycles_late)
+{
+  s_network_reply_pending = false;
 
-  for (u32 i = 0; i < length; i += 0x10)
+  while (const auto reply = PopNetworkReply())
   {
-    INFO_LOG_FMT(DVDINTERFACE, "GC-AM: {:08x} {:08x} {:08x} {:08x}", memory.Read_U32(address + i),
-                 memory.Read_U32(address + i + 4), memory.Read_U32(address + i + 8),
-                 memory.Read_U32(address + i + 12));
+    if (s_trace.IsOpen())
+      TraceNetworkReply(*reply);
+    CompleteNetworkCommand(*reply);
+  }
+
+  if (IsNetworkBusy())
+  {
+    system.GetCoreTiming().ScheduleEvent(GetNetworkReplyPollTicks(system) - cycles_late,
+                                         s_network_reply_event);
+    s_network_reply_pending = true;
+  }
+}
+
+// Hands a socket command over to the network thread. The command complete flag and the
+// interrupt are raised once its reply has been picked up.
+static void SubmitNetworkCommand(Core::System& system, AMMBCommand command)
+{
+  // Recast for easier access
+  u32* media_buffer_32 = (u32*)(s_media_buffer);
+
+  NetworkRequest request;
+  request.command = command;
+  std::copy_n(media_buffer_32 + 2, request.params.size(), request.params.begin());
+  std::array<u32, 5>& params = request.params;
+
+  // Copy whatever the command reads from the guest's buffers
+  switch (command)
+  {
+  case AMMBCommand::Accept:
+  {
+    // Handle optional parameters
+    const u8* len = params[1] ? GetNetworkCommandBuffer(params[2], sizeof(int)) : nullptr;
+    if (len)
+      request.data.assign(len, len + sizeof(int));
+    else
+      params[1] = params[2] = 0;
+    break;
+  }
+  case AMMBCommand::Bind:
+  case AMMBCommand::Connect:
+    if (const u8* addr = GetNetworkCommandBuffer(params[1], sizeof(sockaddr_in)))
+      request.data.assign(addr, addr + sizeof(sockaddr_in));
+    break;
+  case AMMBCommand::Recv:
+  {
+    const u32 offset = params[1] - NetworkBufferAddress4;
+    if (params[1] < NetworkBufferAddress4 || offset >= sizeof(s_network_buffer))
+    {
+      PanicAlertFmt("RECV: Buffer overrun:{0} {1} ", params[1], params[2]);
+
+      NetworkReply reply;
+      reply.command = command;
+      reply.params = params;
+      reply.result = -1;
+      CompleteNetworkCommand(reply);
+      return;
+    }
+    params[2] = std::min<u32>(params[2], sizeof(s_network_buffer) - offset);
+    break;
+  }
+  case AMMBCommand::Send:
+  {
+    const u32 offset = params[1] - NetworkBufferAddress3;
+    if (params[1] < NetworkBufferAddress3 || offset >= sizeof(s_network_buffer))
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: send(error) unhandled destination:{:08x}\n", params[1]);
+
+      NetworkReply reply;
+      reply.command = command;
+      reply.params = params;
+      reply.result = -1;
+      CompleteNetworkCommand(reply);
+      return;
+    }
+    const u32 len = std::min<u32>(params[2], sizeof(s_network_buffer) - offset);
+    request.data.assign(s_network_buffer + offset, s_network_buffer + offset + len);
+    break;
+  }
+  case AMMBCommand::Select:
+    if (const u8* timeout = params[4] ? GetNetworkCommandBuffer(params[4], sizeof(timeval)) :
+                                        nullptr)
+    {
+      request.data.assign(timeout, timeout + sizeof(timeval));
+    }
+    break;
+  case AMMBCommand::SetSockOpt:
+    if (const u8* optval = GetNetworkCommandBuffer(params[3], params[4]))
+      request.data.assign(optval, optval + params[4]);
+    break;
+  default:
+    break;
+  }
+
+  // Replies to replayed commands come from the trace
+  if (s_replaying)
+    return;
+
+  SubmitNetworkRequest(std::move(request));
+  if (!s_network_reply_pending)
+  {
+    system.GetCoreTiming().ScheduleEvent(GetNetworkReplyPollTicks(system), s_network_reply_event);
+    s_network_reply_pending = true;
   }
 }
 
@@ -160,6 +391,14 @@ void FirmwareMap(bool on)
     s_firmwaremap = 1;
   else
     s_firmwaremap = 0;
+
+  if (s_trace.IsOpen())
+  {
+    TraceRecord record{};
+    record.kind = TraceRecordKind::FirmwareMap;
+    record.flags = on ? TRACE_FIRMWARE_MAPPED : 0;
+    s_trace.Write(record);
+  }
 }
 
 void InitKeys(u32 key_a, u32 key_b, u32 key_c)
@@ -169,79 +408,31 @@ void InitKeys(u32 key_a, u32 key_b, u32 key_c)
   s_GCAM_key_c = key_c;
 }
 
-void Init(void)
+static void ResetState()
 {
   memset(s_media_buffer, 0, sizeof(s_media_buffer));
   memset(s_network_buffer, 0, sizeof(s_network_buffer));
   memset(s_network_command_buffer, 0, sizeof(s_network_command_buffer));
   memset(s_firmware, -1, sizeof(s_firmware));
-  memset(s_sockets, SOCKET_ERROR, sizeof(s_sockets));
 
   s_segaboot = 0;
   s_firmwaremap = 0;
 
   s_last_error = SSC_SUCCESS;
+  s_network_reply_pending = false;
+
+  s_board_status = 4;
+  s_load_progress = 80;
 
   s_GCAM_key_a = 0;
   s_GCAM_key_b = 0;
   s_GCAM_key_c = 0;
 
-  std::string netcfg_Filename(File::GetUserPath(D_TRIUSER_IDX) + "trinetcfg.bin");
-  if (File::Exists(netcfg_Filename))
-  {
-    s_netcfg = new File::IOFile(netcfg_Filename, "rb+");
-  }
-  else
-  {
-    s_netcfg = new File::IOFile(netcfg_Filename, "wb+");
-  }
-  if (!s_netcfg)
-  {
-    PanicAlertFmt("Failed to open/create:{0}", netcfg_Filename);
-  }
-
-  std::string netctrl_Filename(File::GetUserPath(D_TRIUSER_IDX) + "trinetctrl.bin");
-  if (File::Exists(netctrl_Filename))
-  {
-    s_netctrl = new File::IOFile(netctrl_Filename, "rb+");
-  }
-  else
-  {
-    s_netctrl = new File::IOFile(netctrl_Filename, "wb+");
-  }
-
-  std::string extra_Filename(File::GetUserPath(D_TRIUSER_IDX) + "triextra.bin");
-  if (File::Exists(extra_Filename))
-  {
-    s_extra = new File::IOFile(extra_Filename, "rb+");
-  }
-  else
-  {
-    s_extra = new File::IOFile(extra_Filename, "wb+");
-  }
-
-  std::string dimm_Filename(File::GetUserPath(D_TRIUSER_IDX) + "tridimm_" +
-                            SConfig::GetInstance().GetGameID().c_str() + ".bin");
-  if (File::Exists(dimm_Filename))
-  {
-    s_dimm = new File::IOFile(dimm_Filename, "rb+");
-  }
-  else
-  {
-    s_dimm = new File::IOFile(dimm_Filename, "wb+");
-  }
+  RegisterDMARegions();
+}
 
-  std::string backup_Filename(File::GetUserPath(D_TRIUSER_IDX) + "backup_" +
-                              SConfig::GetInstance().GetGameID().c_str() + ".bin");
-  if (File::Exists(backup_Filename))
-  {
-    s_backup = new File::IOFile(backup_Filename, "rb+");
-  }
-  else
-  {
-    s_backup = new File::IOFile(backup_Filename, "wb+");
-  }
-  
+static void LoadFirmware()
+{
   // This is the firmware for the Triforce
   std::string sega_boot_Filename(File::GetSysDirectory() + TRI_SYS_DIR + DIR_SEP + "segaboot.gcm");
   if (File::Exists(sega_boot_Filename))
@@ -264,1120 +455,797 @@ void Init(void)
   }
 }
 
-u8* InitDIMM(void)
+void Init(void)
 {
-  if (!s_dimm_disc)
+  ResetState();
+
+  InitNetwork();
+  s_network_reply_event = Core::System::GetInstance().GetCoreTiming().RegisterEvent(
+      "AMMBNetworkReply", NetworkReplyCallback);
+
+  std::string netcfg_Filename(File::GetUserPath(D_TRIUSER_IDX) + "trinetcfg.bin");
+  if (!s_netcfg.Open(netcfg_Filename))
   {
-    s_dimm_disc = new u8[512 * 1024 * 1024];
+    PanicAlertFmt("Failed to open/create:{0}", netcfg_Filename);
   }
-  s_firmwaremap = 0;
-  return s_dimm_disc;
-}
 
-static s32 NetDIMMAccept(int fd, struct sockaddr* addr, int* len)
-{
-  int ret = 0;
-  int err = 0;
+  std::string netctrl_Filename(File::GetUserPath(D_TRIUSER_IDX) + "trinetctrl.bin");
+  s_netctrl.Open(netctrl_Filename);
+
+  std::string extra_Filename(File::GetUserPath(D_TRIUSER_IDX) + "triextra.bin");
+  s_extra.Open(extra_Filename);
+
+  std::string dimm_Filename(File::GetUserPath(D_TRIUSER_IDX) + "tridimm_" +
+                            SConfig::GetInstance().GetGameID().c_str() + ".bin");
+  s_dimm.Open(dimm_Filename);
+
+  std::string backup_Filename(File::GetUserPath(D_TRIUSER_IDX) + "backup_" +
+                              SConfig::GetInstance().GetGameID().c_str() + ".bin");
+  s_backup.Open(backup_Filename);
+
+  LoadFirmware();
 
-  u_long val = 1;
-  ioctlsocket(fd, FIONBIO, &val);
+  if (Config::Get(Config::MAIN_TRIFORCE_COMMAND_TRACE))
+  {
+    s_trace.Open(File::GetUserPath(D_TRIUSER_IDX) + "trace_" +
+                     SConfig::GetInstance().GetGameID() + ".amtrace",
+                 GetGameType());
+  }
+}
 
-  ret = accept_(fd, addr, len);
-  err = WSAGetLastError();
+static void LoadDIMMChunk(u32 chunk)
+{
+  if (s_dimm_disc_loaded[chunk].load(std::memory_order_acquire))
+    return;
 
-  val = 0;
-  ioctlsocket(fd, FIONBIO, &val);
+  std::lock_guard lk(s_dimm_disc_mutex);
+  if (s_dimm_disc_loaded[chunk].load(std::memory_order_relaxed))
+    return;
 
-  if (ret == SOCKET_ERROR)
+  const u32 chunk_offset = chunk * DIMM_CHUNK_SIZE;
+  if (chunk_offset < s_dimm_disc_data_size)
   {
-    if (err == WSAEWOULDBLOCK)
+    const u32 chunk_length = std::min(DIMM_CHUNK_SIZE, s_dimm_disc_data_size - chunk_offset);
+    if (!s_dimm_disc_volume->Read(chunk_offset, chunk_length, s_dimm_disc + chunk_offset,
+                                  DiscIO::PARTITION_NONE))
     {
-      s_last_error = SSC_EWOULDBLOCK;
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to load DIMM chunk {:08x}", chunk_offset);
+    }
+  }
 
-      fd_set readfds, errfds;
+  s_dimm_disc_loaded[chunk].store(true, std::memory_order_release);
+}
 
-      timeval timeout;
-      timeout.tv_sec = 0;
-      timeout.tv_usec = 200;
+// Makes sure the requested range of the DIMM image has been read from the disc
+static void EnsureDIMMLoaded(u32 offset, u32 length)
+{
+  if (length == 0 || offset >= DIMM_DISC_SIZE)
+    return;
 
-      FD_ZERO(&readfds);
-      FD_ZERO(&errfds);
+  const u32 end = std::min(offset + length, DIMM_DISC_SIZE) - 1;
+  for (u32 chunk = offset / DIMM_CHUNK_SIZE; chunk <= end / DIMM_CHUNK_SIZE; ++chunk)
+    LoadDIMMChunk(chunk);
+}
 
-      FD_SET(fd, &readfds);
-      FD_SET(fd, &errfds);
+static void DIMMPrefetchThread()
+{
+  Common::SetCurrentThreadName("AM DIMM Prefetch");
 
-      ret = select(fd, &readfds, nullptr, &errfds, &timeout);
-      if (ret < 0)
-      {
-        err = WSAGetLastError();
-      }
-      else
-      {
-        if (FD_ISSET(fd, &readfds))
-        {
-          s_last_error = SSC_SUCCESS;
-          ret = 0;
-        }
-        else
-        {
-          ret = SOCKET_ERROR;
-        }
-      }
-    }
-  }
-  else
+  for (u32 chunk = 0; chunk < DIMM_CHUNK_COUNT && !s_dimm_prefetch_stop.IsSet(); ++chunk)
+    LoadDIMMChunk(chunk);
+}
+
+static void ShutdownDIMM()
+{
+  if (s_dimm_prefetch_thread.joinable())
   {
-    s_last_error = SSC_SUCCESS;
+    s_dimm_prefetch_stop.Set();
+    s_dimm_prefetch_thread.join();
   }
 
-  return ret;
-}
+  s_dimm_disc_volume.reset();
+  s_dimm_disc_data_size = 0;
 
-static s32 NetDIMMConnect(int fd, struct sockaddr_in* addr, int len)
-{
-  // CyCraft Connect IP, change to localhost
-  if (addr->sin_addr.s_addr == inet_addr("192.168.11.111"))
+  if (s_dimm_disc)
   {
-    addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+    Common::FreeMemoryPages(s_dimm_disc, DIMM_DISC_SIZE);
+    s_dimm_disc = nullptr;
   }
+}
 
-  // NAMCO Camera ( IPs are: 192.168.29.104-108 )
-  if ((addr->sin_addr.s_addr & 0xFFFFFF00) == 0xC0A81D00)
+void InitDIMM(const DiscIO::VolumeDisc& volume)
+{
+  ShutdownDIMM();
+
+  s_dimm_disc = static_cast<u8*>(Common::AllocateMemoryPages(DIMM_DISC_SIZE));
+  s_firmwaremap = 0;
+  if (!s_dimm_disc)
+    return;
+
+  // The DVD thread owns the volume it was given, so read through our own copy of the blob reader
+  s_dimm_disc_volume = DiscIO::CreateVolume(volume.GetBlobReader().CopyReader());
+  if (!s_dimm_disc_volume)
   {
-    addr->sin_addr.s_addr = inet_addr("127.0.0.1");
-    addr->sin_family = htons(AF_INET);  // fix family?
-    s_namco_cam = fd;
+    PanicAlertFmt("GC-AM: Failed to open the game image for the DIMM");
+    ShutdownDIMM();
+    return;
   }
 
-  // Key of Avalon Client
-  if (addr->sin_addr.s_addr == inet_addr("192.168.13.1"))
+  s_dimm_disc_data_size =
+      static_cast<u32>(std::min<u64>(s_dimm_disc_volume->GetDataSize(), DIMM_DISC_SIZE));
+
+  for (auto& loaded : s_dimm_disc_loaded)
+    loaded.store(false, std::memory_order_relaxed);
+
+  s_dimm_prefetch_stop.Clear();
+  s_dimm_prefetch_thread = std::thread(DIMMPrefetchThread);
+}
+
+static bool ReadMediaBoardStatus(const DMATransfer& transfer, u32 region_offset,
+                                 const DMARegion& region)
+{
+  const u32 length = transfer.length;
+
+  // Same byte order as Memory::Write_U16/Write_U32
+  const auto write_u16 = [&](u16 value, u32 offset) {
+    const u16 big_endian = Common::swap16(value);
+    memcpy(transfer.data + offset, &big_endian, sizeof(big_endian));
+  };
+  const auto write_u32 = [&](u32 value, u32 offset) {
+    const u32 big_endian = Common::swap32(value);
+    memcpy(transfer.data + offset, &big_endian, sizeof(big_endian));
+  };
+
+  switch (transfer.offset)
   {
-    addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+  // Media board status (1)
+  case 0x80000000:
+    write_u16(Common::swap16(0x0100), 0);
+    break;
+  // Media board status (2)
+  case 0x80000020:
+    memset(transfer.data, 0, length);
+    break;
+  // Media board status (3)
+  case 0x80000040:
+    memset(transfer.data, 0xFF, length);
+    // DIMM size (512MB)
+    write_u32(Common::swap32(0x20000000), 0);
+    // GCAM signature
+    write_u32(0x4743414D, 4);
+    break;
+  // ?
+  case 0x80000100:
+    write_u32(Common::swap32((u32)0x001F1F1F), 0);
+    break;
+  // Firmware status (1)
+  case 0x80000120:
+    write_u32(Common::swap32((u32)0x01FA), 0);
+    break;
+  // Firmware status (2)
+  case 0x80000140:
+    write_u32(Common::swap32((u32)1), 0);
+    break;
+  case 0x80000160:
+    write_u32(0x00001E00, 0);
+    break;
+  case 0x80000180:
+    write_u32(0, 0);
+    break;
+  case 0x800001A0:
+    write_u32(0xFFFFFFFF, 0);
+    break;
+  default:
+    PrintMBBuffer(transfer.data, length);
+    PanicAlertFmtT("Unhandled Media Board Read:{0:08x}", transfer.offset);
+    break;
   }
+  return true;
+}
 
-  addr->sin_family = Common::swap16(addr->sin_family);
-  //*(u32*)(&addr.sin_addr) = Common::swap32(*(u32*)(&addr.sin_addr));
+static bool ReadNetworkConfig(const DMATransfer& transfer, u32 region_offset,
+                              const DMARegion& region)
+{
+  s_netcfg.Read(0, transfer.data, transfer.length);
+  return true;
+}
 
-  u_long val = 1;
-  ioctlsocket(fd, FIONBIO, &val);
+static bool WriteNetworkConfig(const DMATransfer& transfer, u32 region_offset,
+                               const DMARegion& region)
+{
+  s_netcfg.Write(0, transfer.data, transfer.length);
+  return true;
+}
 
-  int ret = connect(fd, (const sockaddr*)addr, len);
-  int err = WSAGetLastError();
+static bool ReadExtraSettings(const DMATransfer& transfer, u32 region_offset,
+                              const DMARegion& region)
+{
+  s_extra.Read(0, transfer.data, transfer.length);
+  return true;
+}
 
-  val = 0;
-  ioctlsocket(fd, FIONBIO, &val);
+static bool WriteExtraSettings(const DMATransfer& transfer, u32 region_offset,
+                               const DMARegion& region)
+{
+  s_extra.Write(0, transfer.data, transfer.length);
+  return true;
+}
 
-  if (ret == SOCKET_ERROR)
-  {
-    if (err == WSAEWOULDBLOCK)
-    {
-      s_last_error = SSC_EWOULDBLOCK;
+static bool ReadNetworkControl(const DMATransfer& transfer, u32 region_offset,
+                               const DMARegion& region)
+{
+  s_netctrl.Read(0, transfer.data, transfer.length);
+  return true;
+}
 
-      fd_set writefds, errfds;
+static bool WriteNetworkControl(const DMATransfer& transfer, u32 region_offset,
+                                const DMARegion& region)
+{
+  s_netctrl.Write(0, transfer.data, transfer.length);
+  return true;
+}
 
-      timeval timeout;
-      timeout.tv_sec = 1;
-      timeout.tv_usec = 0;
+static bool ReadDIMM(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  s_dimm.Read(region_offset, transfer.data, transfer.length);
+  return true;
+}
 
-      FD_ZERO(&writefds);
-      FD_ZERO(&errfds);
+static bool WriteDIMM(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  s_dimm.Write(region_offset, transfer.data, transfer.length);
+  return true;
+}
 
-      FD_SET(fd, &writefds);
-      FD_SET(fd, &errfds);
+static bool WriteBackup(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  // The backup file is addressed by the absolute offset
+  s_backup.Write(transfer.offset, transfer.data, transfer.length);
+  return true;
+}
 
-      ret = select(fd, nullptr, &writefds, &errfds, &timeout);
-      if (ret < 0)
-      {
-        err = WSAGetLastError();
-      }
-      else
-      {
-        if (FD_ISSET(fd, &writefds))
-        {
-          s_last_error = SSC_SUCCESS;
-          ret = 0;
-        }
-        else
-        {
-          ret = SOCKET_ERROR;
-        }
-      }
-    }
-  }
-  else
-  {
-    s_last_error = SSC_SUCCESS;
-  }
-  return ret;
+static bool ReadMediaBoardCommArea(const DMATransfer& transfer, u32 region_offset,
+                                   const DMARegion& region)
+{
+  memcpy(transfer.data, s_media_buffer + region_offset, transfer.length);
+
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read {} ({:08x},{})", region.name, transfer.offset,
+               transfer.length);
+  PrintMBBuffer(transfer.data, transfer.length);
+  return true;
 }
 
-u32 ExecuteCommand(std::array<u32, 3>& DICMDBUF, u32 address, u32 length)
+static bool WriteMediaBoardCommArea(const DMATransfer& transfer, u32 region_offset,
+                                    const DMARegion& region)
 {
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  auto& ppc_state = system.GetPPCState();
-  auto& jit_interface = system.GetJitInterface();
+  memcpy(s_media_buffer + region_offset, transfer.data, transfer.length);
 
-  /*
-    The triforce IPL sends these commands first
-    01010000 00000101 00000000
-    01010000 00000000 0000ffff
-  */
-  if (s_GCAM_key_a == 0)
-  {
-    /*
-      Since it is currently unknown how the seed is created
-      we have to patch out the crypto.
-    */
-    if (memory.Read_U32(0x8131ecf4))
-    {
-      memory.Write_U32(0, 0x8131ecf4);
-      memory.Write_U32(0, 0x8131ecf8);
-      memory.Write_U32(0, 0x8131ecfC);
-      memory.Write_U32(0, 0x8131ebe0);
-      memory.Write_U32(0, 0x8131ed6c);
-      memory.Write_U32(0, 0x8131ed70);
-      memory.Write_U32(0, 0x8131ed74);
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write {} ({:08x},{})", region.name, transfer.offset,
+               transfer.length);
+  PrintMBBuffer(transfer.data, transfer.length);
+  return true;
+}
 
-      memory.Write_U32(0x4E800020, 0x813025C8);
-      memory.Write_U32(0x4E800020, 0x81302674);
+static bool ReadNetworkCommandBuffer(const DMATransfer& transfer, u32 region_offset,
+                                     const DMARegion& region)
+{
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read {} ({:08x},{})", region.name, transfer.offset,
+               transfer.length);
+  memcpy(transfer.data, s_network_command_buffer + region_offset, transfer.length);
+  return true;
+}
 
-      ppc_state.iCache.Invalidate(memory, jit_interface, 0x813025C8);
-      ppc_state.iCache.Invalidate(memory, jit_interface, 0x81302674);
+static bool WriteNetworkCommandBuffer(const DMATransfer& transfer, u32 region_offset,
+                                      const DMARegion& region)
+{
+  memcpy(s_network_command_buffer + region_offset, transfer.data, transfer.length);
 
-      HLE::Patch(system, 0x813048B8, "OSReport");
-      HLE::Patch(system, 0x8130095C, "OSReport");  // Apploader
-    }
-  }
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write {} ({:08x},{})", region.name, region_offset,
+               transfer.length);
+  PrintMBBuffer(transfer.data, transfer.length);
+  return true;
+}
 
-  DICMDBUF[0] ^= s_GCAM_key_a;
-  DICMDBUF[1] ^= s_GCAM_key_b;
-  // length ^= s_GCAM_key_c; // DMA length is always plain
+static bool ReadNetworkBuffer(const DMATransfer& transfer, u32 region_offset,
+                              const DMARegion& region)
+{
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read {} ({:08x},{})", region.name, transfer.offset,
+               transfer.length);
+  memcpy(transfer.data, s_network_buffer + region_offset, transfer.length);
+  return true;
+}
 
-  u32 seed = DICMDBUF[0] >> 16;
+static bool WriteNetworkBuffer(const DMATransfer& transfer, u32 region_offset,
+                               const DMARegion& region)
+{
+  memcpy(s_network_buffer + region_offset, transfer.data, transfer.length);
 
-  s_GCAM_key_a *= seed;
-  s_GCAM_key_b *= seed;
-  s_GCAM_key_c *= seed;
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write {} ({:08x},{})", region.name, region_offset,
+               transfer.length);
+  PrintMBBuffer(transfer.data, transfer.length);
+  return true;
+}
 
-  DICMDBUF[0] <<= 24;
-  DICMDBUF[1] <<= 2;
+// NETDIMM execute command (V2)
+static bool ExecuteNetDIMMCommand(const DMATransfer& transfer, u32 region_offset,
+                                  const DMARegion& region)
+{
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: EXECUTE MEDIA BOARD COMMAND");
 
-  // SegaBoot adds bits for some reason to offset/length
-  // also adds 0x20 to offset
-  if (DICMDBUF[1] == 0x00100440)
-  {
-    s_segaboot = 1;
-  }
+  memcpy(s_media_buffer, s_media_buffer + 0x200, 0x20);
+  memset(s_media_buffer + 0x200, 0, 0x20);
+  s_media_buffer[0x204] = 1;
 
-  u32 command = DICMDBUF[0];
-  u32 offset = DICMDBUF[1];
+  // Recast for easier access
+  u32* media_buffer_32 = (u32*)(s_media_buffer);
+  u16* media_buffer_16 = (u16*)(s_media_buffer);
 
-  INFO_LOG_FMT(DVDINTERFACE,
-               "GCAM: {:08x} {:08x} DMA=addr:{:08x},len:{:08x} Keys: {:08x} {:08x} {:08x}", command,
-               offset, address, length, s_GCAM_key_a, s_GCAM_key_b, s_GCAM_key_c);
+  const AMMBCommand mb_command = AMMBCommand(*(u16*)(s_media_buffer + 2));
 
-  // Test mode
-  if (offset == 0x0002440)
+  // Socket commands complete on the network thread instead of blocking the CPU thread
+  if (IsSocketCommand(mb_command))
   {
-    // Set by OSResetSystem
-    if (memory.Read_U32(0x811FFF00) == 1)
-    {
-      // Don't map firmware while in SegaBoot
-      if (memory.Read_U32(0x8006BF70) != 0x0A536567)
-      {
-        s_firmwaremap = 1;
-      }
-    }
+    SubmitNetworkCommand(transfer.system, mb_command);
+    memset(transfer.data, 0, transfer.length);
+    return true;
   }
 
-  switch (command >> 24)
+  switch (mb_command)
   {
-  // Inquiry
-  case 0x12:
-    if (s_firmwaremap == 1)
-    {
-      s_firmwaremap = 0;
-      s_segaboot = 0;
-    }
-
-    // Returned value is used to set the protocol version.
-    switch (GetGameType())
-    {
-    // Version 2
-    case KeyOfAvalon:
-    case MarioKartGP:
-    case MarioKartGP2:
-      return 0x29484100;
-
-    // Version 1
-    default:
-      return 0x21484100;
-    }
+  case AMMBCommand::Unknown_001:
+    media_buffer_32[1] = 1;
     break;
-  // Read
-  case 0xA8:
-    if ((offset & 0x8FFF0000) == 0x80000000)
-    {
-      switch (offset)
-      {
-      // Media board status (1)
-      case 0x80000000:
-        memory.Write_U16(Common::swap16(0x0100), address);
-        break;
-      // Media board status (2)
-      case 0x80000020:
-        memset(memory.GetPointer(address), 0, length);
-        break;
-      // Media board status (3)
-      case 0x80000040:
-        memset(memory.GetPointer(address), 0xFF, length);
-        // DIMM size (512MB)
-        memory.Write_U32(Common::swap32(0x20000000), address);
-        // GCAM signature
-        memory.Write_U32(0x4743414D, address + 4);
-        break;
-      // ?
-      case 0x80000100:
-        memory.Write_U32(Common::swap32((u32)0x001F1F1F), address);
-        break;
-      // Firmware status (1)
-      case 0x80000120:
-        memory.Write_U32(Common::swap32((u32)0x01FA), address);
-        break;
-      // Firmware status (2)
-      case 0x80000140:
-        memory.Write_U32(Common::swap32((u32)1), address);
-        break;
-      case 0x80000160:
-        memory.Write_U32(0x00001E00, address);
-        break;
-      case 0x80000180:
-        memory.Write_U32(0, address);
-        break;
-      case 0x800001A0:
-        memory.Write_U32(0xFFFFFFFF, address);
-        break;
-      default:
-        PrintMBBuffer(address, length);
-        PanicAlertFmtT("Unhandled Media Board Read:{0:08x}", offset);
-        break;
-      }
-      return 0;
-    }
-
-    // Network configuration
-    if ((offset == 0x00000000) && (length == 0x80))
-    {
-      s_netcfg->Seek(0, File::SeekOrigin::Begin);
-      s_netcfg->ReadBytes(memory.GetPointer(address), length);
-      return 0;
-    }
-
-    // Extra Settings
-    // media crc check on/off
-    if ((offset == 0x1FFEFFE0) && (length == 0x20))
-    {
-      s_extra->Seek(0, File::SeekOrigin::Begin);
-      s_extra->ReadBytes(memory.GetPointer(address), length);
-      return 0;
-    }
-
-    // DIMM memory (8MB)
-    if ((offset >= 0x1F000000) && (offset <= 0x1F800000))
-    {
-      u32 dimmoffset = offset - 0x1F000000;
-      s_dimm->Seek(dimmoffset, File::SeekOrigin::Begin);
-      s_dimm->ReadBytes(memory.GetPointer(address), length);
-      return 0;
-    }
-
-    // DIMM command (V1)
-    if ((offset >= 0x1F900000) && (offset <= 0x1F90003F))
-    {
-      u32 dimmoffset = offset - 0x1F900000;
-      memcpy(memory.GetPointer(address), s_media_buffer + dimmoffset, length);
-
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read MEDIA BOARD COMM AREA (1) ({:08x},{})", offset,
-                   length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
-
-    // Network command
-    if ((offset >= NetworkCommandAddress) && (offset <= 0x1FCFFFFF))
-    {
-      u32 dimmoffset = offset - NetworkCommandAddress;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read NETWORK COMMAND BUFFER ({:08x},{})", offset, length);
-      memcpy(memory.GetPointer(address), s_network_command_buffer + dimmoffset, length);
-      return 0;
-    }
-
-    // Network command
-    if ((offset >= NetworkCommandAddress2) && (offset <= 0x890601FF))
-    {
-      u32 dimmoffset = offset - NetworkCommandAddress2;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read NETWORK COMMAND BUFFER (2) ({:08x},{})", offset,
-                   length);
-      memcpy(memory.GetPointer(address), s_network_command_buffer + dimmoffset, length);
-      return 0;
-    }
-
-    // Network buffer
-    if ((offset >= 0x1FA00000) && (offset <= 0x1FA0FFFF))
-    {
-      u32 dimmoffset = offset - 0x1FA00000;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read NETWORK BUFFER (1) ({:08x},{})", offset, length);
-      memcpy(memory.GetPointer(address), s_network_buffer + dimmoffset, length);
-      return 0;
-    }
-
-    // Network buffer
-    if ((offset >= 0x1FD00000) && (offset <= 0x1FD0FFFF))
-    {
-      u32 dimmoffset = offset - 0x1FD00000;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read NETWORK BUFFER (2) ({:08x},{})", offset, length);
-      memcpy(memory.GetPointer(address), s_network_buffer + dimmoffset, length);
-      return 0;
-    }
-
-    // Network buffer
-    if ((offset >= 0x89100000) && (offset <= 0x8910FFFF))
-    {
-      u32 dimmoffset = offset - 0x89100000;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read NETWORK BUFFER (3) ({:08x},{})", offset, length);
-      memcpy(memory.GetPointer(address), s_network_buffer + dimmoffset, length);
-      return 0;
-    }
-
-    // NETDIMM command (V2)
-    if ((offset >= 0x84000000) && (offset <= 0x8400005F))
-    {
-      u32 dimmoffset = offset - 0x84000000;
-      memcpy(memory.GetPointer(address), s_media_buffer + dimmoffset, length);
-
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read MEDIA BOARD COMM AREA (2) ({:08x},{})", offset,
-                   length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
-
-    // NETDIMM execute command (V2)
-    if (offset == 0x88000000)
-    {
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: EXECUTE MEDIA BOARD COMMAND");
-
-      memcpy(s_media_buffer, s_media_buffer + 0x200, 0x20);
-      memset(s_media_buffer + 0x200, 0, 0x20);
-      s_media_buffer[0x204] = 1;
-
-      // Recast for easier access
-      u32* media_buffer_32 = (u32*)(s_media_buffer);
-      u16* media_buffer_16 = (u16*)(s_media_buffer);
-
-      switch (AMMBCommand(*(u16*)(s_media_buffer + 2)))
-      {
-      case AMMBCommand::Unknown_001:
-        media_buffer_32[1] = 1;
-        break;
-      case AMMBCommand::GetNetworkFirmVersion:
-        media_buffer_32[1] = Common::swap16(0x1305);  // Version: 13.05
-        s_media_buffer[6] = 1;                        // Type: VxWorks
-        break;
-      case AMMBCommand::GetSystemFlags:
-        s_media_buffer[4] = 1;
-        s_media_buffer[6] = 2;  // 2: NAND/MASK BOARD(NAND)
-        s_media_buffer[7] = 1;
-        break;
-      // Empty reply
-      case AMMBCommand::Unknown_103:
-        break;
-      // Network Commands
-      case AMMBCommand::Accept:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        int ret = -1;
-
-        // Handle optional paramters
-        if (media_buffer_32[3] == 0 || media_buffer_32[4] == 0)
-        {
-          ret = NetDIMMAccept(fd, nullptr, nullptr);
-        }
-        else
-        {
-          u32 addr_off = media_buffer_32[3] - NetworkCommandAddress2;
-          u32 len_off = media_buffer_32[4] - NetworkCommandAddress2;
-
-          struct sockaddr* addr = (struct sockaddr*)(s_network_command_buffer + addr_off);
-          int* len = (int*)(s_network_command_buffer + len_off);
-
-          ret = NetDIMMAccept(fd, addr, len);
-        }
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: accept( {}({}) ):{}\n", fd, media_buffer_32[2], ret);
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::Bind:
-      {
-        struct sockaddr_in addr;
-
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 off = media_buffer_32[3] - NetworkCommandAddress2;
-        u32 len = media_buffer_32[4];
-
-        memcpy((void*)&addr, s_network_command_buffer + off, sizeof(struct sockaddr_in));
-
-        addr.sin_family = Common::swap16(addr.sin_family);
-        *(u32*)(&addr.sin_addr) = Common::swap32(*(u32*)(&addr.sin_addr));
-
-        /*
-          Triforce games usually use hardcoded IPs
-          This is replaced to listen to the ANY address instead
-        */
-        addr.sin_addr.s_addr = INADDR_ANY;
-
-        int ret = bind(fd, (const sockaddr*)&addr, len);
-        int err = WSAGetLastError();
-
-        // if (ret < 0 )
-        //   PanicAlertFmt("Socket Bind Failed with{0}", err);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: bind( {}, ({},{:08x}:{}), {} ):{} ({})\n", fd,
-                       addr.sin_family, addr.sin_addr.s_addr, Common::swap16(addr.sin_port), len,
-                       ret, err);
-
-        media_buffer_32[1] = ret;
-        s_last_error = SSC_SUCCESS;
-      }
-      break;
-      case AMMBCommand::Closesocket:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-
-        int ret = closesocket(fd);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: closesocket( {}({}) ):{}\n", fd, media_buffer_32[2],
-                       ret);
-
-        s_sockets[media_buffer_32[2]] = SOCKET_ERROR;
-
-        media_buffer_32[1] = ret;
-        s_last_error = SSC_SUCCESS;
-      }
-      break;
-      case AMMBCommand::Connect:
-      {
-        struct sockaddr_in addr;
-
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 off = media_buffer_32[3] - NetworkCommandAddress2;
-        u32 len = media_buffer_32[4];
-
-        int ret = 0;
-        int err = 0;
-
-        memcpy((void*)&addr, s_network_command_buffer + off, sizeof(struct sockaddr_in));
-
-        ret = NetDIMMConnect(fd, &addr, len);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: connect( {}, ({},{}:{}), {} ):{} ({})\n", fd,
-                       addr.sin_family, inet_ntoa(addr.sin_addr), Common::swap16(addr.sin_port),
-                       len, ret, err);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::Listen:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 backlog = media_buffer_32[3];
-
-        int ret = listen(fd, backlog);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: listen( {}, {} ):{:d}\n", fd, backlog, ret);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::Recv:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 off = media_buffer_32[3];
-        u32 len = media_buffer_32[4];
-
-        if (len >= sizeof(s_network_buffer))
-        {
-          len = sizeof(s_network_buffer);
-        }
-
-        int ret = 0;
-        char* buffer = (char*)(s_network_buffer + off);
-
-        if (off >= NetworkBufferAddress4 && off < NetworkBufferAddress4 + sizeof(s_network_buffer))
-        {
-          buffer = (char*)(s_network_buffer + off - NetworkBufferAddress4);
-        }
-        else
-        {
-          PanicAlertFmt("RECV: Buffer overrun:{0} {1} ", off, len);
-        }
-
-        int err = 0;
-
-        ret = recv(fd, buffer, len, 0);
-        err = WSAGetLastError();
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: recv( {}, 0x{:08x}, {} ):{} {}\n", fd, off, len, ret,
-                       err);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::Send:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 off = media_buffer_32[3];
-        u32 len = media_buffer_32[4];
-
-        int ret = 0;
-
-        if (off >= NetworkBufferAddress3 && off < NetworkBufferAddress3 + sizeof(s_network_buffer))
-        {
-          off -= NetworkBufferAddress3;
-        }
-        else
-        {
-          ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: send(error) unhandled destination:{:08x}\n", off);
-        }
-
-        ret = send(fd, (char*)(s_network_buffer + off), len, 0);
-        int err = WSAGetLastError();
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: send( {}({}), 0x{:08x}, {} ): {} {}\n", fd,
-                       media_buffer_32[2], off, len, ret, err);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::Socket:
-      {
-        // Protocol is not sent
-        u32 af = media_buffer_32[2];
-        u32 type = media_buffer_32[3];
-
-        SOCKET fd = socket_(af, type, IPPROTO_TCP);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: socket( {}, {}, 6 ):{}\n", af, type, fd);
-
-        s_media_buffer[1] = 0;
-        media_buffer_32[1] = fd;
-      }
-      break;
-      case AMMBCommand::Select:
-      {
-        u32 nfds = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 ROffset = media_buffer_32[3] - NetworkCommandAddress2;
-        u32 WOffset = media_buffer_32[4] - NetworkCommandAddress2;
-        u32 EOffset = media_buffer_32[5] - NetworkCommandAddress2;
-        u32 TOffset = media_buffer_32[6] - NetworkCommandAddress2;
-
-        /*
-          BUG: NAMCAM is hardcoded to call this with socket ID 0x100 which might be some magic
-          thing? Winsocks expects a valid socket so we take the socket from the connect.
-        */
-        if (AMMediaboard::GetGameType() == MarioKartGP2)
-        {
-          if (nfds == 256)
-          {
-            nfds = s_namco_cam;
-          }
-        }
-
-        fd_set* readfds = nullptr;
-        fd_set* writefds = nullptr;
-
-        // Either of these can be zero
-        if (media_buffer_32[3])
-        {
-          readfds = (fd_set*)(s_network_command_buffer + ROffset);
-          FD_ZERO(readfds);
-          FD_SET(nfds, readfds);
-        }
-
-        if (media_buffer_32[4])
-        {
-          writefds = (fd_set*)(s_network_command_buffer + WOffset);
-          FD_ZERO(writefds);
-          FD_SET(nfds, writefds);
-        }
-
-        timeval timeout;
-        if (media_buffer_32[6])
-        {
-          memcpy(&timeout, (timeval*)(s_network_command_buffer + TOffset), sizeof(timeval));
-        }
-        else
-        {
-          timeout.tv_sec = s_timeouts[0] / 1000;
-          timeout.tv_usec = 0;
-        }
-
-        int ret = select(nfds, readfds, writefds, nullptr, &timeout);
-
-        int err = WSAGetLastError();
-
-        NOTICE_LOG_FMT(DVDINTERFACE,
-                       "GC-AM: select( {}({}), 0x{:08x} 0x{:08x} 0x{:08x} 0x{:08x} ):{} {} \n",
-                       nfds, media_buffer_32[2], media_buffer_32[3], media_buffer_32[4],
-                       media_buffer_32[5], media_buffer_32[6], ret, err);
-        // hexdump( NetworkCMDBuffer, 0x40 );
-
-        s_media_buffer[1] = 0;
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::SetSockOpt:
-      {
-        SOCKET fd = (SOCKET)(s_sockets[SocketCheck(media_buffer_32[2])]);
-        int level = (int)(media_buffer_32[3]);
-        int optname = (int)(media_buffer_32[4]);
-        const char* optval =
-            (char*)(s_network_command_buffer + media_buffer_32[5] - NetworkCommandAddress2);
-        int optlen = (int)(media_buffer_32[6]);
-
-        int ret = setsockopt(fd, level, optname, optval, optlen);
-
-        int err = WSAGetLastError();
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: setsockopt( {:d}, {:04x}, {}, {:p}, {} ):{:d} ({})\n",
-                       fd, level, optname, optval, optlen, ret, err);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::SetTimeOuts:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
-        u32 timeoutA = media_buffer_32[3];
-        u32 timeoutB = media_buffer_32[4];
-        u32 timeoutC = media_buffer_32[5];
-
-        s_timeouts[0] = timeoutA;
-        s_timeouts[1] = timeoutB;
-        s_timeouts[2] = timeoutC;
-
-        int ret = setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, (char*)&timeoutB, sizeof(int));
-        if (ret < 0)
-        {
-          ret = WSAGetLastError();
-        }
-        else
-        {
-          ret = setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeoutC, sizeof(int));
-          if (ret < 0)
-            ret = WSAGetLastError();
-        }
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: SetTimeOuts( {}, {}, {}, {} ):{}\n", fd, timeoutA,
-                       timeoutB, timeoutC, ret);
-
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = ret;
-      }
-      break;
-      case AMMBCommand::GetParambyDHCPExec:
-      {
-        u32 value = media_buffer_32[2];
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: GetParambyDHCPExec({})\n", value);
-
-        s_media_buffer[1] = 0;
-        media_buffer_32[1] = 0;
-      }
-      break;
-      case AMMBCommand::ModifyMyIPaddr:
-      {
-        u32 NetBufferOffset = *(u32*)(s_media_buffer + 8) - NetworkCommandAddress2;
-
-        char* IP = (char*)(s_network_command_buffer + NetBufferOffset);
-
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: modifyMyIPaddr({})\n", IP);
-      }
-      break;
-      case AMMBCommand::GetLastError:
-      {
-        u32 fd = s_sockets[SocketCheck(media_buffer_32[2])];
+  case AMMBCommand::GetNetworkFirmVersion:
+    media_buffer_32[1] = Common::swap16(0x1305);  // Version: 13.05
+    s_media_buffer[6] = 1;                        // Type: VxWorks
+    break;
+  case AMMBCommand::GetSystemFlags:
+    s_media_buffer[4] = 1;
+    s_media_buffer[6] = 2;  // 2: NAND/MASK BOARD(NAND)
+    s_media_buffer[7] = 1;
+    break;
+  // Empty reply
+  case AMMBCommand::Unknown_103:
+    break;
+  // Network Commands
+  case AMMBCommand::GetParambyDHCPExec:
+  {
+    u32 value = media_buffer_32[2];
 
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: GetLastError( {}({}) )\n", fd, media_buffer_32[2] );
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: GetParambyDHCPExec({})\n", value);
 
-        s_media_buffer[1] = s_media_buffer[8];
-        media_buffer_32[1] = s_last_error;
-      }
-      break;
-      case AMMBCommand::InitLink:
-        NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: InitLink");
-        break;
-      default:
-        ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Command:{:03X}", *(u16*)(s_media_buffer + 2));
-        ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Command Unhandled!");
-        break;
-      }
+    s_media_buffer[1] = 0;
+    media_buffer_32[1] = 0;
+  }
+  break;
+  case AMMBCommand::ModifyMyIPaddr:
+  {
+    u32 NetBufferOffset = *(u32*)(s_media_buffer + 8) - NetworkCommandAddress2;
 
-      s_media_buffer[3] |= 0x80;  // Command complete flag
+    char* IP = (char*)(s_network_command_buffer + NetBufferOffset);
 
-      memset(memory.GetPointer(address), 0, length);
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: modifyMyIPaddr({})\n", IP);
+  }
+  break;
+  case AMMBCommand::GetLastError:
+  {
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: GetLastError( {} )\n", media_buffer_32[2]);
 
-      ExpansionInterface::GenerateInterrupt(0x10);
-      return 0;
-    }
+    s_media_buffer[1] = s_media_buffer[8];
+    media_buffer_32[1] = s_last_error;
+  }
+  break;
+  case AMMBCommand::InitLink:
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: InitLink");
+    break;
+  default:
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Command:{:03X}", *(u16*)(s_media_buffer + 2));
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Command Unhandled!");
+    break;
+  }
 
-    // NETDIMM command (V2)
-    if ((offset >= 0x89000000) && (offset <= 0x89000200))
-    {
-      u32 dimmoffset = offset - 0x89000000;
-      memcpy(memory.GetPointer(address), s_media_buffer + dimmoffset, length);
+  s_media_buffer[3] |= 0x80;  // Command complete flag
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Read MEDIA BOARD COMM AREA (3) ({:08x})", dimmoffset);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+  memset(transfer.data, 0, transfer.length);
 
-    // DIMM memory (8MB)
-    if ((offset >= 0xFF000000) && (offset <= 0xFF800000))
-    {
-      u32 dimmoffset = offset - 0xFF000000;
-      s_dimm->Seek(dimmoffset, File::SeekOrigin::Begin);
-      s_dimm->ReadBytes(memory.GetPointer(address), length);
-      return 0;
-    }
-    // Network control
-    if ((offset == 0xFFFF0000) && (length == 0x20))
-    {
-      s_netctrl->Seek(0, File::SeekOrigin::Begin);
-      s_netctrl->ReadBytes(memory.GetPointer(address), length);
-      return 0;
-    }
+  ExpansionInterface::GenerateInterrupt(0x10);
+  return true;
+}
 
-    // Max GC disc offset
-    if (offset >= 0x57058000)
-    {
-      PanicAlertFmtT("Unhandled Media Board Read:{0:08x}", offset);
-      return 0;
-    }
+// DIMM command, used when inquiry returns 0x29000000
+static bool WriteNetDIMMCommand(const DMATransfer& transfer, u32 region_offset,
+                                const DMARegion& region)
+{
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write {} ({:08x},{})", region.name, transfer.offset,
+               transfer.length);
+  PrintMBBuffer(transfer.data, transfer.length);
 
-    if (s_firmwaremap)
-    {
-      if (s_segaboot)
-      {
-        DICMDBUF[1] &= ~0x00100000;
-        DICMDBUF[1] -= 0x20;
-      }
-      memcpy(memory.GetPointer(address), s_firmware + offset, length);
-      return 0;
-    }
+  const u8 cmd_flag = transfer.data[0];
 
-    if (s_dimm_disc)
-    {
-      memcpy(memory.GetPointer(address), s_dimm_disc + offset, length);
-      return 0;
-    }
+  if (region_offset == 0x40 && cmd_flag == 1)
+  {
+    // Recast for easier access
+    u32* media_buffer_in_32 = (u32*)(s_media_buffer + 0x20);
+    u16* media_buffer_in_16 = (u16*)(s_media_buffer + 0x20);
+    u32* media_buffer_out_32 = (u32*)(s_media_buffer);
+    u16* media_buffer_out_16 = (u16*)(s_media_buffer);
 
-    return 1;
-    break;
-  // Write
-  case 0xAA:
-    if ((offset == 0x00600000) && (length == 0x20))
-    {
-      s_firmwaremap = 1;
-      return 0;
-    }
+    INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Execute command:{:03X}", media_buffer_in_16[1]);
 
-    if ((offset == 0x00700000) && (length == 0x20))
-    {
-      s_firmwaremap = 1;
-      return 0;
-    }
+    memset(s_media_buffer, 0, 0x20);
 
-    if (s_firmwaremap)
-    {
-      // Firmware memory (2MB)
-      if ((offset >= 0x00400000) && (offset <= 0x600000))
-      {
-        u32 fwoffset = offset - 0x00400000;
-        memcpy(s_firmware + fwoffset, memory.GetPointer(address), length);
-        return 0;
-      }
-    }
+    media_buffer_out_32[0] = media_buffer_in_32[0] | 0x80000000;  // Set command okay flag
 
-    // Network configuration
-    if ((offset == 0x00000000) && (length == 0x80))
+    for (u32 i = 0; i < 0x20; i += 4)
     {
-      s_netcfg->Seek(0, File::SeekOrigin::Begin);
-      s_netcfg->WriteBytes(memory.GetPointer(address), length);
-      s_netcfg->Flush();
-      return 0;
+      *(u32*)(s_media_buffer + 0x40 + i) = *(u32*)(s_media_buffer);
     }
 
-    // Extra Settings
-    // media crc check on/off
-    if ((offset == 0x1FFEFFE0) && (length == 0x20))
+    switch (media_buffer_in_16[1])
     {
-      s_extra->Seek(0, File::SeekOrigin::Begin);
-      s_extra->WriteBytes(memory.GetPointer(address), length);
-      s_extra->Flush();
-      return 0;
+    // ?
+    case 0x000:
+      media_buffer_out_32[1] = 1;
+      break;
+    // NAND size
+    case 0x001:
+      media_buffer_out_32[1] = 0x1FFF8000;
+      break;
+    // Loading Progress
+    case 0x100:
+      // Status
+      media_buffer_out_32[1] = 5;
+      // Progress in %
+      media_buffer_out_32[2] = 100;
+      break;
+    // SegaBoot version: 3.09
+    case 0x101:
+      // Version
+      media_buffer_out_16[2] = Common::swap16(0x0309);
+      // Unknown
+      media_buffer_out_16[3] = 2;
+      media_buffer_out_32[2] = 0x4746;  // "GF"
+      media_buffer_out_32[4] = 0xFF;
+      break;
+    // System flags
+    case 0x102:
+      // 1: GD-ROM
+      s_media_buffer[4] = 0;
+      s_media_buffer[5] = 1;
+
+      // Enable development mode (Sega Boot)
+      // This also allows region free booting
+      s_media_buffer[6] = 1;
+
+      media_buffer_out_16[4] = 0;  // Access Count
+
+      // Only used when inquiry 0x29
+      //  0: NAND/MASK BOARD(HDD)
+      //  1: NAND/MASK BOARD(MASK)
+      //  2: NAND/MASK BOARD(NAND)
+      //  3: NAND/MASK BOARD(NAND)
+      //  4: DIMM BOARD (TYPE 3)
+      //  5: DIMM BOARD (TYPE 3)
+      //  6: DIMM BOARD (TYPE 3)
+      //  7: N/A
+      //  8: Unknown
+      s_media_buffer[7] = 1;
+      break;
+    // Media board serial
+    case 0x103:
+      memcpy(s_media_buffer + 4, "A85E-01A62204904", 16);
+      break;
+    case 0x104:
+      s_media_buffer[4] = 1;
+      break;
     }
 
-    // Backup memory (8MB)
-    if ((offset >= 0x000006A0) && (offset <= 0x00800000))
-    {
-      s_backup->Seek(offset, File::SeekOrigin::Begin);
-      s_backup->WriteBytes(memory.GetPointer(address), length);
-      s_backup->Flush();
-      return 0;
-    }
+    memcpy(transfer.data, s_media_buffer, transfer.length);
 
-    // DIMM memory (8MB)
-    if ((offset >= 0x1F000000) && (offset <= 0x1F800000))
-    {
-      u32 dimmoffset = offset - 0x1F000000;
-      s_dimm->Seek(dimmoffset, File::SeekOrigin::Begin);
-      s_dimm->WriteBytes(memory.GetPointer(address), length);
-      s_dimm->Flush();
-      return 0;
-    }
+    memset(s_media_buffer + 0x20, 0, 0x20);
 
-    // Network command
-    if ((offset >= NetworkCommandAddress) && (offset <= 0x1F8003FF))
-    {
-      u32 dimmoffset = offset - NetworkCommandAddress;
+    ExpansionInterface::GenerateInterrupt(0x04);
+    return true;
+  }
+  else
+  {
+    memcpy(s_media_buffer + region_offset, transfer.data, transfer.length);
+  }
+  return true;
+}
 
-      memcpy(s_network_command_buffer + dimmoffset, memory.GetPointer(address), length);
+static bool MapFirmware(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  s_firmwaremap = 1;
+  return true;
+}
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write NETWORK COMMAND BUFFER ({:08x},{})", dimmoffset,
-                     length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+static bool WriteFirmwareMemory(const DMATransfer& transfer, u32 region_offset,
+                                const DMARegion& region)
+{
+  // Only writable while the firmware is mapped, the backup memory is below otherwise
+  if (!s_firmwaremap)
+    return false;
 
-    // Network command
-    if ((offset >= NetworkCommandAddress2) && (offset <= 0x890601FF))
-    {
-      u32 dimmoffset = offset - NetworkCommandAddress2;
+  memcpy(s_firmware + region_offset, transfer.data, transfer.length);
+  return true;
+}
 
-      memcpy(s_network_command_buffer + dimmoffset, memory.GetPointer(address), length);
+static bool WriteFirmware(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write Firmware ({:08x})", region_offset);
+  PrintMBBuffer(transfer.data, transfer.length);
+  return true;
+}
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write NETWORK COMMAND BUFFER (2) ({:08x},{})",
-                     dimmoffset, length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+// Game data, either from the firmware while it is mapped or from the game in the DIMM
+static bool ReadGameData(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  if (s_firmwaremap)
+  {
+    // SegaBoot sets bit 20 of the offset of its firmware reads and adds 0x20 to it
+    u32 offset = transfer.offset;
+    if (s_segaboot && (offset & 0x00100000) != 0)
+      offset = (offset & ~0x00100000) - 0x20;
+
+    memcpy(transfer.data, s_firmware + offset, transfer.length);
+    return true;
+  }
 
-    // Network buffer
-    if ((offset >= 0x1FA00000) && (offset <= 0x1FA1FFFF))
+  if (s_dimm_disc)
+  {
+    if (transfer.offset + transfer.length > DIMM_DISC_SIZE)
     {
-      u32 dimmoffset = offset - 0x1FA00000;
+      PanicAlertFmtT("Unhandled Media Board Read:{0:08x}", transfer.offset);
+      return true;
+    }
 
-      memcpy(s_network_buffer + dimmoffset, memory.GetPointer(address), length);
+    EnsureDIMMLoaded(transfer.offset, transfer.length);
+    memcpy(transfer.data, s_dimm_disc + transfer.offset, transfer.length);
+    return true;
+  }
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write NETWORK BUFFER (1) ({:08x},{})", dimmoffset,
-                     length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+  // Passed on to the regular DVD read path
+  return false;
+}
 
-    // Network buffer
-    if ((offset >= 0x1FD00000) && (offset <= 0x1FD0FFFF))
-    {
-      u32 dimmoffset = offset - 0x1FD00000;
+// Past the max GC disc offset
+static bool ReadUnhandled(const DMATransfer& transfer, u32 region_offset, const DMARegion& region)
+{
+  PanicAlertFmtT("Unhandled Media Board Read:{0:08x}", transfer.offset);
+  return true;
+}
 
-      memcpy(s_network_buffer + dimmoffset, memory.GetPointer(address), length);
+static bool WriteUnhandled(const DMATransfer& transfer, u32 region_offset,
+                           const DMARegion& region)
+{
+  PrintMBBuffer(transfer.data, transfer.length);
+  PanicAlertFmtT("Unhandled Media Board Write:{0:08x}", transfer.offset);
+  return true;
+}
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write NETWORK BUFFER (2) ({:08x},{})", dimmoffset,
-                     length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+// Regions are listed in the order they are checked
+static void RegisterDMARegions()
+{
+  s_read_regions.Clear();
 
-    // Network buffer
-    if ((offset >= 0x89100000) && (offset <= 0x8910FFFF))
-    {
-      u32 dimmoffset = offset - 0x89100000;
+  // The status registers ignore bits 28-30 of the offset
+  for (u32 i = 0; i < 8; ++i)
+  {
+    const u32 base = 0x80000000 | (i << 28);
+    s_read_regions.Register("MEDIA BOARD STATUS", base, base + 0xFFFF, 0, ReadMediaBoardStatus);
+  }
+  s_read_regions.Register("NETWORK CONFIG", 0x00000000, 0x00000000, 0x80, ReadNetworkConfig);
+  // Media crc check on/off
+  s_read_regions.Register("EXTRA SETTINGS", 0x1FFEFFE0, 0x1FFEFFE0, 0x20, ReadExtraSettings);
+  s_read_regions.Register("DIMM MEMORY", 0x1F000000, 0x1F800000, 0, ReadDIMM);
+  s_read_regions.Register("MEDIA BOARD COMM AREA (1)", 0x1F900000, 0x1F90003F, 0,
+                          ReadMediaBoardCommArea);
+  s_read_regions.Register("NETWORK COMMAND BUFFER", NetworkCommandAddress, 0x1FCFFFFF, 0,
+                          ReadNetworkCommandBuffer);
+  s_read_regions.Register("NETWORK COMMAND BUFFER (2)", NetworkCommandAddress2, 0x890601FF, 0,
+                          ReadNetworkCommandBuffer);
+  s_read_regions.Register("NETWORK BUFFER (1)", NetworkBufferAddress1, 0x1FA0FFFF, 0,
+                          ReadNetworkBuffer);
+  s_read_regions.Register("NETWORK BUFFER (2)", NetworkBufferAddress2, 0x1FD0FFFF, 0,
+                          ReadNetworkBuffer);
+  s_read_regions.Register("NETWORK BUFFER (3)", NetworkBufferAddress3, 0x8910FFFF, 0,
+                          ReadNetworkBuffer);
+  s_read_regions.Register("MEDIA BOARD COMM AREA (2)", 0x84000000, 0x8400005F, 0,
+                          ReadMediaBoardCommArea);
+  s_read_regions.Register("EXECUTE MEDIA BOARD COMMAND", 0x88000000, 0x88000000, 0,
+                          ExecuteNetDIMMCommand);
+  s_read_regions.Register("MEDIA BOARD COMM AREA (3)", 0x89000000, 0x89000200, 0,
+                          ReadMediaBoardCommArea);
+  s_read_regions.Register("DIMM MEMORY (2)", 0xFF000000, 0xFF800000, 0, ReadDIMM);
+  s_read_regions.Register("NETWORK CONTROL", 0xFFFF0000, 0xFFFF0000, 0x20, ReadNetworkControl);
+  s_read_regions.Register("UNHANDLED", 0x57058000, 0xFFFFFFFF, 0, ReadUnhandled);
+  s_read_regions.Register("GAME DATA", 0x00000000, 0x57057FFF, 0, ReadGameData);
+
+  s_write_regions.Clear();
+
+  s_write_regions.Register("FIRMWARE MAP", 0x00600000, 0x00600000, 0x20, MapFirmware);
+  s_write_regions.Register("FIRMWARE MAP (2)", 0x00700000, 0x00700000, 0x20, MapFirmware);
+  s_write_regions.Register("FIRMWARE MEMORY", 0x00400000, 0x00600000, 0, WriteFirmwareMemory);
+  s_write_regions.Register("NETWORK CONFIG", 0x00000000, 0x00000000, 0x80, WriteNetworkConfig);
+  s_write_regions.Register("EXTRA SETTINGS", 0x1FFEFFE0, 0x1FFEFFE0, 0x20, WriteExtraSettings);
+  s_write_regions.Register("BACKUP MEMORY", 0x000006A0, 0x00800000, 0, WriteBackup);
+  s_write_regions.Register("DIMM MEMORY", 0x1F000000, 0x1F800000, 0, WriteDIMM);
+  s_write_regions.Register("NETWORK COMMAND BUFFER", NetworkCommandAddress, 0x1F8003FF, 0,
+                           WriteNetworkCommandBuffer);
+  s_write_regions.Register("NETWORK COMMAND BUFFER (2)", NetworkCommandAddress2, 0x890601FF, 0,
+                           WriteNetworkCommandBuffer);
+  s_write_regions.Register("NETWORK BUFFER (1)", NetworkBufferAddress1, 0x1FA1FFFF, 0,
+                           WriteNetworkBuffer);
+  s_write_regions.Register("NETWORK BUFFER (2)", NetworkBufferAddress2, 0x1FD0FFFF, 0,
+                           WriteNetworkBuffer);
+  s_write_regions.Register("NETWORK BUFFER (3)", NetworkBufferAddress3, 0x8910FFFF, 0,
+                           WriteNetworkBuffer);
+  // Used when inquiry returns 0x21000000
+  s_write_regions.Register("MEDIA BOARD COMM AREA (1)", 0x1F900000, 0x1F90003F, 0,
+                           WriteMediaBoardCommArea);
+  s_write_regions.Register("MEDIA BOARD COMM AREA (2)", 0x84000000, 0x8400005F, 0,
+                           WriteNetDIMMCommand);
+  s_write_regions.Register("MEDIA BOARD COMM AREA (3)", 0x89000000, 0x89000200, 0,
+                           WriteMediaBoardCommArea);
+  s_write_regions.Register("FIRMWARE", 0x84800000, 0x84818000, 0, WriteFirmware);
+  s_write_regions.Register("DIMM MEMORY (2)", 0xFF000000, 0xFF800000, 0, WriteDIMM);
+  s_write_regions.Register("NETWORK CONTROL", 0xFFFF0000, 0xFFFF0000, 0x20, WriteNetworkControl);
+  s_write_regions.Register("UNHANDLED", 0x57058000, 0xFFFFFFFF, 0, WriteUnhandled);
+}
 
-      memcpy(s_network_buffer + dimmoffset, memory.GetPointer(address), length);
+u32 ExecuteCommand(std::array<u32, 3>& DICMDBUF, u32 address, u32 length)
+{
+  AMTimings::ScopedTimer timer(AMTimings::Subsystem::Mediaboard);
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write NETWORK BUFFER (3) ({:08x},{})", dimmoffset,
-                     length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  auto& ppc_state = system.GetPPCState();
+  auto& jit_interface = system.GetJitInterface();
 
-    // DIMM command, used when inquiry returns 0x21000000
-    if ((offset >= 0x1F900000) && (offset <= 0x1F90003F))
+  /*
+    The triforce IPL sends these commands first
+    01010000 00000101 00000000
+    01010000 00000000 0000ffff
+  */
+  if (s_GCAM_key_a == 0)
+  {
+    /*
+      Since it is currently unknown how the seed is created
+      we have to patch out the crypto.
+    */
+    if (memory.Read_U32(0x8131ecf4))
     {
-      u32 dimmoffset = offset - 0x1F900000;
-      memcpy(s_media_buffer + dimmoffset, memory.GetPointer(address), length);
+      memory.Write_U32(0, 0x8131ecf4);
+      memory.Write_U32(0, 0x8131ecf8);
+      memory.Write_U32(0, 0x8131ecfC);
+      memory.Write_U32(0, 0x8131ebe0);
+      memory.Write_U32(0, 0x8131ed6c);
+      memory.Write_U32(0, 0x8131ed70);
+      memory.Write_U32(0, 0x8131ed74);
 
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write MEDIA BOARD COMM AREA (1) ({:08x},{})", offset,
-                     length);
-      PrintMBBuffer(address, length);
-      return 0;
-    }
+      memory.Write_U32(0x4E800020, 0x813025C8);
+      memory.Write_U32(0x4E800020, 0x81302674);
 
-    // DIMM command, used when inquiry returns 0x29000000
-    if ((offset >= 0x84000000) && (offset <= 0x8400005F))
-    {
-      u32 dimmoffset = offset - 0x84000000;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write MEDIA BOARD COMM AREA (2) ({:08x},{})", offset,
-                     length);
-      PrintMBBuffer(address, length);
+      ppc_state.iCache.Invalidate(memory, jit_interface, 0x813025C8);
+      ppc_state.iCache.Invalidate(memory, jit_interface, 0x81302674);
 
-      u8 cmd_flag = memory.Read_U8(address);
+      HLE::Patch(system, 0x813048B8, "OSReport");
+      HLE::Patch(system, 0x8130095C, "OSReport");  // Apploader
+    }
+  }
 
-      if (dimmoffset == 0x40 && cmd_flag == 1)
-      {
-        // Recast for easier access
-        u32* media_buffer_in_32 = (u32*)(s_media_buffer + 0x20);
-        u16* media_buffer_in_16 = (u16*)(s_media_buffer + 0x20);
-        u32* media_buffer_out_32 = (u32*)(s_media_buffer);
-        u16* media_buffer_out_16 = (u16*)(s_media_buffer);
+  DICMDBUF[0] ^= s_GCAM_key_a;
+  DICMDBUF[1] ^= s_GCAM_key_b;
+  // length ^= s_GCAM_key_c; // DMA length is always plain
 
-        INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Execute command:{:03X}", media_buffer_in_16[1]);
+  u32 seed = DICMDBUF[0] >> 16;
 
-        memset(s_media_buffer, 0, 0x20);
+  s_GCAM_key_a *= seed;
+  s_GCAM_key_b *= seed;
+  s_GCAM_key_c *= seed;
 
-        media_buffer_out_32[0] = media_buffer_in_32[0] | 0x80000000;  // Set command okay flag
+  DICMDBUF[0] <<= 24;
+  DICMDBUF[1] <<= 2;
 
-        for (u32 i = 0; i < 0x20; i += 4)
-        {
-          *(u32*)(s_media_buffer + 0x40 + i) = *(u32*)(s_media_buffer);
-        }
+  // SegaBoot adds bits for some reason to offset/length
+  // also adds 0x20 to offset
+  if (DICMDBUF[1] == 0x00100440)
+  {
+    s_segaboot = 1;
+  }
 
-        switch (media_buffer_in_16[1])
-        {
-        // ?
-        case 0x000:
-          media_buffer_out_32[1] = 1;
-          break;
-        // NAND size
-        case 0x001:
-          media_buffer_out_32[1] = 0x1FFF8000;
-          break;
-        // Loading Progress
-        case 0x100:
-          // Status
-          media_buffer_out_32[1] = 5;
-          // Progress in %
-          media_buffer_out_32[2] = 100;
-          break;
-        // SegaBoot version: 3.09
-        case 0x101:
-          // Version
-          media_buffer_out_16[2] = Common::swap16(0x0309);
-          // Unknown
-          media_buffer_out_16[3] = 2;
-          media_buffer_out_32[2] = 0x4746;  // "GF"
-          media_buffer_out_32[4] = 0xFF;
-          break;
-        // System flags
-        case 0x102:
-          // 1: GD-ROM
-          s_media_buffer[4] = 0;
-          s_media_buffer[5] = 1;
-
-          // Enable development mode (Sega Boot)
-          // This also allows region free booting
-          s_media_buffer[6] = 1;
-
-          media_buffer_out_16[4] = 0;  // Access Count
-
-          // Only used when inquiry 0x29
-          //  0: NAND/MASK BOARD(HDD)
-          //  1: NAND/MASK BOARD(MASK)
-          //  2: NAND/MASK BOARD(NAND)
-          //  3: NAND/MASK BOARD(NAND)
-          //  4: DIMM BOARD (TYPE 3)
-          //  5: DIMM BOARD (TYPE 3)
-          //  6: DIMM BOARD (TYPE 3)
-          //  7: N/A
-          //  8: Unknown
-          s_media_buffer[7] = 1;
-          break;
-        // Media board serial
-        case 0x103:
-          memcpy(s_media_buffer + 4, "A85E-01A62204904", 16);
-          break;
-        case 0x104:
-          s_media_buffer[4] = 1;
-          break;
-        }
+  u32 command = DICMDBUF[0];
+  u32 offset = DICMDBUF[1];
 
-        memcpy(memory.GetPointer(address), s_media_buffer, length);
+  INFO_LOG_FMT(DVDINTERFACE,
+               "GCAM: {:08x} {:08x} DMA=addr:{:08x},len:{:08x} Keys: {:08x} {:08x} {:08x}", command,
+               offset, address, length, s_GCAM_key_a, s_GCAM_key_b, s_GCAM_key_c);
 
-        memset(s_media_buffer + 0x20, 0, 0x20);
+  u8 trace_flags = 0;
 
-        ExpansionInterface::GenerateInterrupt(0x04);
-        return 0;
-      }
-      else
+  // Test mode
+  if (offset == 0x0002440)
+  {
+    // Set by OSResetSystem
+    if (memory.Read_U32(0x811FFF00) == 1)
+    {
+      // Don't map firmware while in SegaBoot
+      if (memory.Read_U32(0x8006BF70) != 0x0A536567)
       {
-        memcpy(s_media_buffer + dimmoffset, memory.GetPointer(address), length);
+        s_firmwaremap = 1;
+        trace_flags |= TRACE_TEST_MODE;
       }
-      return 0;
     }
+  }
 
-    // DIMM command, used when inquiry returns 0x29000000
-    if ((offset >= 0x89000000) && (offset <= 0x89000200))
-    {
-      u32 dimmoffset = offset - 0x89000000;
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write MEDIA BOARD COMM AREA (3) ({:08x})", dimmoffset);
-      PrintMBBuffer(address, length);
-
-      memcpy(s_media_buffer + dimmoffset, memory.GetPointer(address), length);
-
-      return 0;
-    }
+  u8* const data = memory.GetPointer(address);
+  if (!s_trace.IsOpen())
+    return ExecuteDecryptedCommand(system, command, offset, address, length, data);
+
+  TraceRecord record{};
+  record.kind = TraceRecordKind::Command;
+  record.command = command;
+  record.offset = offset;
+  record.address = address;
+  record.length = length;
+  record.flags = trace_flags;
+
+  // Writes are replayed with their payload, reads are checked against the data they returned
+  std::vector<u8> payload;
+  if ((command >> 24) == 0xAA && data)
+    payload.assign(data, data + length);
+
+  record.result = ExecuteDecryptedCommand(system, command, offset, address, length, data);
+  if ((command >> 24) == 0xA8)
+    record.hash = HashTracePayload(data, length);
+
+  s_trace.Write(record, payload);
+  return record.result;
+}
 
-    // Firmware Write
-    if ((offset >= 0x84800000) && (offset <= 0x84818000))
+static u32 ExecuteDecryptedCommand(Core::System& system, u32 command, u32 offset, u32 address,
+                                   u32 length, u8* data)
+{
+  switch (command >> 24)
+  {
+  // Inquiry
+  case 0x12:
+    if (s_firmwaremap == 1)
     {
-      u32 dimmoffset = offset - 0x84800000;
-
-      INFO_LOG_FMT(DVDINTERFACE, "GC-AM: Write Firmware ({:08x})", dimmoffset);
-      PrintMBBuffer(address, length);
-      return 0;
+      s_firmwaremap = 0;
+      s_segaboot = 0;
     }
 
-    // DIMM memory (8MB)
-    if ((offset >= 0xFF000000) && (offset <= 0xFF800000))
+    // Returned value is used to set the protocol version.
+    switch (GetGameType())
     {
-      u32 dimmoffset = offset - 0xFF000000;
-      s_dimm->Seek(dimmoffset, File::SeekOrigin::Begin);
-      s_dimm->WriteBytes(memory.GetPointer(address), length);
-      s_dimm->Flush();
-      return 0;
+    // Version 2
+    case KeyOfAvalon:
+    case MarioKartGP:
+    case MarioKartGP2:
+      return 0x29484100;
+
+    // Version 1
+    default:
+      return 0x21484100;
     }
-    // Network control
-    if ((offset == 0xFFFF0000) && (length == 0x20))
-    {
-      s_netctrl->Seek(0, File::SeekOrigin::Begin);
-      s_netctrl->WriteBytes(memory.GetPointer(address), length);
-      s_netctrl->Flush();
+    break;
+  // Read
+  case 0xA8:
+  {
+    const DMATransfer transfer{system, offset, address, length, data};
+    if (s_read_regions.Dispatch(transfer))
       return 0;
-    }
-    // Max GC disc offset
-    if (offset >= 0x57058000)
-    {
-      PrintMBBuffer(address, length);
-      PanicAlertFmtT("Unhandled Media Board Write:{0:08x}", offset);
-    }
+    return 1;
+  }
+  // Write
+  case 0xAA:
+  {
+    const DMATransfer transfer{system, offset, address, length, data};
+    s_write_regions.Dispatch(transfer);
     break;
+  }
   // Execute
   case 0xAB:
     if ((offset == 0) && (length == 0))
@@ -1418,19 +1286,17 @@ u32 ExecuteCommand(std::array<u32, 3>& DICMDBUF, u32 address, u32 length)
       case AMMBCommand::GetMediaBoardStatus:
       {
         // Fake loading the game to have a chance to enter test mode
-        static u32 status = 4;
-        static u32 progress = 80;
         // Status
-        media_buffer_out_32[1] = status;
+        media_buffer_out_32[1] = s_board_status;
         // Progress in %
-        media_buffer_out_32[2] = progress;
-        if (progress < 100)
+        media_buffer_out_32[2] = s_load_progress;
+        if (s_load_progress < 100)
         {
-          progress++;
+          s_load_progress++;
         }
         else
         {
-          status = 5;
+          s_board_status = 5;
         }
       }
       break;
@@ -1471,8 +1337,12 @@ u32 ExecuteCommand(std::array<u32, 3>& DICMDBUF, u32 address, u32 length)
 
         // On real system it shows the status about the DIMM/GD-ROM here
         // We just show "TEST OK"
-        memory.Write_U32(0x54534554, media_buffer_in_32[4]);
-        memory.Write_U32(0x004B4F20, media_buffer_in_32[4] + 4);
+        if (!s_replaying)
+        {
+          auto& memory = system.GetMemory();
+          memory.Write_U32(0x54534554, media_buffer_in_32[4]);
+          memory.Write_U32(0x004B4F20, media_buffer_in_32[4] + 4);
+        }
 
         media_buffer_out_32[1] = media_buffer_in_32[1];
         break;
@@ -1565,6 +1435,9 @@ u32 GetMediaType(void)
 
 u32 GetGameType(void)
 {
+  if (s_replaying)
+    return s_replay_game_type;
+
   u64 game_id = 0;
 
   // Convert game ID into hex
@@ -1630,28 +1503,95 @@ u32 GetGameType(void)
   // never reached
 }
 
-void Shutdown(void)
+void FlushFiles()
 {
-  if(s_netcfg)
-    s_netcfg->Close();
+  s_netcfg.Flush();
+  s_netctrl.Flush();
+  s_extra.Flush();
+  s_backup.Flush();
+  s_dimm.Flush();
+}
 
-  if (s_netctrl)
-    s_netctrl->Close();
+void DoState(PointerWrap& p)
+{
+  p.Do(s_firmwaremap);
+  p.Do(s_segaboot);
+  p.Do(s_last_error);
+  p.Do(s_network_reply_pending);
+  p.Do(s_board_status);
+  p.Do(s_load_progress);
+
+  p.Do(s_GCAM_key_a);
+  p.Do(s_GCAM_key_b);
+  p.Do(s_GCAM_key_c);
+
+  p.DoArray(s_firmware);
+  p.DoArray(s_media_buffer);
+  p.DoArray(s_network_command_buffer);
+  p.DoArray(s_network_buffer);
+
+  // The DIMM is memory on real hardware, the backup and the network settings persist across
+  // power cycles and stay on disk like memory cards do
+  s_dimm.DoState(p);
+
+  DoNetworkState(p);
+}
 
-  if (s_extra)
-    s_extra->Close();
+void InitReplay(u32 game_type)
+{
+  s_replaying = true;
+  s_replay_game_type = game_type;
 
-  if (s_backup)
-    s_backup->Close();
+  ResetState();
+  LoadFirmware();
+}
 
-  if (s_dimm)
-    s_dimm->Close();
+u32 ReplayCommand(const TraceRecord& record, u8* data)
+{
+  // Same as ExecuteCommand, which sees the command before decryption
+  if (record.offset == 0x00100440)
+    s_segaboot = 1;
+  if (record.flags & TRACE_TEST_MODE)
+    s_firmwaremap = 1;
 
-  if (s_dimm_disc)
-  {
-    delete[] s_dimm_disc;
-    s_dimm_disc = nullptr;
-  }
+  return ExecuteDecryptedCommand(Core::System::GetInstance(), record.command, record.offset,
+                                 record.address, record.length, data);
+}
+
+bool ReplayNetworkReply(std::span<u8> payload)
+{
+  NetworkReply reply;
+  u8* ptr = payload.data();
+  PointerWrap p(&ptr, payload.size(), PointerWrap::Mode::Read);
+  reply.DoState(p);
+  if (!p.IsReadMode())
+    return false;
+
+  CompleteNetworkCommand(reply);
+  return true;
+}
+
+void ShutdownReplay()
+{
+  ShutdownDIMM();
+  s_replaying = false;
+}
+
+void Shutdown(void)
+{
+  ShutdownNetwork();
+  s_trace.Close();
+
+  s_read_regions.LogCounters("Read");
+  s_write_regions.LogCounters("Write");
+
+  s_netcfg.Close();
+  s_netctrl.Close();
+  s_extra.Close();
+  s_backup.Close();
+  s_dimm.Close();
+
+  ShutdownDIMM();
 }
 
 }  // namespace AMMediaboard
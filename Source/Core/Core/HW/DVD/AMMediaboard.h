@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,11 @@ namespace Core
 class System;
 }
 
+namespace DiscIO
+{
+class VolumeDisc;
+}
+
 namespace File
 {
 class IOFile;
@@ -43,6 +49,8 @@ enum MediaType
 
 namespace AMMediaboard
 {
+struct TraceRecord;
+
 enum class AMMBCommand : u16
 {
   Unknown_000 = 0x000,
@@ -145,10 +153,21 @@ enum SocketStatusCodes
 
 void Init(void);
 void FirmwareMap(bool on);
-u8* InitDIMM(void);
+void InitDIMM(const DiscIO::VolumeDisc& volume);
 void InitKeys(u32 KeyA, u32 KeyB, u32 KeyC);
 u32 ExecuteCommand(std::array<u32, 3>& DICMDBUF, u32 Address, u32 Length);
 u32 GetGameType(void);
 u32 GetMediaType(void);
+void FlushFiles();
+void DoState(PointerWrap& p);
 void Shutdown(void);
+
+// Runs the media board on its own to replay a command trace, see AMCommandTrace.h. There is no
+// emulated console and no network, socket commands are completed by the replies in the trace.
+void InitReplay(u32 game_type);
+// data is the DMA buffer, it must hold record.length bytes
+u32 ReplayCommand(const TraceRecord& record, u8* data);
+// Returns false if the payload isn't a valid reply
+bool ReplayNetworkReply(std::span<u8> payload);
+void ShutdownReplay();
 };  // namespace AMMediaboard
@@ -0,0 +1,850 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMNetwork.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Common/ChunkFile.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/HW/DVD/AMNetworkTransport.h"
+#include "Core/IOS/Network/Socket.h"
+
+namespace AMMediaboard
+{
+using Clock = std::chrono::steady_clock;
+
+// How often the network thread looks for new requests while it is waiting on sockets
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(5);
+
+// Accept and Connect used to wait this long on the CPU thread before reporting EWOULDBLOCK
+constexpr auto ACCEPT_TIMEOUT = std::chrono::microseconds(200);
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(1);
+
+// Guest descriptor NAMCAM hardcodes for select, see Select below
+constexpr u32 NAMCO_CAM_DESCRIPTOR = 0x100;
+
+// Result the guest expects from a failed socket call
+constexpr s32 GUEST_SOCKET_ERROR = -1;
+
+struct PendingOperation
+{
+  NetworkRequest request;
+  NetworkReply reply;
+  TransportHandle fd = INVALID_TRANSPORT_HANDLE;
+  // TRANSPORT_* events to wait for, 0 if the operation only waits for its deadline
+  u32 events = 0;
+  std::optional<Clock::time_point> deadline;
+  bool started = false;
+  // Bytes sent so far by Send
+  size_t progress = 0;
+};
+
+struct SocketAddress
+{
+  // Both in network byte order
+  u32 address = 0;
+  u16 port = 0;
+};
+
+// What the guest did with a socket, so that it can be recreated after loading a state
+struct SocketInfo
+{
+  bool open = false;
+  s32 af = 0;
+  s32 type = 0;
+  // Connections accepted from a listening socket can't be recreated
+  bool accepted = false;
+  std::optional<SocketAddress> bound;
+  std::optional<u32> backlog;
+  std::optional<SocketAddress> peer;
+};
+
+// What goes into a savestate
+struct NetworkState
+{
+  std::array<SocketInfo, 64> socket_info;
+  u32 namco_cam = 0;
+  std::array<u32, 3> timeouts{};
+  // Commands that haven't been run yet, and replies that haven't been picked up
+  std::vector<NetworkRequest> requests;
+  std::vector<NetworkReply> replies;
+};
+
+static std::thread s_network_thread;
+static Common::Flag s_network_thread_stop;
+static Common::Event s_request_event;
+
+static std::mutex s_request_lock;
+static std::deque<NetworkRequest> s_requests;
+static std::mutex s_reply_lock;
+static std::deque<NetworkReply> s_replies;
+static std::atomic<u32> s_requests_in_flight = 0;
+
+// Saving a state takes a measuring pass and a writing pass, which have to see the same state even
+// though the network thread keeps running in between. The first pass keeps what it saved here.
+static std::optional<NetworkState> s_saved_state;
+
+// Held by the network thread while it works on the state below, but not while it waits. Lets
+// the CPU thread take a consistent copy for a savestate.
+static std::mutex s_state_lock;
+
+// Everything below is only touched by the network thread while it is running, or with
+// s_state_lock held
+
+static std::unique_ptr<NetworkTransport> s_transport;
+
+// Sockets FDs are required to go from 0 to 63
+// Games use the FD as indexes so we have to workaround it.
+static std::array<TransportHandle, 64> s_sockets;
+static std::array<SocketInfo, 64> s_socket_info;
+static u32 s_namco_cam = 0;
+static u32 s_timeouts[3] = {20000, 20000, 20000};
+
+// Operations waiting on their socket or their timeout
+static std::vector<PendingOperation> s_pending;
+
+static TransportHandle GetSocket(u32 guest_fd)
+{
+  return s_sockets[SocketCheck(guest_fd)];
+}
+
+static std::optional<Clock::time_point> GetDeadline(u32 timeout_ms)
+{
+  // A timeout of zero blocks forever
+  if (timeout_ms == 0)
+    return std::nullopt;
+  return Clock::now() + std::chrono::milliseconds(timeout_ms);
+}
+
+static s32 AllocateSocket(TransportHandle fd, s32 af, s32 type, bool accepted)
+{
+  for (u32 i = 1; i < s_sockets.size(); ++i)
+  {
+    if (s_sockets[i] == INVALID_TRANSPORT_HANDLE)
+    {
+      s_sockets[i] = fd;
+      s_socket_info[i] = {};
+      s_socket_info[i].open = true;
+      s_socket_info[i].af = af;
+      s_socket_info[i].type = type;
+      s_socket_info[i].accepted = accepted;
+      return i;
+    }
+  }
+
+  // Out of sockets
+  s_transport->Close(fd);
+  return GUEST_SOCKET_ERROR;
+}
+
+// The localhost rewrites for hardcoded device IPs are up to the transport, only the guest
+// side bookkeeping happens here
+void NetworkRequest::DoState(PointerWrap& p)
+{
+  p.Do(command);
+  p.DoArray(params);
+  p.Do(data);
+}
+
+void NetworkReply::DoState(PointerWrap& p)
+{
+  p.Do(command);
+  p.DoArray(params);
+  p.Do(result);
+  p.Do(last_error);
+  p.Do(host_fd);
+  p.Do(readable);
+  p.Do(writable);
+  p.Do(data);
+}
+
+static void TranslateConnectAddress(sockaddr_in* addr, u32 guest_fd)
+{
+  // NAMCO Camera ( IPs are: 192.168.29.104-108 )
+  if ((addr->sin_addr.s_addr & 0xFFFFFF00) == 0xC0A81D00)
+  {
+    addr->sin_family = htons(AF_INET);  // fix family?
+    s_namco_cam = guest_fd;
+  }
+
+  addr->sin_family = Common::swap16(addr->sin_family);
+}
+
+static sockaddr_in GetConnectAddress(const NetworkRequest& request)
+{
+  sockaddr_in addr{};
+  std::memcpy(&addr, request.data.data(), std::min(request.data.size(), sizeof(addr)));
+  TranslateConnectAddress(&addr, request.params[0]);
+  return addr;
+}
+
+static void SetConnected(const NetworkRequest& request)
+{
+  const sockaddr_in addr = GetConnectAddress(request);
+  s_socket_info[SocketCheck(request.params[0])].peer =
+      SocketAddress{addr.sin_addr.s_addr, addr.sin_port};
+}
+
+static bool Accept(PendingOperation& op, bool timed_out)
+{
+  const bool want_address = op.request.data.size() >= sizeof(int);
+
+  sockaddr_in addr{};
+  const TransportResult ret = s_transport->Accept(op.fd, &addr);
+  if (ret.status != TransportStatus::Success)
+  {
+    if (ret.status == TransportStatus::Failure)
+    {
+      op.reply.result = GUEST_SOCKET_ERROR;
+      return true;
+    }
+
+    if (timed_out)
+    {
+      op.reply.result = GUEST_SOCKET_ERROR;
+      op.reply.last_error = SSC_EWOULDBLOCK;
+      return true;
+    }
+
+    op.events = TRANSPORT_READABLE;
+    if (!op.deadline)
+      op.deadline = Clock::now() + ACCEPT_TIMEOUT;
+    return false;
+  }
+
+  const SocketInfo& listener = s_socket_info[SocketCheck(op.request.params[0])];
+  op.reply.result = AllocateSocket(ret.value, listener.af, listener.type, true);
+  op.reply.last_error = SSC_SUCCESS;
+
+  if (want_address)
+  {
+    int len;
+    std::memcpy(&len, op.request.data.data(), sizeof(len));
+    len = std::clamp<int>(len, 0, sizeof(addr));
+
+    op.reply.data.resize(len + sizeof(len));
+    std::memcpy(op.reply.data.data(), &addr, len);
+    std::memcpy(op.reply.data.data() + len, &len, sizeof(len));
+  }
+
+  return true;
+}
+
+static bool Connect(PendingOperation& op, bool timed_out)
+{
+  if (!op.started)
+  {
+    op.started = true;
+
+    const sockaddr_in addr = GetConnectAddress(op.request);
+    const TransportResult ret = s_transport->Connect(op.fd, addr);
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: connect( {}, ({},{}:{}), {} ):{} ({})\n", op.fd,
+                   addr.sin_family, inet_ntoa(addr.sin_addr), Common::swap16(addr.sin_port),
+                   op.request.params[2], static_cast<int>(ret.status),
+                   s_transport->GetLastError());
+
+    if (ret.status == TransportStatus::Success)
+    {
+      SetConnected(op.request);
+      op.reply.result = 0;
+      op.reply.last_error = SSC_SUCCESS;
+      return true;
+    }
+
+    if (ret.status == TransportStatus::Failure)
+    {
+      op.reply.result = GUEST_SOCKET_ERROR;
+      return true;
+    }
+
+    op.events = TRANSPORT_WRITABLE;
+    op.deadline = Clock::now() + CONNECT_TIMEOUT;
+    return false;
+  }
+
+  const TransportResult ret = s_transport->GetConnectResult(op.fd);
+  if (ret.status != TransportStatus::WouldBlock)
+  {
+    const bool success = ret.status == TransportStatus::Success;
+    if (success)
+      SetConnected(op.request);
+    op.reply.result = success ? 0 : GUEST_SOCKET_ERROR;
+    op.reply.last_error = success ? SSC_SUCCESS : SSC_ECONNREFUSED;
+    return true;
+  }
+
+  if (timed_out)
+  {
+    op.reply.result = GUEST_SOCKET_ERROR;
+    op.reply.last_error = SSC_EWOULDBLOCK;
+    return true;
+  }
+
+  return false;
+}
+
+static bool Recv(PendingOperation& op, bool timed_out)
+{
+  const u32 len = op.request.params[2];
+  op.reply.data.resize(len);
+
+  const TransportResult ret = s_transport->Recv(op.fd, op.reply.data.data(), len);
+  if (ret.status == TransportStatus::WouldBlock && !timed_out)
+  {
+    op.events = TRANSPORT_READABLE;
+    if (!op.started)
+      op.deadline = GetDeadline(s_timeouts[2]);
+    op.started = true;
+    return false;
+  }
+
+  const s32 result =
+      ret.status == TransportStatus::Success ? static_cast<s32>(ret.value) : GUEST_SOCKET_ERROR;
+  op.reply.data.resize(std::max(result, 0));
+  op.reply.result = result;
+
+  NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: recv( {}, 0x{:08x}, {} ):{}\n", op.fd,
+                 op.request.params[1], len, result);
+  return true;
+}
+
+static bool Send(PendingOperation& op, bool timed_out)
+{
+  const std::vector<u8>& data = op.request.data;
+
+  while (op.progress < data.size())
+  {
+    const TransportResult ret = s_transport->Send(op.fd, data.data() + op.progress,
+                                                  static_cast<u32>(data.size() - op.progress));
+    if (ret.status != TransportStatus::Success)
+    {
+      if (ret.status == TransportStatus::Failure || timed_out)
+      {
+        op.reply.result = op.progress != 0 ? static_cast<s32>(op.progress) : GUEST_SOCKET_ERROR;
+        return true;
+      }
+
+      op.events = TRANSPORT_WRITABLE;
+      if (!op.started)
+        op.deadline = GetDeadline(s_timeouts[1]);
+      op.started = true;
+      return false;
+    }
+
+    op.progress += ret.value;
+  }
+
+  op.reply.result = static_cast<s32>(op.progress);
+
+  NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: send( {}({}), 0x{:08x}, {} ): {}\n", op.fd,
+                 op.request.params[0], op.request.params[1], data.size(), op.reply.result);
+  return true;
+}
+
+static bool Select(PendingOperation& op, bool timed_out)
+{
+  const bool want_read = op.request.params[1] != 0;
+  const bool want_write = op.request.params[2] != 0;
+
+  if (!op.started)
+  {
+    op.started = true;
+
+    /*
+      BUG: NAMCAM is hardcoded to call this with socket ID 0x100 which might be some magic
+      thing? Winsocks expects a valid socket so we take the socket from the connect.
+    */
+    if (op.request.params[0] == NAMCO_CAM_DESCRIPTOR)
+      op.fd = GetSocket(s_namco_cam);
+
+    u32 timeout_ms = s_timeouts[0];
+    if (op.request.data.size() >= sizeof(timeval))
+    {
+      timeval timeout;
+      std::memcpy(&timeout, op.request.data.data(), sizeof(timeout));
+      timeout_ms = static_cast<u32>(timeout.tv_sec * 1000 + timeout.tv_usec / 1000);
+    }
+
+    if (want_read)
+      op.events |= TRANSPORT_READABLE;
+    if (want_write)
+      op.events |= TRANSPORT_WRITABLE;
+    op.deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    op.reply.host_fd = static_cast<s32>(op.fd);
+  }
+
+  if (op.events != 0 && op.fd != INVALID_TRANSPORT_HANDLE)
+  {
+    const u32 ready = s_transport->GetReadiness(op.fd, op.events);
+    op.reply.readable = (ready & TRANSPORT_READABLE) != 0;
+    op.reply.writable = (ready & TRANSPORT_WRITABLE) != 0;
+  }
+
+  if (!op.reply.readable && !op.reply.writable && !timed_out)
+    return false;
+
+  op.reply.result = op.reply.readable + op.reply.writable;
+
+  NOTICE_LOG_FMT(DVDINTERFACE,
+                 "GC-AM: select( {}({}), 0x{:08x} 0x{:08x} 0x{:08x} 0x{:08x} ):{} \n", op.fd,
+                 op.request.params[0], op.request.params[1], op.request.params[2],
+                 op.request.params[3], op.request.params[4], op.reply.result);
+  return true;
+}
+
+// Runs an operation for as long as it can without blocking.
+// Returns true once the operation has completed and its reply is ready.
+static bool RunOperation(PendingOperation& op, bool timed_out)
+{
+  NetworkReply& reply = op.reply;
+  const std::array<u32, 5>& params = op.request.params;
+
+  switch (op.request.command)
+  {
+  case AMMBCommand::Accept:
+    return Accept(op, timed_out);
+  case AMMBCommand::Connect:
+    return Connect(op, timed_out);
+  case AMMBCommand::Recv:
+    return Recv(op, timed_out);
+  case AMMBCommand::Send:
+    return Send(op, timed_out);
+  case AMMBCommand::Select:
+    return Select(op, timed_out);
+  case AMMBCommand::Bind:
+  {
+    sockaddr_in addr{};
+    std::memcpy(&addr, op.request.data.data(), std::min(op.request.data.size(), sizeof(addr)));
+
+    addr.sin_family = Common::swap16(addr.sin_family);
+
+    /*
+      Triforce games usually use hardcoded IPs
+      This is replaced to listen to the ANY address instead
+    */
+    addr.sin_addr.s_addr = INADDR_ANY;
+
+    reply.result = s_transport->Bind(op.fd, addr);
+    reply.last_error = SSC_SUCCESS;
+    if (reply.result == 0)
+    {
+      s_socket_info[SocketCheck(params[0])].bound =
+          SocketAddress{addr.sin_addr.s_addr, addr.sin_port};
+    }
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: bind( {}, ({},{:08x}:{}), {} ):{} ({})\n", op.fd,
+                   addr.sin_family, addr.sin_addr.s_addr, Common::swap16(addr.sin_port), params[2],
+                   reply.result, s_transport->GetLastError());
+    return true;
+  }
+  case AMMBCommand::Closesocket:
+  {
+    reply.result = s_transport->Close(op.fd);
+    reply.last_error = SSC_SUCCESS;
+    s_sockets[SocketCheck(params[0])] = INVALID_TRANSPORT_HANDLE;
+    s_socket_info[SocketCheck(params[0])] = {};
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: closesocket( {}({}) ):{}\n", op.fd, params[0],
+                   reply.result);
+    return true;
+  }
+  case AMMBCommand::Listen:
+  {
+    reply.result = s_transport->Listen(op.fd, params[1]);
+    if (reply.result == 0)
+      s_socket_info[SocketCheck(params[0])].backlog = params[1];
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: listen( {}, {} ):{:d}\n", op.fd, params[1],
+                   reply.result);
+    return true;
+  }
+  case AMMBCommand::Socket:
+  {
+    // Protocol is not sent
+    const TransportHandle fd = s_transport->Socket(params[0], params[1]);
+    reply.result = fd == INVALID_TRANSPORT_HANDLE ?
+                       GUEST_SOCKET_ERROR :
+                       AllocateSocket(fd, params[0], params[1], false);
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: socket( {}, {}, 6 ):{}\n", params[0], params[1],
+                   reply.result);
+    return true;
+  }
+  case AMMBCommand::SetSockOpt:
+  {
+    reply.result =
+        s_transport->SetSockOpt(op.fd, static_cast<int>(params[1]), static_cast<int>(params[2]),
+                                op.request.data.data(), static_cast<u32>(op.request.data.size()));
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: setsockopt( {:d}, {:04x}, {}, {} ):{:d} ({})\n", op.fd,
+                   params[1], params[2], op.request.data.size(), reply.result,
+                   s_transport->GetLastError());
+    return true;
+  }
+  case AMMBCommand::SetTimeOuts:
+  {
+    // Sockets are non-blocking, the timeouts are applied by the network thread instead
+    s_timeouts[0] = params[1];
+    s_timeouts[1] = params[2];
+    s_timeouts[2] = params[3];
+    reply.result = 0;
+
+    NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: SetTimeOuts( {}, {}, {}, {} )\n", op.fd, params[1],
+                   params[2], params[3]);
+    return true;
+  }
+  default:
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Unhandled network command:{:03X}",
+                  static_cast<u16>(op.request.command));
+    return true;
+  }
+}
+
+static void PushReply(NetworkReply reply)
+{
+  std::lock_guard lk(s_reply_lock);
+  s_replies.push_back(std::move(reply));
+}
+
+static void NetworkThread()
+{
+  Common::SetCurrentThreadName("AM Network");
+
+  std::vector<TransportWaitEntry> wait_entries;
+
+  while (!s_network_thread_stop.IsSet())
+  {
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(POLL_INTERVAL);
+    bool idle;
+    {
+      std::lock_guard state_lk(s_state_lock);
+
+      std::deque<NetworkRequest> requests;
+      {
+        std::lock_guard lk(s_request_lock);
+        requests.swap(s_requests);
+      }
+
+      for (NetworkRequest& request : requests)
+      {
+        PendingOperation op;
+        op.request = std::move(request);
+        op.reply.command = op.request.command;
+        op.reply.params = op.request.params;
+        op.fd = GetSocket(op.request.params[0]);
+        op.reply.host_fd = static_cast<s32>(op.fd);
+
+        if (RunOperation(op, false))
+          PushReply(std::move(op.reply));
+        else
+          s_pending.push_back(std::move(op));
+      }
+
+      const auto now = Clock::now();
+      wait_entries.clear();
+      for (const PendingOperation& op : s_pending)
+      {
+        if (op.events != 0 && op.fd != INVALID_TRANSPORT_HANDLE)
+          wait_entries.push_back({op.fd, op.events});
+
+        if (op.deadline)
+        {
+          timeout = std::min(timeout, std::max(std::chrono::milliseconds(0),
+                                               std::chrono::ceil<std::chrono::milliseconds>(
+                                                   *op.deadline - now)));
+        }
+      }
+
+      idle = s_pending.empty();
+    }
+
+    if (idle)
+    {
+      s_request_event.Wait();
+      continue;
+    }
+
+    if (wait_entries.empty())
+      s_request_event.WaitFor(timeout);
+    else
+      s_transport->Wait(wait_entries, timeout);
+
+    std::lock_guard state_lk(s_state_lock);
+    const auto now = Clock::now();
+    for (auto it = s_pending.begin(); it != s_pending.end();)
+    {
+      const bool timed_out = it->deadline && now >= *it->deadline;
+      if (RunOperation(*it, timed_out))
+      {
+        PushReply(std::move(it->reply));
+        it = s_pending.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+}
+
+static void StartNetworkThread()
+{
+  s_network_thread_stop.Clear();
+  s_network_thread = std::thread(NetworkThread);
+}
+
+static void StopNetworkThread()
+{
+  s_network_thread_stop.Set();
+  s_request_event.Set();
+  s_network_thread.join();
+}
+
+static void CloseSockets()
+{
+  for (TransportHandle& fd : s_sockets)
+  {
+    if (fd != INVALID_TRANSPORT_HANDLE)
+      s_transport->Close(fd);
+    fd = INVALID_TRANSPORT_HANDLE;
+  }
+  s_socket_info.fill({});
+}
+
+static sockaddr_in ToSockaddr(const SocketAddress& address)
+{
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = address.address;
+  addr.sin_port = address.port;
+  return addr;
+}
+
+// Recreates a socket the guest had open when the state was saved. Connections to other machines
+// are dialed again, connections the guest accepted are lost and show up as errors on their
+// next use.
+static void ReattachSocket(u32 guest_fd, const SocketInfo& info)
+{
+  const TransportHandle fd = s_transport->Socket(info.af, info.type);
+  if (fd == INVALID_TRANSPORT_HANDLE)
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to recreate socket {}", guest_fd);
+    return;
+  }
+
+  s_sockets[guest_fd] = fd;
+  s_socket_info[guest_fd] = info;
+
+  if (info.bound && s_transport->Bind(fd, ToSockaddr(*info.bound)) != 0)
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to rebind socket {}", guest_fd);
+  if (info.backlog && s_transport->Listen(fd, *info.backlog) != 0)
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to listen on socket {} again", guest_fd);
+  if (info.peer)
+    s_transport->Connect(fd, ToSockaddr(*info.peer));
+
+  NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: Recreated socket {}{}", guest_fd,
+                 info.accepted ? " (accepted connection, not reconnected)" : "");
+}
+
+static void DoState(PointerWrap& p, SocketInfo& info)
+{
+  p.Do(info.open);
+  p.Do(info.af);
+  p.Do(info.type);
+  p.Do(info.accepted);
+  p.Do(info.bound);
+  p.Do(info.backlog);
+  p.Do(info.peer);
+}
+
+void InitNetwork()
+{
+  ShutdownNetwork();
+
+  s_transport = CreateNetworkTransport();
+  s_sockets.fill(INVALID_TRANSPORT_HANDLE);
+  s_socket_info.fill({});
+  s_namco_cam = 0;
+  std::fill(std::begin(s_timeouts), std::end(s_timeouts), 20000);
+
+  StartNetworkThread();
+}
+
+void ShutdownNetwork()
+{
+  if (!s_network_thread.joinable())
+    return;
+
+  StopNetworkThread();
+
+  CloseSockets();
+  s_transport.reset();
+
+  s_pending.clear();
+  {
+    std::lock_guard lk(s_request_lock);
+    s_requests.clear();
+  }
+  {
+    std::lock_guard lk(s_reply_lock);
+    s_replies.clear();
+  }
+  s_requests_in_flight = 0;
+  s_saved_state.reset();
+}
+
+// Host sockets can't be saved, so the state holds what the guest did with them instead.
+// Commands that haven't been run yet are saved as requests and run once the state is loaded.
+static NetworkState SaveNetworkState()
+{
+  NetworkState state;
+
+  std::lock_guard state_lk(s_state_lock);
+  state.socket_info = s_socket_info;
+  state.namco_cam = s_namco_cam;
+  std::copy(std::begin(s_timeouts), std::end(s_timeouts), state.timeouts.begin());
+
+  {
+    std::lock_guard reply_lk(s_reply_lock);
+    state.replies.assign(s_replies.begin(), s_replies.end());
+  }
+
+  for (const PendingOperation& op : s_pending)
+  {
+    // A send that has started may have sent part of its data already, so it can't be run again.
+    // It is saved as done with what it sent so far, the same as if it had timed out.
+    if (op.request.command == AMMBCommand::Send && op.started)
+    {
+      NetworkReply reply = op.reply;
+      reply.result = op.progress != 0 ? static_cast<s32>(op.progress) : GUEST_SOCKET_ERROR;
+      state.replies.push_back(std::move(reply));
+    }
+    else
+    {
+      state.requests.push_back(op.request);
+    }
+  }
+
+  std::lock_guard request_lk(s_request_lock);
+  state.requests.insert(state.requests.end(), s_requests.begin(), s_requests.end());
+
+  return state;
+}
+
+static void LoadNetworkState(NetworkState state)
+{
+  const bool running = s_network_thread.joinable();
+  if (running)
+    StopNetworkThread();
+
+  CloseSockets();
+  s_pending.clear();
+  s_namco_cam = state.namco_cam;
+  std::copy(state.timeouts.begin(), state.timeouts.end(), std::begin(s_timeouts));
+
+  // Without the network thread, as when replaying a command trace, there's nothing to run the
+  // requests or recreate the sockets with
+  if (running)
+  {
+    for (u32 i = 0; i < state.socket_info.size(); ++i)
+    {
+      if (state.socket_info[i].open)
+        ReattachSocket(i, state.socket_info[i]);
+    }
+  }
+  else
+  {
+    state.requests.clear();
+  }
+
+  s_requests_in_flight = static_cast<u32>(state.requests.size() + state.replies.size());
+  {
+    std::lock_guard lk(s_request_lock);
+    s_requests.assign(std::make_move_iterator(state.requests.begin()),
+                      std::make_move_iterator(state.requests.end()));
+  }
+  {
+    std::lock_guard lk(s_reply_lock);
+    s_replies.assign(std::make_move_iterator(state.replies.begin()),
+                     std::make_move_iterator(state.replies.end()));
+  }
+
+  if (running)
+    StartNetworkThread();
+}
+
+static void DoState(PointerWrap& p, NetworkState& state)
+{
+  for (SocketInfo& info : state.socket_info)
+    DoState(p, info);
+
+  p.Do(state.namco_cam);
+  p.DoArray(state.timeouts);
+
+  p.DoEachElement(state.requests, [](PointerWrap& p_, NetworkRequest& r) { r.DoState(p_); });
+  p.DoEachElement(state.replies, [](PointerWrap& p_, NetworkReply& r) { r.DoState(p_); });
+}
+
+void DoNetworkState(PointerWrap& p)
+{
+  if (p.IsReadMode())
+  {
+    s_saved_state.reset();
+
+    NetworkState state;
+    DoState(p, state);
+    if (p.IsReadMode())
+      LoadNetworkState(std::move(state));
+    return;
+  }
+
+  if (p.IsMeasureMode() || !s_saved_state)
+    s_saved_state = SaveNetworkState();
+
+  DoState(p, *s_saved_state);
+
+  if (p.IsWriteMode())
+    s_saved_state.reset();
+}
+
+void SubmitNetworkRequest(NetworkRequest request)
+{
+  ++s_requests_in_flight;
+  {
+    std::lock_guard lk(s_request_lock);
+    s_requests.push_back(std::move(request));
+  }
+  s_request_event.Set();
+}
+
+std::optional<NetworkReply> PopNetworkReply()
+{
+  std::lock_guard lk(s_reply_lock);
+  if (s_replies.empty())
+    return std::nullopt;
+
+  NetworkReply reply = std::move(s_replies.front());
+  s_replies.pop_front();
+  --s_requests_in_flight;
+  return reply;
+}
+
+bool IsNetworkBusy()
+{
+  return s_requests_in_flight != 0;
+}
+}  // namespace AMMediaboard
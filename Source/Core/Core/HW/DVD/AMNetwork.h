@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DVD/AMMediaboard.h"
+
+class PointerWrap;
+
+namespace AMMediaboard
+{
+// A socket command issued by the guest. Guest buffers the command reads from are copied into
+// data, so the network thread never touches emulated memory.
+struct NetworkRequest
+{
+  AMMBCommand command = AMMBCommand::Unknown_000;
+  // Command parameters, starting at the socket descriptor
+  std::array<u32, 5> params{};
+  // sockaddr for Bind/Connect, address length for Accept, option value for SetSockOpt,
+  // timeout for Select and payload for Send
+  std::vector<u8> data;
+
+  void DoState(PointerWrap& p);
+};
+
+struct NetworkReply
+{
+  AMMBCommand command = AMMBCommand::Unknown_000;
+  std::array<u32, 5> params{};
+  s32 result = 0;
+  // Only set by commands that update the value returned by GetLastError
+  std::optional<u32> last_error;
+  // Host socket the command ran on, for logging and for Select's descriptor sets
+  s32 host_fd = -1;
+  bool readable = false;
+  bool writable = false;
+  // Peer sockaddr followed by its length for Accept, payload for Recv
+  std::vector<u8> data;
+
+  void DoState(PointerWrap& p);
+};
+
+// The network thread owns the guest socket table and completes socket commands without ever
+// blocking the CPU thread. Replies are picked up by the media board on the CPU thread.
+void InitNetwork();
+void ShutdownNetwork();
+void SubmitNetworkRequest(NetworkRequest request);
+std::optional<NetworkReply> PopNetworkReply();
+bool IsNetworkBusy();
+void DoNetworkState(PointerWrap& p);
+}  // namespace AMMediaboard
@@ -0,0 +1,233 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMNetworkTransport.h"
+
+#include <string>
+#include <vector>
+
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/DVD/AMVirtualLAN.h"
+#include "Core/IOS/Network/Socket.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+
+#define closesocket close
+#define ioctlsocket ioctl
+
+#define SOCKET_ERROR (-1)
+
+typedef int SOCKET;
+#endif
+
+namespace AMMediaboard
+{
+namespace
+{
+int GetLastSocketError()
+{
+#ifdef _WIN32
+  return WSAGetLastError();
+#else
+  return errno;
+#endif
+}
+
+bool IsWouldBlock(int err)
+{
+#ifdef _WIN32
+  return err == WSAEWOULDBLOCK;
+#else
+  return err == EWOULDBLOCK || err == EAGAIN || err == EINPROGRESS;
+#endif
+}
+
+short ToPollEvents(u32 events)
+{
+  return ((events & TRANSPORT_READABLE) ? POLLIN : 0) |
+         ((events & TRANSPORT_WRITABLE) ? POLLOUT : 0);
+}
+
+class HostTransport final : public NetworkTransport
+{
+public:
+  TransportHandle Socket(int af, int type) override
+  {
+    const SOCKET fd = socket(af, type, IPPROTO_TCP);
+    if (fd == SOCKET_ERROR)
+      return INVALID_TRANSPORT_HANDLE;
+
+    SetNonBlocking(fd);
+    return static_cast<TransportHandle>(fd);
+  }
+
+  int Bind(TransportHandle handle, const sockaddr_in& addr) override
+  {
+    return bind(ToSocket(handle), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+  }
+
+  int Listen(TransportHandle handle, int backlog) override
+  {
+    return listen(ToSocket(handle), backlog);
+  }
+
+  TransportResult Accept(TransportHandle handle, sockaddr_in* peer) override
+  {
+    socklen_t len = sizeof(sockaddr_in);
+    const SOCKET fd = accept(ToSocket(handle), reinterpret_cast<sockaddr*>(peer), &len);
+    if (fd == SOCKET_ERROR)
+      return FailedResult();
+
+    SetNonBlocking(fd);
+    return {TransportStatus::Success, static_cast<s64>(fd)};
+  }
+
+  TransportResult Connect(TransportHandle handle, const sockaddr_in& addr) override
+  {
+    sockaddr_in host_addr = addr;
+    RewriteAddress(&host_addr);
+
+    if (connect(ToSocket(handle), reinterpret_cast<const sockaddr*>(&host_addr),
+                sizeof(host_addr)) == SOCKET_ERROR)
+    {
+      return FailedResult();
+    }
+    return {TransportStatus::Success, 0};
+  }
+
+  TransportResult GetConnectResult(TransportHandle handle) override
+  {
+    if (GetReadiness(handle, TRANSPORT_WRITABLE) == 0)
+      return {TransportStatus::WouldBlock, 0};
+
+    int err = 0;
+    socklen_t err_len = sizeof(err);
+    getsockopt(ToSocket(handle), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &err_len);
+    return {err == 0 ? TransportStatus::Success : TransportStatus::Failure, 0};
+  }
+
+  TransportResult Recv(TransportHandle handle, u8* data, u32 length) override
+  {
+    const int ret = recv(ToSocket(handle), reinterpret_cast<char*>(data), length, 0);
+    if (ret == SOCKET_ERROR)
+      return FailedResult();
+    return {TransportStatus::Success, ret};
+  }
+
+  TransportResult Send(TransportHandle handle, const u8* data, u32 length) override
+  {
+    const int ret = send(ToSocket(handle), reinterpret_cast<const char*>(data), length, 0);
+    if (ret == SOCKET_ERROR)
+      return FailedResult();
+    return {TransportStatus::Success, ret};
+  }
+
+  int SetSockOpt(TransportHandle handle, int level, int name, const u8* value,
+                 u32 length) override
+  {
+    return setsockopt(ToSocket(handle), level, name, reinterpret_cast<const char*>(value),
+                      length);
+  }
+
+  int Close(TransportHandle handle) override { return closesocket(ToSocket(handle)); }
+
+  u32 GetReadiness(TransportHandle handle, u32 events) override
+  {
+    pollfd_t pfd{};
+    pfd.fd = ToSocket(handle);
+    pfd.events = ToPollEvents(events);
+    if (poll(&pfd, 1, 0) <= 0)
+      return 0;
+
+    // Errors and hangups are reported as readiness so the next call picks them up
+    u32 ready = 0;
+    if (pfd.revents & (POLLIN | POLLHUP | POLLERR))
+      ready |= TRANSPORT_READABLE;
+    if (pfd.revents & (POLLOUT | POLLERR))
+      ready |= TRANSPORT_WRITABLE;
+    return ready & events;
+  }
+
+  void Wait(std::span<const TransportWaitEntry> entries,
+            std::chrono::milliseconds timeout) override
+  {
+    m_poll_fds.clear();
+    for (const TransportWaitEntry& entry : entries)
+    {
+      pollfd_t pfd{};
+      pfd.fd = ToSocket(entry.handle);
+      pfd.events = ToPollEvents(entry.events);
+      m_poll_fds.push_back(pfd);
+    }
+
+    poll(m_poll_fds.data(), static_cast<u32>(m_poll_fds.size()),
+         static_cast<int>(timeout.count()));
+  }
+
+  int GetLastError() const override { return m_last_error; }
+
+private:
+  static SOCKET ToSocket(TransportHandle handle) { return static_cast<SOCKET>(handle); }
+
+  static void SetNonBlocking(SOCKET fd)
+  {
+    u_long val = 1;
+    ioctlsocket(fd, FIONBIO, &val);
+  }
+
+  // Triforce games use hardcoded IPs for devices that we expect on the local machine
+  static void RewriteAddress(sockaddr_in* addr)
+  {
+    // CyCraft Connect IP, change to localhost
+    if (addr->sin_addr.s_addr == inet_addr("192.168.11.111"))
+    {
+      addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+    }
+
+    // NAMCO Camera ( IPs are: 192.168.29.104-108 )
+    if ((addr->sin_addr.s_addr & 0xFFFFFF00) == 0xC0A81D00)
+    {
+      addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+    }
+
+    // Key of Avalon Client
+    if (addr->sin_addr.s_addr == inet_addr("192.168.13.1"))
+    {
+      addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+    }
+  }
+
+  TransportResult FailedResult()
+  {
+    m_last_error = GetLastSocketError();
+    return {IsWouldBlock(m_last_error) ? TransportStatus::WouldBlock : TransportStatus::Failure,
+            0};
+  }
+
+  int m_last_error = 0;
+  std::vector<pollfd_t> m_poll_fds;
+};
+}  // namespace
+
+std::unique_ptr<NetworkTransport> CreateHostTransport()
+{
+  return std::make_unique<HostTransport>();
+}
+
+std::unique_ptr<NetworkTransport> CreateNetworkTransport()
+{
+  if (Config::Get(Config::MAIN_TRIFORCE_VIRTUAL_LAN))
+  {
+    const std::string virtual_ip = Config::Get(Config::MAIN_TRIFORCE_VIRTUAL_LAN_IP);
+    if (auto transport = CreateVirtualLANTransport(virtual_ip))
+      return transport;
+
+    ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Virtual LAN unavailable, falling back to host sockets");
+  }
+
+  return CreateHostTransport();
+}
+}  // namespace AMMediaboard
@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <span>
+
+#include "Common/CommonTypes.h"
+
+struct sockaddr_in;
+
+namespace AMMediaboard
+{
+using TransportHandle = s64;
+constexpr TransportHandle INVALID_TRANSPORT_HANDLE = -1;
+
+enum class TransportStatus
+{
+  Success,
+  WouldBlock,
+  Failure,
+};
+
+struct TransportResult
+{
+  TransportStatus status = TransportStatus::Failure;
+  // Bytes transferred, or the new handle for Accept
+  s64 value = 0;
+};
+
+// Readiness flags for GetReadiness and Wait
+enum TransportEvent : u32
+{
+  TRANSPORT_READABLE = 1,
+  TRANSPORT_WRITABLE = 2,
+};
+
+struct TransportWaitEntry
+{
+  TransportHandle handle = INVALID_TRANSPORT_HANDLE;
+  u32 events = 0;
+};
+
+// The stream sockets the media board exposes to the guest. All operations are non-blocking,
+// only Wait blocks. Addresses are passed in host form, with port and address in network order.
+class NetworkTransport
+{
+public:
+  virtual ~NetworkTransport() = default;
+
+  virtual TransportHandle Socket(int af, int type) = 0;
+  virtual int Bind(TransportHandle handle, const sockaddr_in& addr) = 0;
+  virtual int Listen(TransportHandle handle, int backlog) = 0;
+  virtual TransportResult Accept(TransportHandle handle, sockaddr_in* peer) = 0;
+  // WouldBlock means the connection is in progress, see GetConnectResult
+  virtual TransportResult Connect(TransportHandle handle, const sockaddr_in& addr) = 0;
+  virtual TransportResult GetConnectResult(TransportHandle handle) = 0;
+  virtual TransportResult Recv(TransportHandle handle, u8* data, u32 length) = 0;
+  virtual TransportResult Send(TransportHandle handle, const u8* data, u32 length) = 0;
+  virtual int SetSockOpt(TransportHandle handle, int level, int name, const u8* value,
+                         u32 length) = 0;
+  virtual int Close(TransportHandle handle) = 0;
+
+  // Returns the subset of events the handle is ready for
+  virtual u32 GetReadiness(TransportHandle handle, u32 events) = 0;
+  // Blocks until one of the entries is ready or the timeout expires
+  virtual void Wait(std::span<const TransportWaitEntry> entries,
+                    std::chrono::milliseconds timeout) = 0;
+
+  // Last error reported by the host, for logging
+  virtual int GetLastError() const = 0;
+};
+
+// Real sockets on the host network
+std::unique_ptr<NetworkTransport> CreateHostTransport();
+
+// Picks the transport selected in the configuration
+std::unique_ptr<NetworkTransport> CreateNetworkTransport();
+}  // namespace AMMediaboard
@@ -0,0 +1,55 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMTimings.h"
+
+#include <array>
+#include <atomic>
+
+namespace AMTimings
+{
+namespace
+{
+struct Counters
+{
+  std::atomic<u64> calls{0};
+  std::atomic<s64> nanoseconds{0};
+};
+
+std::atomic<bool> s_enabled{false};
+std::array<Counters, static_cast<size_t>(Subsystem::Count)> s_counters;
+}  // namespace
+
+void SetEnabled(bool enabled)
+{
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+void Reset()
+{
+  for (Counters& counters : s_counters)
+  {
+    counters.calls.store(0, std::memory_order_relaxed);
+    counters.nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Add(Subsystem subsystem, std::chrono::nanoseconds time)
+{
+  Counters& counters = s_counters[static_cast<size_t>(subsystem)];
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.nanoseconds.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+Totals GetTotals(Subsystem subsystem)
+{
+  const Counters& counters = s_counters[static_cast<size_t>(subsystem)];
+  return {counters.calls.load(std::memory_order_relaxed),
+          std::chrono::nanoseconds(counters.nanoseconds.load(std::memory_order_relaxed))};
+}
+}  // namespace AMTimings
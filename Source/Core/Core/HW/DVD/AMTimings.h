@@ -0,0 +1,58 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+
+// Host time spent in the Triforce hardware, for benchmarking. Nothing is recorded unless timing
+// has been enabled, so the timers can stay in place in normal builds.
+namespace AMTimings
+{
+enum class Subsystem
+{
+  Baseboard,
+  Mediaboard,
+  Count,
+};
+
+struct Totals
+{
+  u64 calls = 0;
+  std::chrono::nanoseconds time{};
+};
+
+void SetEnabled(bool enabled);
+bool IsEnabled();
+void Reset();
+
+void Add(Subsystem subsystem, std::chrono::nanoseconds time);
+Totals GetTotals(Subsystem subsystem);
+
+// Adds the time spent in its scope to a subsystem
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Subsystem subsystem) : m_subsystem(subsystem), m_enabled(IsEnabled())
+  {
+    if (m_enabled)
+      m_start = std::chrono::steady_clock::now();
+  }
+
+  ~ScopedTimer()
+  {
+    if (m_enabled)
+      Add(m_subsystem, std::chrono::steady_clock::now() - m_start);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Subsystem m_subsystem;
+  bool m_enabled;
+  std::chrono::steady_clock::time_point m_start;
+};
+}  // namespace AMTimings
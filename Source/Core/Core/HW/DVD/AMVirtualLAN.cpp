@@ -0,0 +1,871 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/AMVirtualLAN.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "Common/Logging/Log.h"
+#include "Core/IOS/Network/Socket.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+
+#include "Common/StringUtil.h"
+#elif !defined(ANDROID)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+namespace AMMediaboard
+{
+namespace
+{
+constexpr u32 SWITCH_MAGIC = 0x4E414C56;  // "VLAN"
+// Set by the last instance to leave before it unlinks the switch, see ~VirtualLANTransport
+constexpr u32 SWITCH_UNLINKED = 1;
+constexpr u32 SWITCH_VERSION = 2;
+
+constexpr u32 INSTANCE_COUNT = 32;
+constexpr u32 ENDPOINT_COUNT = 256;
+constexpr u32 RING_SIZE = 0x10000;
+constexpr u32 BACKLOG_SIZE = 16;
+constexpr u16 FIRST_EPHEMERAL_PORT = 49152;
+
+// How often a contended SwitchLock checks whether its holder is still alive
+constexpr u32 LOCK_OWNER_CHECK_INTERVAL = 1024;
+// How many times CreateVirtualLANTransport maps the switch again when it was just unlinked
+constexpr u32 MAP_ATTEMPTS = 8;
+
+#if !defined(_WIN32) && !defined(__linux__)
+// There is no wait primitive shared between processes here, so Wait checks the switch this often
+constexpr auto WAIT_INTERVAL = std::chrono::microseconds(100);
+#endif
+
+static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<s32>::is_always_lock_free,
+              "The virtual switch lives in shared memory and needs lock-free atomics");
+
+enum class EndpointState : u32
+{
+  Free,
+  Open,
+  Listening,
+  Connected,
+  Closed,
+};
+
+// Single producer, single consumer byte ring. The peer writes, the owner reads.
+struct Ring
+{
+  std::atomic<u32> head;
+  std::atomic<u32> tail;
+  u8 data[RING_SIZE];
+};
+
+// A Dolphin instance using the switch
+struct Instance
+{
+  // 0 if the slot is free
+  std::atomic<u32> pid;
+  // Bumped whenever something the instance may be waiting for changes, see Wake
+  std::atomic<u32> wake;
+};
+
+struct Endpoint
+{
+  std::atomic<EndpointState> state;
+  // Index of the owning instance
+  u32 owner;
+  // Address in network order
+  u32 ip;
+  u16 port;
+  std::atomic<s32> peer;
+  std::atomic<u32> peer_closed;
+  // Connections waiting to be accepted on a listening endpoint
+  std::atomic<u32> backlog_head;
+  std::atomic<u32> backlog_tail;
+  s32 backlog[BACKLOG_SIZE];
+  Ring rx;
+};
+
+struct Switch
+{
+  std::atomic<u32> magic;
+  u32 version;
+  // Guards changes to the instance and endpoint tables, the data path doesn't need it. Holds the
+  // process ID of the holder, so that the lock can be taken over if the holder dies.
+  std::atomic<u32> lock;
+  u32 next_port;
+  Instance instances[INSTANCE_COUNT];
+  Endpoint endpoints[ENDPOINT_COUNT];
+};
+
+u32 GetProcessID()
+{
+#ifdef _WIN32
+  return static_cast<u32>(GetCurrentProcessId());
+#elif !defined(ANDROID)
+  return static_cast<u32>(getpid());
+#else
+  return 0;
+#endif
+}
+
+bool IsProcessAlive(u32 pid)
+{
+#ifdef _WIN32
+  const HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+  if (!process)
+    return false;
+  const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+  CloseHandle(process);
+  return alive;
+#elif !defined(ANDROID)
+  return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#else
+  return true;
+#endif
+}
+
+u32 RingWrite(Ring& ring, const u8* data, u32 length)
+{
+  const u32 head = ring.head.load(std::memory_order_relaxed);
+  const u32 tail = ring.tail.load(std::memory_order_acquire);
+  const u32 count = std::min(length, RING_SIZE - (head - tail));
+
+  const u32 start = head % RING_SIZE;
+  const u32 first = std::min(count, RING_SIZE - start);
+  std::memcpy(ring.data + start, data, first);
+  std::memcpy(ring.data, data + first, count - first);
+
+  ring.head.store(head + count, std::memory_order_release);
+  return count;
+}
+
+u32 RingRead(Ring& ring, u8* data, u32 length)
+{
+  const u32 tail = ring.tail.load(std::memory_order_relaxed);
+  const u32 head = ring.head.load(std::memory_order_acquire);
+  const u32 count = std::min(length, head - tail);
+
+  const u32 start = tail % RING_SIZE;
+  const u32 first = std::min(count, RING_SIZE - start);
+  std::memcpy(data, ring.data + start, first);
+  std::memcpy(data + first, ring.data, count - first);
+
+  ring.tail.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+bool RingEmpty(const Ring& ring)
+{
+  return ring.head.load(std::memory_order_acquire) == ring.tail.load(std::memory_order_acquire);
+}
+
+bool RingFull(const Ring& ring)
+{
+  return ring.head.load(std::memory_order_acquire) - ring.tail.load(std::memory_order_acquire) ==
+         RING_SIZE;
+}
+
+#ifdef __linux__
+static_assert(sizeof(std::atomic<u32>) == sizeof(u32));
+
+// Not FUTEX_PRIVATE_FLAG, the word is shared with other processes
+void FutexWait(std::atomic<u32>& word, u32 expected, std::chrono::nanoseconds timeout)
+{
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  timespec ts{};
+  ts.tv_sec = static_cast<time_t>(seconds.count());
+  ts.tv_nsec = static_cast<long>((timeout - seconds).count());
+  syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<u32>& word)
+{
+  syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+#ifdef _WIN32
+std::wstring GetWakeEventName(const std::string& switch_name, u32 instance)
+{
+  return UTF8ToWString(fmt::format("Local\\{}.{}", switch_name, instance));
+}
+#endif
+
+// Spin lock in shared memory. Critical sections only touch the endpoint table, so a holder that
+// keeps the lock for long has most likely died while holding it, in which case it is taken over.
+class SwitchLock
+{
+public:
+  SwitchLock(Switch* sw, u32 pid) : m_lock(sw->lock)
+  {
+    for (u32 spins = 1;; ++spins)
+    {
+      u32 holder = 0;
+      if (m_lock.compare_exchange_weak(holder, pid, std::memory_order_acquire))
+        return;
+
+      if (spins % LOCK_OWNER_CHECK_INTERVAL == 0 && holder != 0 && !IsProcessAlive(holder) &&
+          m_lock.compare_exchange_strong(holder, pid, std::memory_order_acquire))
+      {
+        WARN_LOG_FMT(DVDINTERFACE, "GC-AM: Took over the virtual LAN lock from dead process {}",
+                     holder);
+        return;
+      }
+
+      std::this_thread::yield();
+    }
+  }
+  ~SwitchLock() { m_lock.store(0, std::memory_order_release); }
+
+  SwitchLock(const SwitchLock&) = delete;
+  SwitchLock& operator=(const SwitchLock&) = delete;
+
+private:
+  std::atomic<u32>& m_lock;
+};
+
+// Maps the switch, which is shared by every instance on the machine
+class SharedSwitch
+{
+public:
+  ~SharedSwitch() { Unmap(); }
+
+  Switch* Map(const std::string& name)
+  {
+    m_name = name;
+#ifdef _WIN32
+    const u64 size = sizeof(Switch);
+    m_handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(size >> 32), static_cast<DWORD>(size),
+                                  UTF8ToWString("Local\\" + name).c_str());
+    if (!m_handle)
+      return nullptr;
+    m_switch = static_cast<Switch*>(MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+#elif !defined(ANDROID)
+    m_fd = shm_open(("/" + name).c_str(), O_RDWR | O_CREAT, 0600);
+    if (m_fd == -1)
+      return nullptr;
+    if (ftruncate(m_fd, sizeof(Switch)) < 0)
+      return nullptr;
+    void* view = mmap(nullptr, sizeof(Switch), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    m_switch = view != MAP_FAILED ? static_cast<Switch*>(view) : nullptr;
+#endif
+    return m_switch;
+  }
+
+  void Unmap()
+  {
+#ifdef _WIN32
+    if (m_switch)
+      UnmapViewOfFile(m_switch);
+    if (m_handle)
+      CloseHandle(m_handle);
+    m_handle = nullptr;
+#elif !defined(ANDROID)
+    if (m_switch)
+      munmap(m_switch, sizeof(Switch));
+    if (m_fd != -1)
+      close(m_fd);
+    m_fd = -1;
+#endif
+    m_switch = nullptr;
+  }
+
+#ifndef _WIN32
+  // Removes the name, so that the next Map creates a new switch. Windows removes named mappings
+  // once the last handle is closed.
+  void Unlink() { shm_unlink(("/" + m_name).c_str()); }
+#endif
+
+private:
+  std::string m_name;
+  Switch* m_switch = nullptr;
+#ifdef _WIN32
+  HANDLE m_handle = nullptr;
+#else
+  int m_fd = -1;
+#endif
+};
+
+class VirtualLANTransport final : public NetworkTransport
+{
+public:
+  VirtualLANTransport(std::unique_ptr<SharedSwitch> shared_switch, Switch* sw,
+                      std::string switch_name, u32 ip)
+      : m_shared_switch(std::move(shared_switch)), m_switch(sw),
+        m_switch_name(std::move(switch_name)), m_ip(ip), m_pid(GetProcessID())
+  {
+  }
+
+  ~VirtualLANTransport() override
+  {
+    if (m_instance == INSTANCE_COUNT)
+      return;
+
+    {
+      SwitchLock lock(m_switch, m_pid);
+      for (s32 i = 0; i < static_cast<s32>(ENDPOINT_COUNT); ++i)
+      {
+        if (IsOwned(i))
+          CloseLocked(i);
+      }
+      m_switch->instances[m_instance].pid.store(0);
+
+#ifndef _WIN32
+      // Named shared memory outlives its users on POSIX. Instances that mapped the switch but
+      // haven't joined yet see the magic and map the new one instead.
+      if (std::ranges::none_of(m_switch->instances, [](const Instance& instance) {
+            const u32 pid = instance.pid.load();
+            return pid != 0 && IsProcessAlive(pid);
+          }))
+      {
+        m_switch->magic.store(SWITCH_UNLINKED);
+        m_shared_switch->Unlink();
+      }
+#endif
+    }
+
+#ifdef _WIN32
+    if (m_wake_event)
+      CloseHandle(m_wake_event);
+#endif
+  }
+
+  enum class JoinResult
+  {
+    Joined,
+    Full,
+    Incompatible,
+    Unlinked,
+  };
+
+  // Sets the switch up if needed and takes a free instance slot
+  JoinResult Join()
+  {
+    SwitchLock lock(m_switch, m_pid);
+
+    // The mapping starts out zeroed. The first instance to get here sets it up. If it died halfway
+    // through, the next one takes the lock over and starts again.
+    const u32 magic = m_switch->magic.load();
+    if (magic == SWITCH_UNLINKED)
+      return JoinResult::Unlinked;
+    if (magic != SWITCH_MAGIC)
+      InitializeLocked();
+    else if (m_switch->version != SWITCH_VERSION)
+      return JoinResult::Incompatible;
+
+    // Reclaim what instances that went away without cleaning up left behind
+    std::array<bool, INSTANCE_COUNT> dead{};
+    for (u32 i = 0; i < INSTANCE_COUNT; ++i)
+    {
+      const u32 pid = m_switch->instances[i].pid.load();
+      dead[i] = pid != 0 && !IsProcessAlive(pid);
+    }
+    for (s32 i = 0; i < static_cast<s32>(ENDPOINT_COUNT); ++i)
+    {
+      const Endpoint& ep = GetEndpoint(i);
+      const EndpointState state = ep.state.load();
+      if (state != EndpointState::Free && state != EndpointState::Closed && dead[ep.owner])
+        CloseLocked(i);
+    }
+    for (u32 i = 0; i < INSTANCE_COUNT; ++i)
+    {
+      if (dead[i])
+        m_switch->instances[i].pid.store(0);
+    }
+
+    for (u32 i = 0; i < INSTANCE_COUNT; ++i)
+    {
+      Instance& instance = m_switch->instances[i];
+      if (instance.pid.load() != 0)
+        continue;
+
+#ifdef _WIN32
+      m_wake_event =
+          CreateEventW(nullptr, FALSE, FALSE, GetWakeEventName(m_switch_name, i).c_str());
+      if (!m_wake_event)
+        return JoinResult::Full;
+#endif
+      instance.wake.store(0);
+      instance.pid.store(m_pid);
+      m_instance = i;
+      return JoinResult::Joined;
+    }
+    return JoinResult::Full;
+  }
+
+  TransportHandle Socket(int af, int type) override
+  {
+    if (type != SOCK_STREAM)
+      WARN_LOG_FMT(DVDINTERFACE, "GC-AM: Virtual LAN only supports stream sockets ({})", type);
+
+    SwitchLock lock(m_switch, m_pid);
+    const s32 index = AllocateLocked(m_instance);
+    if (index < 0)
+      m_last_error = ENOBUFS;
+    return index;
+  }
+
+  int Bind(TransportHandle handle, const sockaddr_in& addr) override
+  {
+    if (!IsOwned(handle))
+      return SetError(EBADF);
+
+    SwitchLock lock(m_switch, m_pid);
+    Endpoint& ep = GetEndpoint(handle);
+    ep.ip = m_ip;
+    ep.port = addr.sin_port != 0 ? addr.sin_port : AllocatePortLocked();
+    return 0;
+  }
+
+  int Listen(TransportHandle handle, int backlog) override
+  {
+    if (!IsOwned(handle))
+      return SetError(EBADF);
+
+    SwitchLock lock(m_switch, m_pid);
+    Endpoint& ep = GetEndpoint(handle);
+    for (u32 i = 0; i < ENDPOINT_COUNT; ++i)
+    {
+      const Endpoint& other = m_switch->endpoints[i];
+      if (other.state.load() == EndpointState::Listening && other.port == ep.port &&
+          (other.ip == ep.ip || other.ip == 0 || ep.ip == 0))
+      {
+        return SetError(EADDRINUSE);
+      }
+    }
+
+    ep.backlog_head = 0;
+    ep.backlog_tail = 0;
+    ep.state = EndpointState::Listening;
+    return 0;
+  }
+
+  TransportResult Accept(TransportHandle handle, sockaddr_in* peer) override
+  {
+    if (!IsOwned(handle))
+      return Fail(EBADF);
+
+    SwitchLock lock(m_switch, m_pid);
+    Endpoint& ep = GetEndpoint(handle);
+    if (ep.state.load() != EndpointState::Listening)
+      return Fail(EINVAL);
+
+    const u32 tail = ep.backlog_tail.load();
+    if (tail == ep.backlog_head.load())
+      return {TransportStatus::WouldBlock, 0};
+
+    const s32 index = ep.backlog[tail % BACKLOG_SIZE];
+    ep.backlog_tail = tail + 1;
+
+    if (peer)
+    {
+      const Endpoint& client = GetEndpoint(GetEndpoint(index).peer.load());
+      *peer = {};
+      peer->sin_family = AF_INET;
+      peer->sin_port = client.port;
+      peer->sin_addr.s_addr = client.ip;
+    }
+
+    return {TransportStatus::Success, index};
+  }
+
+  TransportResult Connect(TransportHandle handle, const sockaddr_in& addr) override
+  {
+    if (!IsOwned(handle))
+      return Fail(EBADF);
+
+    SwitchLock lock(m_switch, m_pid);
+    Endpoint& ep = GetEndpoint(handle);
+    if (ep.state.load() == EndpointState::Connected)
+      return Fail(EISCONN);
+
+    const s32 listener_index = FindListenerLocked(addr.sin_addr.s_addr, addr.sin_port);
+    if (listener_index < 0)
+      return Fail(ECONNREFUSED);
+
+    Endpoint& listener = GetEndpoint(listener_index);
+    const u32 head = listener.backlog_head.load();
+    if (head - listener.backlog_tail.load() == BACKLOG_SIZE)
+      return Fail(ECONNREFUSED);
+
+    // The accepting side is created right away and belongs to the listener's instance
+    const s32 server_index = AllocateLocked(listener.owner);
+    if (server_index < 0)
+      return Fail(ENOBUFS);
+
+    Endpoint& server = GetEndpoint(server_index);
+    server.ip = listener.ip;
+    server.port = listener.port;
+    server.peer = static_cast<s32>(handle);
+    server.state = EndpointState::Connected;
+
+    if (ep.port == 0)
+      ep.port = AllocatePortLocked();
+    ep.ip = m_ip;
+    ep.peer = server_index;
+    ep.state = EndpointState::Connected;
+
+    listener.backlog[head % BACKLOG_SIZE] = server_index;
+    listener.backlog_head = head + 1;
+    Wake(listener.owner);
+
+    return {TransportStatus::Success, 0};
+  }
+
+  TransportResult GetConnectResult(TransportHandle handle) override
+  {
+    if (!IsOwned(handle) || GetEndpoint(handle).state.load() != EndpointState::Connected)
+      return Fail(ENOTCONN);
+    return {TransportStatus::Success, 0};
+  }
+
+  TransportResult Recv(TransportHandle handle, u8* data, u32 length) override
+  {
+    if (!IsOwned(handle))
+      return Fail(EBADF);
+
+    Endpoint& ep = GetEndpoint(handle);
+    if (ep.state.load() != EndpointState::Connected)
+      return Fail(ENOTCONN);
+
+    const u32 count = RingRead(ep.rx, data, length);
+    if (count != 0)
+    {
+      // The peer may be waiting for space to send more
+      Wake(GetEndpoint(ep.peer.load()).owner);
+      return {TransportStatus::Success, count};
+    }
+    if (length == 0)
+      return {TransportStatus::Success, 0};
+
+    // The peer has gone away and everything it sent has been read
+    if (ep.peer_closed.load() && RingEmpty(ep.rx))
+      return {TransportStatus::Success, 0};
+
+    return {TransportStatus::WouldBlock, 0};
+  }
+
+  TransportResult Send(TransportHandle handle, const u8* data, u32 length) override
+  {
+    if (!IsOwned(handle))
+      return Fail(EBADF);
+
+    Endpoint& ep = GetEndpoint(handle);
+    if (ep.state.load() != EndpointState::Connected)
+      return Fail(ENOTCONN);
+    if (ep.peer_closed.load())
+      return Fail(EPIPE);
+
+    Endpoint& peer = GetEndpoint(ep.peer.load());
+    const u32 count = RingWrite(peer.rx, data, length);
+    if (count == 0 && length != 0)
+      return {TransportStatus::WouldBlock, 0};
+    if (count != 0)
+      Wake(peer.owner);
+    return {TransportStatus::Success, count};
+  }
+
+  int SetSockOpt(TransportHandle handle, int level, int name, const u8* value,
+                 u32 length) override
+  {
+    // Nothing to tune on the virtual switch
+    return IsOwned(handle) ? 0 : SetError(EBADF);
+  }
+
+  int Close(TransportHandle handle) override
+  {
+    if (!IsOwned(handle))
+      return SetError(EBADF);
+
+    SwitchLock lock(m_switch, m_pid);
+    CloseLocked(static_cast<s32>(handle));
+    return 0;
+  }
+
+  u32 GetReadiness(TransportHandle handle, u32 events) override
+  {
+    if (!IsOwned(handle))
+      return 0;
+
+    Endpoint& ep = GetEndpoint(handle);
+    u32 ready = 0;
+    switch (ep.state.load())
+    {
+    case EndpointState::Listening:
+      if (ep.backlog_head.load() != ep.backlog_tail.load())
+        ready |= TRANSPORT_READABLE;
+      break;
+    case EndpointState::Connected:
+      if (!RingEmpty(ep.rx) || ep.peer_closed.load())
+        ready |= TRANSPORT_READABLE;
+      if (ep.peer_closed.load() || !RingFull(GetEndpoint(ep.peer.load()).rx))
+        ready |= TRANSPORT_WRITABLE;
+      break;
+    default:
+      break;
+    }
+    return ready & events;
+  }
+
+  void Wait(std::span<const TransportWaitEntry> entries,
+            std::chrono::milliseconds timeout) override
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::atomic<u32>& wake = m_switch->instances[m_instance].wake;
+    while (true)
+    {
+      // Read before checking, so that a change made after the check ends the wait right away
+      [[maybe_unused]] const u32 wake_count = wake.load(std::memory_order_acquire);
+      for (const TransportWaitEntry& entry : entries)
+      {
+        if (GetReadiness(entry.handle, entry.events) != 0)
+          return;
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+        return;
+
+#if defined(__linux__)
+      FutexWait(wake, wake_count, deadline - now);
+#elif defined(_WIN32)
+      // The event may still be set from an earlier change, that only costs an extra check
+      const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+      WaitForSingleObject(m_wake_event, static_cast<DWORD>(remaining.count()));
+#else
+      std::this_thread::sleep_for(
+          std::min<std::chrono::nanoseconds>(WAIT_INTERVAL, deadline - now));
+#endif
+    }
+  }
+
+  int GetLastError() const override { return m_last_error; }
+
+private:
+  Endpoint& GetEndpoint(s64 index) { return m_switch->endpoints[index]; }
+
+  // Everything but the lock, which the caller holds
+  void InitializeLocked()
+  {
+    m_switch->version = SWITCH_VERSION;
+    m_switch->next_port = 0;
+    for (Instance& instance : m_switch->instances)
+    {
+      instance.pid = 0;
+      instance.wake = 0;
+    }
+    for (Endpoint& ep : m_switch->endpoints)
+    {
+      ep.state = EndpointState::Free;
+      ep.peer = -1;
+    }
+    m_switch->magic.store(SWITCH_MAGIC);
+  }
+
+  bool IsOwned(TransportHandle handle)
+  {
+    if (handle < 0 || handle >= ENDPOINT_COUNT)
+      return false;
+    const Endpoint& ep = GetEndpoint(handle);
+    return ep.state.load() != EndpointState::Free && ep.owner == m_instance;
+  }
+
+  // Ends the Wait of the given instance
+  void Wake(u32 instance)
+  {
+    std::atomic<u32>& wake = m_switch->instances[instance].wake;
+    wake.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    FutexWake(wake);
+#elif defined(_WIN32)
+    const HANDLE event =
+        OpenEventW(EVENT_MODIFY_STATE, FALSE, GetWakeEventName(m_switch_name, instance).c_str());
+    if (event)
+    {
+      SetEvent(event);
+      CloseHandle(event);
+    }
+#endif
+  }
+
+  s32 AllocateLocked(u32 owner)
+  {
+    for (s32 i = 0; i < static_cast<s32>(ENDPOINT_COUNT); ++i)
+    {
+      Endpoint& ep = GetEndpoint(i);
+      if (ep.state.load() != EndpointState::Free)
+        continue;
+
+      ep.owner = owner;
+      ep.ip = 0;
+      ep.port = 0;
+      ep.peer = -1;
+      ep.peer_closed = 0;
+      ep.backlog_head = 0;
+      ep.backlog_tail = 0;
+      ep.rx.head = 0;
+      ep.rx.tail = 0;
+      ep.state = EndpointState::Open;
+      return i;
+    }
+    return -1;
+  }
+
+  void FreeLocked(s32 index)
+  {
+    Endpoint& ep = GetEndpoint(index);
+    ep.peer = -1;
+    ep.state = EndpointState::Free;
+  }
+
+  void CloseLocked(s32 index)
+  {
+    Endpoint& ep = GetEndpoint(index);
+
+    // Refuse the connections that were never accepted
+    if (ep.state.load() == EndpointState::Listening)
+    {
+      for (u32 i = ep.backlog_tail.load(); i != ep.backlog_head.load(); ++i)
+        CloseLocked(ep.backlog[i % BACKLOG_SIZE]);
+    }
+
+    ep.state = EndpointState::Closed;
+
+    // Keep both rings around until neither side can touch them anymore
+    const s32 peer = ep.peer.load();
+    if (peer < 0)
+    {
+      FreeLocked(index);
+      return;
+    }
+
+    Endpoint& peer_ep = GetEndpoint(peer);
+    peer_ep.peer_closed = 1;
+    Wake(peer_ep.owner);
+    if (peer_ep.state.load() == EndpointState::Closed || peer_ep.peer.load() != index)
+    {
+      FreeLocked(index);
+      if (peer_ep.peer.load() == index)
+        FreeLocked(peer);
+    }
+  }
+
+  s32 FindListenerLocked(u32 ip, u16 port)
+  {
+    s32 wildcard = -1;
+    for (s32 i = 0; i < static_cast<s32>(ENDPOINT_COUNT); ++i)
+    {
+      const Endpoint& ep = GetEndpoint(i);
+      if (ep.state.load() != EndpointState::Listening || ep.port != port)
+        continue;
+      if (ep.ip == ip)
+        return i;
+      if (ep.ip == 0 && wildcard < 0)
+        wildcard = i;
+    }
+    return wildcard;
+  }
+
+  u16 AllocatePortLocked()
+  {
+    const u32 range = 0x10000 - FIRST_EPHEMERAL_PORT;
+    const u32 port = FIRST_EPHEMERAL_PORT + m_switch->next_port++ % range;
+    return htons(static_cast<u16>(port));
+  }
+
+  int SetError(int error)
+  {
+    m_last_error = error;
+    return -1;
+  }
+
+  TransportResult Fail(int error)
+  {
+    m_last_error = error;
+    return {TransportStatus::Failure, 0};
+  }
+
+  std::unique_ptr<SharedSwitch> m_shared_switch;
+  Switch* m_switch;
+  std::string m_switch_name;
+  u32 m_ip;
+  u32 m_pid;
+  // INSTANCE_COUNT until Join succeeds
+  u32 m_instance = INSTANCE_COUNT;
+#ifdef _WIN32
+  HANDLE m_wake_event = nullptr;
+#endif
+  int m_last_error = 0;
+};
+}  // namespace
+
+std::unique_ptr<NetworkTransport> CreateVirtualLANTransport(const std::string& virtual_ip,
+                                                            const std::string& switch_name)
+{
+  u32 ip = 0;
+  if (!virtual_ip.empty())
+  {
+    ip = inet_addr(virtual_ip.c_str());
+    if (ip == INADDR_NONE)
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Invalid virtual LAN address {}", virtual_ip);
+      ip = 0;
+    }
+  }
+
+  // Each retry means that the last instance on the switch left and unlinked it between our Map
+  // and Join, so the next Map creates a new switch
+  for (u32 attempt = 0; attempt < MAP_ATTEMPTS; ++attempt)
+  {
+    auto shared_switch = std::make_unique<SharedSwitch>();
+    Switch* sw = shared_switch->Map(switch_name);
+    if (!sw)
+    {
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to map the virtual LAN switch");
+      return nullptr;
+    }
+
+    auto transport =
+        std::make_unique<VirtualLANTransport>(std::move(shared_switch), sw, switch_name, ip);
+    switch (transport->Join())
+    {
+    case VirtualLANTransport::JoinResult::Joined:
+      NOTICE_LOG_FMT(DVDINTERFACE, "GC-AM: Joined the virtual LAN as {}",
+                     virtual_ip.empty() ? "any address" : virtual_ip);
+      return transport;
+    case VirtualLANTransport::JoinResult::Full:
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Too many instances on the virtual LAN");
+      return nullptr;
+    case VirtualLANTransport::JoinResult::Incompatible:
+      ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Incompatible virtual LAN switch in shared memory");
+      return nullptr;
+    case VirtualLANTransport::JoinResult::Unlinked:
+      break;
+    }
+  }
+
+  ERROR_LOG_FMT(DVDINTERFACE, "GC-AM: Failed to join the virtual LAN switch");
+  return nullptr;
+}
+}  // namespace AMMediaboard
@@ -0,0 +1,21 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Core/HW/DVD/AMNetworkTransport.h"
+
+namespace AMMediaboard
+{
+// Links the media boards of several Dolphin instances on the same machine through a switch in
+// shared memory, without going through the host network stack. Connections are routed by the
+// guest's IP and port. Each instance is reachable at virtual_ip, or at any address if it is
+// empty. Instances only see each other if they use the same switch_name. Returns nullptr if the
+// shared memory can't be set up.
+std::unique_ptr<NetworkTransport>
+CreateVirtualLANTransport(const std::string& virtual_ip,
+                          const std::string& switch_name = "DolphinTriforceVirtualLAN");
+}  // namespace AMMediaboard
@@ -125,6 +125,15 @@ void DVDInterface::DoState(PointerWrap& p)
   m_system.GetDVDThread().DoState(p);
 
   m_adpcm_decoder.DoState(p);
+
+  if (m_enable_gcam)
+  {
+    AMMediaboard::DoState(p);
+
+    // Make sure the media board's files on disk match the state being saved
+    if (p.IsWriteMode())
+      AMMediaboard::FlushFiles();
+  }
 }
 
 size_t DVDInterface::ProcessDTKSamples(s16* target_samples, size_t target_block_count,
@@ -80,23 +80,19 @@ CEXIAMBaseboard::CEXIAMBaseboard(Core::System& system)
   std::string backup_Filename(File::GetUserPath(D_TRIUSER_IDX) + "tribackup_" +
                               SConfig::GetInstance().GetGameID().c_str() + ".bin");
 
-  if (File::Exists(backup_Filename))
-  {
-    m_backup = new File::IOFile(backup_Filename, "rb+");
-  }
-  else
-  {
-    m_backup = new File::IOFile(backup_Filename, "wb+");
-  }
-
-  // Some games share the same ID Client/Server
-  if (!m_backup->IsGood())
+  // The backup is kept in memory for the whole session and replaced as a whole on write back,
+  // so it is never left half written. It stays locked meanwhile, so that instances sharing the
+  // game ID don't overwrite each other's saves.
+  if (!m_backup.Open(backup_Filename, AMMediaboard::BackingFile::WriteBack::Atomic,
+                     AMMediaboard::BackingFile::Sharing::Exclusive))
   {
+    // Some games share the same ID Client/Server
     PanicAlertFmt("Failed to open tribackup\nFile might be in use.");
 
     backup_Filename = File::GetUserPath(D_TRIUSER_IDX) + "tribackup_tmp_" + SConfig::GetInstance().GetGameID().c_str() + ".bin" ;
 
-    m_backup = new File::IOFile(backup_Filename, "wb+");
+    m_backup.Open(backup_Filename, AMMediaboard::BackingFile::WriteBack::Atomic,
+                  AMMediaboard::BackingFile::Sharing::Exclusive);
   }
 
   // Virtua Striker 4 and Gekitou Pro Yakyuu need a higher FIRM version
@@ -104,33 +100,24 @@ CEXIAMBaseboard::CEXIAMBaseboard(Core::System& system)
   if (AMMediaboard::GetGameType() == VirtuaStriker4 ||
       AMMediaboard::GetGameType() == GekitouProYakyuu)
   {
-    if ( m_backup->GetSize() != 0 )
+    if ( m_backup.GetSize() != 0 )
     {
-      u8* data = new u8[m_backup->GetSize()];
+      std::vector<u8> data(m_backup.GetSize());
 
-      m_backup->ReadBytes(data, m_backup->GetSize());
+      m_backup.Read(0, data.data(), data.size());
 
       // Set FIRM version
-      *(u16*)(data + 0x12) = 0x1703;
-      *(u16*)(data + 0x212) = 0x1703;
+      *(u16*)(data.data() + 0x12) = 0x1703;
+      *(u16*)(data.data() + 0x212) = 0x1703;
 
       //Update checksum
-      *(u16*)(data + 0x0A)  = Common::swap16( CheckSum(data + 0xC, 0x1F4) );
-      *(u16*)(data + 0x20A) = Common::swap16( CheckSum(data + 0x20C, 0x1F4) );
-
-      m_backup->Seek( 0, File::SeekOrigin::Begin );
-      m_backup->WriteBytes( data, m_backup->GetSize() );
-      m_backup->Flush();
+      *(u16*)(data.data() + 0x0A)  = Common::swap16( CheckSum(data.data() + 0xC, 0x1F4) );
+      *(u16*)(data.data() + 0x20A) = Common::swap16( CheckSum(data.data() + 0x20C, 0x1F4) );
 
-      delete[] data;
+      m_backup.Write(0, data.data(), data.size());
     }
   }
 }
-CEXIAMBaseboard::~CEXIAMBaseboard()
-{
-  m_backup->Close();
-  delete m_backup;
-}
 
 void CEXIAMBaseboard::SetCS(int cs)
 {
@@ -166,11 +153,8 @@ void CEXIAMBaseboard::DMAWrite(u32 addr, u32 size)
 
   NOTICE_LOG_FMT(SP1, "AM-BB COMMAND: Backup DMA Write: {:08x} {:x}", addr, size );
 
-  m_backup->Seek(m_backoffset, File::SeekOrigin::Begin);
-
-  m_backup->WriteBytes(memory.GetPointer(addr), size);
-
-  m_backup->Flush();
+  m_backup.Write(m_backoffset, memory.GetPointer(addr), size);
+  m_backup_position = m_backoffset + size;
 }
 
 void CEXIAMBaseboard::DMARead(u32 addr, u32 size)
@@ -180,11 +164,8 @@ void CEXIAMBaseboard::DMARead(u32 addr, u32 size)
 
   NOTICE_LOG_FMT(SP1, "AM-BB COMMAND: Backup DMA Read: {:08x} {:x}", addr, size );
 
-  m_backup->Seek(m_backoffset, File::SeekOrigin::Begin);
-
-  m_backup->Flush();
-
-  m_backup->ReadBytes(memory.GetPointer(addr), size);
+  m_backup.Read(m_backoffset, memory.GetPointer(addr), size);
+  m_backup_position = m_backoffset + size;
 }
 
 void CEXIAMBaseboard::TransferByte(u8& _byte)
@@ -226,13 +207,12 @@ void CEXIAMBaseboard::TransferByte(u8& _byte)
       case AMBB_OFFSET_SET:
 				m_backoffset = (m_command[1] << 8) | m_command[2];
         DEBUG_LOG_FMT(SP1, "AM-BB COMMAND: Backup Offset:{:04x}", m_backoffset);
-        m_backup->Seek(m_backoffset, File::SeekOrigin::Begin);
+        m_backup_position = m_backoffset;
         _byte = 0x01;
       break;
       case AMBB_BACKUP_WRITE:
         DEBUG_LOG_FMT(SP1, "AM-BB COMMAND: Backup Write:{:04x}-{:02x}", m_backoffset, m_command[1]);
-				m_backup->WriteBytes( &m_command[1], 1 );
-        m_backup->Flush();
+        m_backup.Write(m_backup_position++, &m_command[1], 1);
 				_byte = 0x01;
 				break;
       case AMBB_BACKUP_READ:
@@ -289,8 +269,7 @@ void CEXIAMBaseboard::TransferByte(u8& _byte)
 			{
 			// Read backup - 1 byte out
 			case 0x03:
-				m_backup->Flush();
-				m_backup->ReadBytes( &_byte, 1);
+        m_backup.Read(m_backup_position++, &_byte, 1);
         break;
       // DMA?
       case 0x05:
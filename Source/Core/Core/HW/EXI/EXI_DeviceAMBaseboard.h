@@ -10,8 +10,8 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
+#include "Core/HW/DVD/AMBackingFile.h"
 #include "Core/HW/EXI/EXI_Device.h"
-#include "Common/IOFile.h"
 
 namespace Core
 {
@@ -27,7 +27,6 @@ class CEXIAMBaseboard : public IEXIDevice
 {
 public:
   explicit CEXIAMBaseboard(Core::System& system);
-  virtual ~CEXIAMBaseboard();
 
   void SetCS(int _iCS) override;
   bool IsInterruptSet() override;
@@ -59,7 +58,9 @@ enum
   u32 m_backup_dma_len;
 	unsigned char m_command[4];
 	unsigned short m_backoffset;
-  File::IOFile* m_backup;
+  // Where single byte backup reads and writes go, advanced by each of them like a file position
+  u32 m_backup_position = 0;
+  AMMediaboard::BackingFile m_backup;
 
 protected:
   void TransferByte(u8& _uByte) override;
@@ -6,13 +6,18 @@
 #include "Core/HW/SI/SI_DeviceAMBaseboard.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <fmt/format.h>
 
+#include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -28,7 +33,9 @@
 #include "Core/ConfigLoaders/NetPlayConfigLoader.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/DVD/AMBackingFile.h"
 #include "Core/HW/DVD/AMMediaboard.h"
+#include "Core/HW/DVD/AMTimings.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/MMIO.h"
@@ -67,10 +74,21 @@ void JVSIOMessage::start(int node)
 
 void JVSIOMessage::addData(const u8* dst, size_t len, int sync = 0)
 {
+  // Escaping at most doubles the size, so the bounds only need checking near the end
+  const bool near_end = m_ptr + len * 2 > sizeof(m_msg);
+
   while (len--)
   {
     int c = *dst++;
-    if (!sync && ((c == 0xE0) || (c == 0xD0)))
+    const bool escape = !sync && ((c == 0xE0) || (c == 0xD0));
+
+    if (near_end && m_ptr + (escape ? 2 : 1) > sizeof(m_msg))
+    {
+      PanicAlertFmt("JVSIOMessage overrun!");
+      return;
+    }
+
+    if (escape)
     {
       m_msg[m_ptr++] = 0xD0;
       m_msg[m_ptr++] = c - 1;
@@ -83,8 +101,6 @@ void JVSIOMessage::addData(const u8* dst, size_t len, int sync = 0)
     if (!sync)
       m_csum += c;
     sync = 0;
-    if (m_ptr >= 0x80)
-      PanicAlertFmt("JVSIOMessage overrun!");
   }
 }
 
@@ -104,6 +120,39 @@ void JVSIOMessage::addData(u32 n)
   addData(&cs, 1);
 }
 
+void JVSIOMessage::addEncoded(const EncodedData& encoded)
+{
+  if (m_ptr + encoded.data.size() > sizeof(m_msg))
+  {
+    PanicAlertFmt("JVSIOMessage overrun!");
+    return;
+  }
+
+  std::memcpy(m_msg + m_ptr, encoded.data.data(), encoded.data.size());
+  m_ptr += static_cast<u32>(encoded.data.size());
+  m_csum += encoded.csum;
+}
+
+JVSIOMessage::EncodedData JVSIOMessage::encode(const u8* data, size_t len)
+{
+  EncodedData encoded;
+  for (size_t i = 0; i < len; ++i)
+  {
+    const u8 c = data[i];
+    if ((c == 0xE0) || (c == 0xD0))
+    {
+      encoded.data.push_back(0xD0);
+      encoded.data.push_back(c - 1);
+    }
+    else
+    {
+      encoded.data.push_back(c);
+    }
+    encoded.csum += c;
+  }
+  return encoded;
+}
+
 void JVSIOMessage::end()
 {
   u32 len = m_ptr - m_last_start;
@@ -123,12 +172,103 @@ static u8 CheckSumXOR(u8* Data, u32 Length)
   return check;
 }
 
+// JVS I/O board a game expects to find
+struct JVSIOBoard
+{
+  std::string_view id;
+  // CheckFunctionality reply, four bytes per feature, terminated by an empty feature
+  std::span<const u8> features;
+  u8 command_revision = 0x11;
+  u8 jvs_revision = 0x20;
+  u8 communication_version = 0x10;
+};
+
+// Specific version that enables DX mode on AX machines
+constexpr std::string_view SEGA_IO_CNTL_BD2_ID =
+    "SEGA ENTERPRISES,LTD.;837-13844-01 I/O CNTL BD2 ;";
+constexpr std::string_view SEGA_IO_BD_JVS_ID = "SEGA ENTERPRISES,LTD.;I/O BD JVS;837-13551;Ver1.00";
+constexpr std::string_view NAMCO_FCA_1_ID =
+    "namco ltd.;FCA-1;Ver1.01;JPN,Multipurpose + Rotary Encoder";
+
+// Slave features
+/*
+  0x01: Player count, Bit per channel
+  0x02: Coin slots
+  0x03: Analog-in
+  0x04: Rotary
+  0x05: Keycode
+  0x06: Screen, x, y, ch
+  ....: unused
+  0x10: Card
+  0x11: Hopper-out
+  0x12: Driver-out
+  0x13: Analog-out
+  0x14: Character, Line (?)
+  0x15: Backup
+*/
+
+// DX Version: 2 Player (22bit) (p2=paddles), 2 Coin slot, 8 Analog-in, 22 Driver-out
+// The non-DX board reports 2 Player (12bit), 1 Coin slot, 6 Analog-in instead
+constexpr u8 FZERO_AX_FEATURES[] = {
+    0x01, 0x02, 0x12, 0x00, 0x02, 0x02, 0x00, 0x00, 0x03, 0x08,
+    0x0A, 0x00, 0x12, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// 2 Player (13bit), 2 Coin slot, 4 Analog-in, 1 CARD, 8 Driver-out
+constexpr u8 VIRTUA_STRIKER_3_FEATURES[] = {
+    0x01, 0x02, 0x0D, 0x00, 0x02, 0x02, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00,
+    0x10, 0x01, 0x00, 0x00, 0x12, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// 2 Player (13bit), 1 Coin slot, 4 Analog-in, 1 CARD
+constexpr u8 VIRTUA_STRIKER_4_FEATURES[] = {
+    0x01, 0x02, 0x0D, 0x00, 0x02, 0x01, 0x00, 0x00, 0x03, 0x04,
+    0x00, 0x00, 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// 1 Player (15bit), 1 Coin slot, 3 Analog-in, 1 CARD, 1 Driver-out
+constexpr u8 MARIO_KART_GP_FEATURES[] = {
+    0x01, 0x01, 0x0F, 0x00, 0x02, 0x01, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00,
+    0x10, 0x01, 0x00, 0x00, 0x12, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static JVSIOBoard GetJVSIOBoard(u32 game_type)
+{
+  switch (game_type)
+  {
+  case FZeroAX:
+  case FZeroAXMonster:
+    return {SEGA_IO_CNTL_BD2_ID, FZERO_AX_FEATURES};
+  case VirtuaStriker3:
+    return {SEGA_IO_BD_JVS_ID, VIRTUA_STRIKER_3_FEATURES};
+  case VirtuaStriker4:
+    return {SEGA_IO_BD_JVS_ID, VIRTUA_STRIKER_4_FEATURES};
+  case GekitouProYakyuu:
+    return {NAMCO_FCA_1_ID, VIRTUA_STRIKER_3_FEATURES};
+  case MarioKartGP:
+  case MarioKartGP2:
+  default:
+    return {NAMCO_FCA_1_ID, MARIO_KART_GP_FEATURES};
+  }
+}
+
 // AM-Baseboard device on SI
 CSIDevice_AMBaseboard::CSIDevice_AMBaseboard(Core::System& system, SIDevices device,
                                              int device_number)
     : ISIDevice(system, device, device_number)
 {
+  m_game_type = AMMediaboard::GetGameType();
+  SetupJVSIO();
+
+  m_status_switches_0 = 0xFF;
+  m_status_switches_1 = 0xFE;
+
+  m_rx_reply = 0;
+  m_rx_reply_offset = 0;
+  m_gpo_delay = 0;
+
   memset(m_coin, 0, sizeof(m_coin));
+  memset(m_coin_pressed, 0, sizeof(m_coin_pressed));
 
   // Setup IC-card
   m_ic_card_state = 0x20;
@@ -144,12 +284,12 @@ CSIDevice_AMBaseboard::CSIDevice_AMBaseboard(Core::System& system, SIDevices dev
   m_ic_card_data[0x20] = 0x95;
   m_ic_card_data[0x21] = 0x71;
 
-  if (AMMediaboard::GetGameType() == KeyOfAvalon)
+  if (m_game_type == KeyOfAvalon)
   {
     m_ic_card_data[0x22] = 0x26;
     m_ic_card_data[0x23] = 0x40;
   }
-  else if (AMMediaboard::GetGameType() == VirtuaStriker4)
+  else if (m_game_type == VirtuaStriker4)
   {
     m_ic_card_data[0x22] = 0x44;
     m_ic_card_data[0x23] = 0x00;
@@ -180,6 +320,11 @@ CSIDevice_AMBaseboard::CSIDevice_AMBaseboard(Core::System& system, SIDevices dev
   m_card_bit = 0;
   m_card_state_call_count = 0;
 
+  // Loaded once, card reads and writes only touch memory
+  m_card_file.Open(File::GetUserPath(D_TRIUSER_IDX) + "tricard_" +
+                       SConfig::GetInstance().GetGameID() + ".bin",
+                   AMMediaboard::BackingFile::WriteBack::Atomic);
+
   // Serial
   m_wheelinit = 0;
 
@@ -197,6 +342,63 @@ CSIDevice_AMBaseboard::CSIDevice_AMBaseboard(Core::System& system, SIDevices dev
   m_fzcc_service = 0;
 
   memset(m_motorreply, 0, sizeof(m_motorreply));
+
+  memset(m_last_reply, 0, sizeof(m_last_reply));
+  memset(m_last_reply_length, 0, sizeof(m_last_reply_length));
+}
+
+void CSIDevice_AMBaseboard::DoState(PointerWrap& p)
+{
+  p.Do(m_status_switches_0);
+  p.Do(m_status_switches_1);
+
+  p.Do(m_rx_reply);
+  p.Do(m_rx_reply_offset);
+  p.Do(m_gpo_delay);
+
+  p.DoArray(m_coin);
+  p.DoArray(m_coin_pressed);
+
+  p.DoArray(m_ic_card_data);
+  p.Do(m_ic_card_state);
+  p.Do(m_ic_card_session);
+  p.DoArray(m_ic_write_buffer);
+  p.Do(m_ic_write_offset);
+  p.Do(m_ic_write_size);
+
+  p.DoArray(m_card_memory);
+  p.DoArray(m_card_read_packet);
+  p.DoArray(m_card_buffer);
+  p.Do(m_card_memory_size);
+  p.Do(m_card_is_inserted);
+  p.Do(m_card_command);
+  p.Do(m_card_clean);
+  p.Do(m_card_write_length);
+  p.Do(m_card_wrote);
+  p.Do(m_card_read_length);
+  p.Do(m_card_read);
+  p.Do(m_card_bit);
+  p.Do(m_card_state_call_count);
+  p.Do(m_card_offset);
+
+  p.Do(m_wheelinit);
+
+  p.Do(m_motorinit);
+  p.DoArray(m_motorreply);
+  p.Do(m_motorforce_x);
+
+  p.Do(m_fzdx_seatbelt);
+  p.Do(m_fzdx_motion_stop);
+  p.Do(m_fzdx_sensor_right);
+  p.Do(m_fzdx_sensor_left);
+
+  p.Do(m_fzcc_seatbelt);
+  p.Do(m_fzcc_sensor);
+  p.Do(m_fzcc_emergency);
+  p.Do(m_fzcc_service);
+
+  p.DoArray(m_last_reply);
+  p.DoArray(m_last_reply_length);
 }
 
 constexpr u32 SI_XFER_LENGTH_MASK = 0x7f;
@@ -222,8 +424,596 @@ void CSIDevice_AMBaseboard::ICCardSendReply(ICCommand* iccommand, u8* buffer, u3
   buffer[(*length)++] = crc;
 }
 
+void CSIDevice_AMBaseboard::SetupJVSIO()
+{
+  const JVSIOBoard board = GetJVSIOBoard(m_game_type);
+
+  const auto cache_reply = [this](JVSIOCommands command, const std::vector<u8>& reply) {
+    m_jvs_cached_replies[command] = JVSIOMessage::encode(reply.data(), reply.size());
+  };
+
+  std::vector<u8> ioid{1};
+  ioid.insert(ioid.end(), board.id.begin(), board.id.end());
+  ioid.push_back(0);
+  cache_reply(JVSIOCommands::IOID, ioid);
+
+  cache_reply(JVSIOCommands::CommandRevision, {1, board.command_revision});
+  cache_reply(JVSIOCommands::JVRevision, {1, board.jvs_revision});
+  cache_reply(JVSIOCommands::CommunicationVersion, {1, board.communication_version});
+
+  std::vector<u8> features{1};
+  features.insert(features.end(), board.features.begin(), board.features.end());
+  cache_reply(JVSIOCommands::CheckFunctionality, features);
+
+  m_jvs_handlers.fill(nullptr);
+  m_jvs_handlers[JVSIOCommands::MainID] = &CSIDevice_AMBaseboard::JVSMainID;
+  m_jvs_handlers[JVSIOCommands::SwitchesInput] = &CSIDevice_AMBaseboard::JVSSwitchesInput;
+  m_jvs_handlers[JVSIOCommands::CoinInput] = &CSIDevice_AMBaseboard::JVSCoinInput;
+  m_jvs_handlers[JVSIOCommands::AnalogInput] = &CSIDevice_AMBaseboard::JVSAnalogInput;
+  m_jvs_handlers[JVSIOCommands::CoinSubOutput] = &CSIDevice_AMBaseboard::JVSCoinSubOutput;
+  m_jvs_handlers[JVSIOCommands::GeneralDriverOutput] =
+      &CSIDevice_AMBaseboard::JVSGeneralDriverOutput;
+  m_jvs_handlers[JVSIOCommands::CoinAddOutput] = &CSIDevice_AMBaseboard::JVSCoinAddOutput;
+  m_jvs_handlers[JVSIOCommands::NAMCOCommand] = &CSIDevice_AMBaseboard::JVSNAMCOCommand;
+  m_jvs_handlers[JVSIOCommands::Reset] = &CSIDevice_AMBaseboard::JVSReset;
+  m_jvs_handlers[JVSIOCommands::SetAddress] = &CSIDevice_AMBaseboard::JVSSetAddress;
+}
+
+void CSIDevice_AMBaseboard::ProcessJVSIO(JVSIORequest& request, JVSIOMessage& msg)
+{
+  while (request.data < request.end)
+  {
+    const u8 cmd = *request.data++;
+    DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:node={}, command={:02x}", request.node, cmd);
+
+    // Board descriptions never change, so their replies are ready to be copied
+    const JVSIOMessage::EncodedData& cached_reply = m_jvs_cached_replies[cmd];
+    if (!cached_reply.data.empty())
+    {
+      msg.addEncoded(cached_reply);
+      continue;
+    }
+
+    const JVSIOHandler handler = m_jvs_handlers[cmd];
+    if (!handler)
+    {
+      ERROR_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO: node={}, command={:02x}", request.node, cmd);
+      continue;
+    }
+
+    (this->*handler)(request, msg);
+  }
+}
+
+void CSIDevice_AMBaseboard::JVSMainID(JVSIORequest& request, JVSIOMessage& msg)
+{
+  while (*request.data++)
+  {
+  };
+  msg.addData(1);
+}
+
+void CSIDevice_AMBaseboard::GetPlayerSwitches(int player, u8* player_data)
+{
+  GCPadStatus PadStatus;
+
+  switch (m_game_type)
+  {
+  // Controller configuration for F-Zero AX (DX)
+  case FZeroAX:
+    PadStatus = Pad::GetStatus(0);
+    if (player == 0)
+    {
+      if (m_fzdx_seatbelt)
+      {
+        player_data[0] |= 0x01;
+      }
+
+      // Start
+      if (PadStatus.button & PAD_BUTTON_START)
+        player_data[0] |= 0x80;
+      // Service button
+      if (PadStatus.button & PAD_BUTTON_X)
+        player_data[0] |= 0x40;
+      // Boost
+      if (PadStatus.button & PAD_BUTTON_Y)
+        player_data[0] |= 0x02;
+      // View Change 1
+      if (PadStatus.button & PAD_BUTTON_RIGHT)
+        player_data[0] |= 0x20;
+      // View Change 2
+      if (PadStatus.button & PAD_BUTTON_LEFT)
+        player_data[0] |= 0x10;
+      // View Change 3
+      if (PadStatus.button & PAD_BUTTON_UP)
+        player_data[0] |= 0x08;
+      // View Change 4
+      if (PadStatus.button & PAD_BUTTON_DOWN)
+        player_data[0] |= 0x04;
+      player_data[1] = m_rx_reply & 0xF0;
+    }
+    else if (player == 1)
+    {
+      //  Paddle left
+      if (PadStatus.button & PAD_BUTTON_A)
+        player_data[0] |= 0x20;
+      //  Paddle right
+      if (PadStatus.button & PAD_BUTTON_B)
+        player_data[0] |= 0x10;
+
+      if (m_fzdx_motion_stop)
+      {
+        player_data[0] |= 2;
+      }
+      if (m_fzdx_sensor_right)
+      {
+        player_data[0] |= 4;
+      }
+      if (m_fzdx_sensor_left)
+      {
+        player_data[0] |= 8;
+      }
+
+      player_data[1] = m_rx_reply << 4;
+    }
+    break;
+  // Controller configuration for F-Zero AX MonsterRide
+  case FZeroAXMonster:
+    PadStatus = Pad::GetStatus(0);
+    if (player == 0)
+    {
+      if (m_fzcc_sensor)
+      {
+        player_data[0] |= 0x01;
+      }
+
+      // Start
+      if (PadStatus.button & PAD_BUTTON_START)
+        player_data[0] |= 0x80;
+      // Service button
+      if (PadStatus.button & PAD_BUTTON_X)
+        player_data[0] |= 0x40;
+      // Boost
+      if (PadStatus.button & PAD_BUTTON_Y)
+        player_data[0] |= 0x02;
+      // View Change 1
+      if (PadStatus.button & PAD_BUTTON_RIGHT)
+        player_data[0] |= 0x20;
+      // View Change 2
+      if (PadStatus.button & PAD_BUTTON_LEFT)
+        player_data[0] |= 0x10;
+      // View Change 3
+      if (PadStatus.button & PAD_BUTTON_UP)
+        player_data[0] |= 0x08;
+      // View Change 4
+      if (PadStatus.button & PAD_BUTTON_DOWN)
+        player_data[0] |= 0x04;
+
+      player_data[1] = m_rx_reply & 0xF0;
+    }
+    else if (player == 1)
+    {
+      //  Paddle left
+      if (PadStatus.button & PAD_BUTTON_A)
+        player_data[0] |= 0x20;
+      //  Paddle right
+      if (PadStatus.button & PAD_BUTTON_B)
+        player_data[0] |= 0x10;
+
+      if (m_fzcc_seatbelt)
+      {
+        player_data[0] |= 2;
+      }
+      if (m_fzcc_service)
+      {
+        player_data[0] |= 4;
+      }
+      if (m_fzcc_emergency)
+      {
+        player_data[0] |= 8;
+      }
+    }
+    break;
+  // Controller configuration for Virtua Striker 3 games
+  case VirtuaStriker3:
+    PadStatus = Pad::GetStatus(player);
+    // Start
+    if (PadStatus.button & PAD_BUTTON_START)
+      player_data[0] |= 0x80;
+    // Service button
+    if (PadStatus.button & PAD_BUTTON_X)
+      player_data[0] |= 0x40;
+    // Long Pass
+    if (PadStatus.button & PAD_TRIGGER_L)
+      player_data[0] |= 0x01;
+    // Short Pass
+    if (PadStatus.button & PAD_TRIGGER_R)
+      player_data[1] |= 0x80;
+    // Shoot
+    if (PadStatus.button & PAD_BUTTON_A)
+      player_data[0] |= 0x02;
+    // Left
+    if (PadStatus.button & PAD_BUTTON_LEFT)
+      player_data[0] |= 0x08;
+    // Up
+    if (PadStatus.button & PAD_BUTTON_UP)
+      player_data[0] |= 0x20;
+    // Right
+    if (PadStatus.button & PAD_BUTTON_RIGHT)
+      player_data[0] |= 0x04;
+    // Down
+    if (PadStatus.button & PAD_BUTTON_DOWN)
+      player_data[0] |= 0x10;
+    break;
+  // Controller configuration for Virtua Striker 4 games
+  case VirtuaStriker4:
+  {
+    PadStatus = Pad::GetStatus(player);
+    // Start
+    if (PadStatus.button & PAD_BUTTON_START)
+      player_data[0] |= 0x80;
+    // Service button
+    if (PadStatus.button & PAD_BUTTON_X)
+      player_data[0] |= 0x40;
+    // Long Pass
+    if (PadStatus.button & PAD_TRIGGER_L)
+      player_data[0] |= 0x01;
+    // Short Pass
+    if (PadStatus.button & PAD_TRIGGER_R)
+      player_data[0] |= 0x02;
+    // Shoot
+    if (PadStatus.button & PAD_BUTTON_A)
+      player_data[1] |= 0x80;
+    // Dash
+    if (PadStatus.button & PAD_BUTTON_B)
+      player_data[1] |= 0x40;
+    // Tactics (U)
+    if (PadStatus.button & PAD_BUTTON_LEFT)
+      player_data[0] |= 0x20;
+    // Tactics (M)
+    if (PadStatus.button & PAD_BUTTON_UP)
+      player_data[0] |= 0x08;
+    // Tactics (D)
+    if (PadStatus.button & PAD_BUTTON_RIGHT)
+      player_data[0] |= 0x04;
+
+    if (player == 0)
+    {
+      player_data[0] |= 0x10;  // IC-Card Switch ON
+
+      // IC-Card Lock
+      if (PadStatus.button & PAD_BUTTON_DOWN)
+        player_data[1] |= 0x20;
+    }
+  }
+  break;
+  // Controller configuration for Gekitou Pro Yakyuu
+  case GekitouProYakyuu:
+    PadStatus = Pad::GetStatus(player);
+    // Start
+    if (PadStatus.button & PAD_BUTTON_START)
+      player_data[0] |= 0x80;
+    // Service button
+    if (PadStatus.button & PAD_BUTTON_X)
+      player_data[0] |= 0x40;
+    //  A
+    if (PadStatus.button & PAD_BUTTON_B)
+      player_data[0] |= 0x01;
+    //  B
+    if (PadStatus.button & PAD_BUTTON_A)
+      player_data[0] |= 0x02;
+    //  Gekitou
+    if (PadStatus.button & PAD_TRIGGER_L)
+      player_data[1] |= 0x80;
+    // Left
+    if (PadStatus.button & PAD_BUTTON_LEFT)
+      player_data[0] |= 0x08;
+    // Up
+    if (PadStatus.button & PAD_BUTTON_UP)
+      player_data[0] |= 0x20;
+    // Right
+    if (PadStatus.button & PAD_BUTTON_RIGHT)
+      player_data[0] |= 0x04;
+    // Down
+    if (PadStatus.button & PAD_BUTTON_DOWN)
+      player_data[0] |= 0x10;
+    break;
+  // Controller configuration for Mario Kart and other games
+  default:
+  case MarioKartGP:
+  case MarioKartGP2:
+  {
+    PadStatus = Pad::GetStatus(0);
+    // Start
+    if (PadStatus.button & PAD_BUTTON_START)
+      player_data[0] |= 0x80;
+    // Service button
+    if (PadStatus.button & PAD_BUTTON_X)
+      player_data[0] |= 0x40;
+    // Item button
+    if (PadStatus.button & PAD_BUTTON_A)
+      player_data[1] |= 0x20;
+    // VS-Cancel button
+    if (PadStatus.button & PAD_BUTTON_B)
+      player_data[1] |= 0x02;
+  }
+  break;
+  }
+}
+
+void CSIDevice_AMBaseboard::JVSSwitchesInput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const int player_count = *request.data++;
+  const int player_byte_count = *request.data++;
+
+  DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:  Command 20, SwitchInputs: {} {}", player_count,
+                player_byte_count);
+
+  // The reply is put together here and escaped in one go
+  std::array<u8, sizeof(JVSIOMessage::m_msg)> reply;
+  size_t length = 0;
+
+  reply[length++] = 1;
+
+  // Test button
+  const GCPadStatus PadStatus = Pad::GetStatus(0);
+  reply[length++] = (PadStatus.button & PAD_TRIGGER_Z) ? 0x80 : 0x00;
+
+  for (int i = 0; i < player_count; ++i)
+  {
+    u8 player_data[3] = {0, 0, 0};
+    GetPlayerSwitches(i, player_data);
+
+    for (int j = 0; j < player_byte_count && length < reply.size(); ++j)
+      reply[length++] = j < static_cast<int>(std::size(player_data)) ? player_data[j] : 0;
+  }
+
+  msg.addData(reply.data(), length);
+}
+
+void CSIDevice_AMBaseboard::JVSCoinInput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const int slots = *request.data++;
+
+  std::array<u8, sizeof(JVSIOMessage::m_msg)> reply;
+  size_t length = 0;
+
+  reply[length++] = 1;
+  for (int i = 0; i < slots && length + 2 <= reply.size(); i++)
+  {
+    if (i >= static_cast<int>(std::size(m_coin)))
+    {
+      reply[length++] = 0;
+      reply[length++] = 0;
+      continue;
+    }
+
+    const GCPadStatus PadStatus = Pad::GetStatus(i);
+    if ((PadStatus.button & PAD_TRIGGER_Z) && !m_coin_pressed[i])
+    {
+      m_coin[i]++;
+    }
+    m_coin_pressed[i] = PadStatus.button & PAD_TRIGGER_Z;
+    reply[length++] = (m_coin[i] >> 8) & 0x3f;
+    reply[length++] = m_coin[i] & 0xff;
+  }
+
+  msg.addData(reply.data(), length);
+}
+
+void CSIDevice_AMBaseboard::JVSAnalogInput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const int analogs = *request.data++;
+
+  std::array<u8, 32> reply;
+  size_t length = 0;
+
+  reply[length++] = 1;  // status
+
+  GCPadStatus PadStatus;
+  GCPadStatus PadStatus2;
+  PadStatus = Pad::GetStatus(0);
+
+  DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:Get Analog Inputs Analogs:{}", analogs);
+
+  switch (m_game_type)
+  {
+  case FZeroAX:
+  case FZeroAXMonster:
+    // Steering
+    if (m_motorinit == 1)
+    {
+      if (m_motorforce_x > 0)
+      {
+        reply[length++] = 0x80 - (m_motorforce_x >> 8);
+      }
+      else
+      {
+        reply[length++] = (m_motorforce_x >> 8);
+      }
+      reply[length++] = 0;
+
+      reply[length++] = PadStatus.stickY;
+      reply[length++] = 0;
+    }
+    else
+    {
+      reply[length++] = PadStatus.stickX;
+      reply[length++] = 0;
+
+      reply[length++] = PadStatus.stickY;
+      reply[length++] = 0;
+    }
+
+    // Unused
+    reply[length++] = 0;
+    reply[length++] = 0;
+    reply[length++] = 0;
+    reply[length++] = 0;
+
+    // Gas
+    reply[length++] = PadStatus.triggerRight;
+    reply[length++] = 0;
+
+    // Brake
+    reply[length++] = PadStatus.triggerLeft;
+    reply[length++] = 0;
+
+    reply[length++] = 0x80;  // Motion Stop
+    reply[length++] = 0;
+
+    reply[length++] = 0;
+    reply[length++] = 0;
+
+    break;
+  case VirtuaStriker3:
+  case VirtuaStriker4:
+  {
+    PadStatus2 = Pad::GetStatus(1);
+
+    reply[length++] = PadStatus.stickX;
+    reply[length++] = 0;
+    reply[length++] = PadStatus.stickY;
+    reply[length++] = 0;
+
+    reply[length++] = PadStatus2.stickX;
+    reply[length++] = 0;
+    reply[length++] = PadStatus2.stickY;
+    reply[length++] = 0;
+  }
+  break;
+  default:
+  case MarioKartGP:
+  case MarioKartGP2:
+    // Steering
+    reply[length++] = PadStatus.stickX;
+    reply[length++] = 0;
+
+    // Gas
+    reply[length++] = PadStatus.triggerRight;
+    reply[length++] = 0;
+
+    // Brake
+    reply[length++] = PadStatus.triggerLeft;
+    reply[length++] = 0;
+    break;
+  }
+  msg.addData(reply.data(), length);
+}
+
+void CSIDevice_AMBaseboard::JVSCoinSubOutput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const u32 slot = *request.data++;
+  const u32 coins_high = *request.data++;
+  const u32 coins_low = *request.data++;
+  m_coin[slot] -= (coins_high << 8) | coins_low;
+  msg.addData(1);
+}
+
+void CSIDevice_AMBaseboard::JVSGeneralDriverOutput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const u32 bytes = *request.data++;
+  if (bytes)
+  {
+    const u8* buf = request.data;
+    request.data += bytes;
+
+    DEBUG_LOG_FMT(AMBASEBOARDDEBUG,
+                  "JVS-IO: Command 32, GPO: {:02x} {:02x} {} {:02x}{:02x}{:02x} ({:02x})",
+                  m_gpo_delay, m_rx_reply, bytes, buf[0], buf[1], buf[2],
+                  Common::swap16(buf + 1) >> 2);
+
+    // TODO: figure this out
+
+    static constexpr u8 trepl[] = {
+        0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0xE0,
+        0xF0, 0x01, 0x11, 0x21, 0x31, 0x41, 0x51, 0x61, 0x71, 0x81, 0x91, 0xA1, 0xB1, 0xC1, 0xD1,
+        0xE1, 0xF1, 0x02, 0x12, 0x22, 0x32, 0x42, 0x52, 0x62, 0x72, 0x82, 0x92, 0xA2, 0xB2, 0xC2,
+        0xD2, 0xE2, 0xF2, 0x04, 0x14, 0x24, 0x34, 0x44, 0x54, 0x64, 0x74, 0x84, 0x94, 0xA4, 0xB4,
+        0xC4, 0xD4, 0xE4, 0xF4, 0x05, 0x15, 0x25, 0x35, 0x45, 0x55, 0x65, 0x75, 0x85, 0x95, 0xA5,
+        0xB5, 0xC5, 0xD5, 0xE5, 0xF5, 0x06, 0x16, 0x26, 0x36, 0x46, 0x56, 0x66, 0x76, 0x86, 0x96,
+        0xA6, 0xB6, 0xC6, 0xD6, 0xE6, 0xF6, 0x08, 0x18, 0x28, 0x38, 0x48, 0x58, 0x68, 0x78, 0x88,
+        0x98, 0xA8, 0xB8, 0xC8, 0xD8, 0xE8, 0xF8, 0x09, 0x19, 0x29, 0x39, 0x49, 0x59, 0x69, 0x79,
+        0x89, 0x99, 0xA9, 0xB9, 0xC9, 0xD9, 0xE9, 0xF9, 0x0A, 0x1A, 0x2A, 0x3A, 0x4A, 0x5A, 0x6A,
+        0x7A, 0x8A, 0x9A, 0xAA, 0xBA, 0xCA, 0xDA, 0xEA, 0xFA, 0x0C, 0x1C, 0x2C, 0x3C, 0x4C, 0x5C,
+        0x6C, 0x7C, 0x8C, 0x9C, 0xAC, 0xBC, 0xCC, 0xDC, 0xEC, 0xFC, 0x0D, 0x1D, 0x2D, 0x3D, 0x4D,
+        0x5D, 0x6D, 0x7D, 0x8D, 0x9D, 0xAD, 0xBD, 0xCD, 0xDD, 0xED, 0xFD, 0x0E, 0x1E, 0x2E, 0x3E,
+        0x4E, 0x5E, 0x6E, 0x7E, 0x8E, 0x9E, 0xAE, 0xBE, 0xCE, 0xDE, 0xEE, 0xFE};
+
+    if (m_rx_reply_offset >= sizeof(trepl))
+      m_rx_reply_offset = 0;
+
+    switch (Common::swap16(buf + 1) >> 2)
+    {
+    case 0x70:
+      m_gpo_delay++;
+      if ((m_gpo_delay % 10) == 0)
+      {
+        m_rx_reply = trepl[m_rx_reply_offset++];
+      }
+      break;
+    default:
+    case 0x60:
+    case 0xA0:
+    case 0xF0:
+      m_rx_reply = 0;
+      break;
+    }
+  }
+  msg.addData(1);
+}
+
+void CSIDevice_AMBaseboard::JVSCoinAddOutput(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const int slot = *request.data++;
+  const u32 coins_high = *request.data++;
+  const u32 coins_low = *request.data++;
+  m_coin[slot] += (coins_high << 8) | coins_low;
+  msg.addData(1);
+}
+
+void CSIDevice_AMBaseboard::JVSNAMCOCommand(JVSIORequest& request, JVSIOMessage& msg)
+{
+  const int cmd_ = *request.data++;
+  if (cmd_ == 0x18)
+  {  // id check
+    request.data += 4;
+    msg.addData(1);
+    msg.addData(0xff);
+  }
+  else
+  {
+    msg.addData(1);
+    // ERROR_LOG(AMBASEBOARDDEBUG, "JVS-IO:Unknown");
+  }
+}
+
+void CSIDevice_AMBaseboard::JVSReset(JVSIORequest& request, JVSIOMessage& msg)
+{
+  if (*request.data++ == 0xD9)
+  {
+    NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:RESET");
+    m_gpo_delay = 0;
+    m_wheelinit = 0;
+    m_ic_card_state = 0x20;
+  }
+  msg.addData(1);
+
+  m_status_switches_1 |= 1;
+}
+
+void CSIDevice_AMBaseboard::JVSSetAddress(JVSIORequest& request, JVSIOMessage& msg)
+{
+  request.node = *request.data++;
+  NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:SET ADDRESS, node={}", request.node);
+  msg.addData(request.node == 1);
+  m_status_switches_1 &= ~1;
+}
+
 int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
 {
+  AMTimings::ScopedTimer timer(AMTimings::Subsystem::Baseboard);
+
   // Math inLength
   const auto& si = m_system.GetSerialInterface();
   u32 _iLength = ConvertSILengthField(si.GetInLength());
@@ -261,9 +1051,6 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
       u32 real_len = _pBuffer[iPosition];
       u32 p = 2;
 
-      static u32 d10_1 = 0xFE;
-      static u32 d10_0 = 0xFF;
-
       memset(res, 0, sizeof(res));
       res[resp++] = 1;
       res[resp++] = 1;
@@ -285,17 +1072,17 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
 
           /*baseboard test/service switches ???, disabled for a while
           if (PadStatus.button & PAD_BUTTON_Y)	// Test
-            d10_0 &= ~0x80;
+            m_status_switches_0 &= ~0x80;
           if (PadStatus.button & PAD_BUTTON_X)	// Service
-            d10_0 &= ~0x40;
+            m_status_switches_0 &= ~0x40;
           */
 
           // Horizontal Scanning Frequency switch
           // Required for F-Zero AX booting via Sega Boot
-          d10_0 &= ~0x20;
+          m_status_switches_0 &= ~0x20;
 
-          res[resp++] = d10_0;
-          res[resp++] = d10_1;
+          res[resp++] = m_status_switches_0;
+          res[resp++] = m_status_switches_1;
           break;
         }
         case 0x11:
@@ -407,8 +1194,8 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                            ptr(10), ptr(11), ptr(12), ptr(13), ptr(14));
 
             // Serial - Wheel
-            if (AMMediaboard::GetGameType() == MarioKartGP ||
-                AMMediaboard::GetGameType() == MarioKartGP2)
+            if (m_game_type == MarioKartGP ||
+                m_game_type == MarioKartGP2)
             {
               INFO_LOG_FMT(AMBASEBOARDDEBUG,
                            "GC-AM: Command 31 (WHEEL) {:02x}{:02x} {:02x}{:02x} {:02x} {:02x} "
@@ -454,7 +1241,7 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
             }
 
             // Serial Unknown
-            if (AMMediaboard::GetGameType() == GekitouProYakyuu)
+            if (m_game_type == GekitouProYakyuu)
             {
               u32 cmd = ptr(2) << 24;
               cmd |= ptr(3) << 16;
@@ -474,8 +1261,8 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
             }
 
             // Serial IC-CARD
-            if (AMMediaboard::GetGameType() == VirtuaStriker4 ||
-                AMMediaboard::GetGameType() == KeyOfAvalon)
+            if (m_game_type == VirtuaStriker4 ||
+                m_game_type == KeyOfAvalon)
             {
               u32 cmd = ptr(3);
 
@@ -725,8 +1512,8 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
             // All commands are OR'd with 0x80
             // Last byte (ptr(5)) is checksum which we don't care about
             u32 cmd = 0;
-            if (AMMediaboard::GetGameType() == FZeroAX ||
-                AMMediaboard::GetGameType() == FZeroAXMonster)
+            if (m_game_type == FZeroAX ||
+                m_game_type == FZeroAXMonster)
             {
               cmd = ptr(cmd_off + 2) << 24;
               cmd |= ptr(cmd_off + 3) << 16;
@@ -763,8 +1550,8 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
 
             cmd_off += 4;
 
-            if (AMMediaboard::GetGameType() == FZeroAX ||
-                AMMediaboard::GetGameType() == FZeroAXMonster)
+            if (m_game_type == FZeroAX ||
+                m_game_type == FZeroAXMonster)
             {
               // Status
               m_motorreply[cmd_off + 2] = 0;
@@ -867,7 +1654,7 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                 res[resp++] = 0x32;
                 u32 ReadLength = m_card_read_length - m_card_read;
 
-                if (AMMediaboard::GetGameType() == FZeroAX)
+                if (m_game_type == FZeroAX)
                 {
                   if (ReadLength > 0x2F)
                     ReadLength = 0x2F;
@@ -936,7 +1723,7 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                 res[resp++] = 0x00;  // 0x03
                 break;
               case CARDCommands::Eject:
-                if (AMMediaboard::GetGameType() == FZeroAX)
+                if (m_game_type == FZeroAX)
                 {
                   res[resp++] = 0x01;  // 0x02
                 }
@@ -1025,7 +1812,7 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                       //  }
                       //}
 
-                      if (AMMediaboard::GetGameType() == FZeroAX && m_card_memory_size)
+                      if (m_game_type == FZeroAX && m_card_memory_size)
                       {
                         m_card_state_call_count++;
                         if (m_card_state_call_count > 10)
@@ -1045,16 +1832,14 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                       }
                       else if (m_card_clean == 2)
                       {
-                        std::string card_filename(File::GetUserPath(D_TRIUSER_IDX) + "tricard_" +
-                                                  SConfig::GetInstance().GetGameID().c_str() +
-                                                  ".bin");
-
-                        if (File::Exists(card_filename))
+                        // An empty card file is the same as no card
+                        if (m_card_file.GetSize() != 0)
                         {
-                          m_card_memory_size = (u32)File::GetSize(card_filename);
+                          m_card_memory_size = static_cast<u32>(
+                              std::min<u64>(m_card_file.GetSize(), sizeof(m_card_memory)));
                           if (m_card_memory_size)
                           {
-                            if (AMMediaboard::GetGameType() == FZeroAX)
+                            if (m_game_type == FZeroAX)
                             {
                               m_card_bit = 2;
                             }
@@ -1088,20 +1873,15 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                       memset(m_card_read_packet, 0, 0xDB);
                       u32 POff = 0;
 
-                      std::string card_filename(File::GetUserPath(D_TRIUSER_IDX) + "tricard_" +
-                                                SConfig::GetInstance().GetGameID().c_str() +
-                                                ".bin");
-
-                      if (File::Exists(card_filename))
+                      if (m_card_file.GetSize() != 0)
                       {
-                        File::IOFile card = File::IOFile(card_filename, "rb+");
                         if (m_card_memory_size == 0)
                         {
-                          m_card_memory_size = (u32)card.GetSize();
+                          m_card_memory_size = static_cast<u32>(
+                              std::min<u64>(m_card_file.GetSize(), sizeof(m_card_memory)));
                         }
 
-                        card.ReadBytes(m_card_memory, m_card_memory_size);
-                        card.Close();
+                        m_card_file.Read(0, m_card_memory, m_card_memory_size);
 
                         m_card_is_inserted = 1;
                       }
@@ -1149,13 +1929,7 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
 
                       NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "GC-AM: CARDWrite: {}", m_card_memory_size);
 
-                      std::string card_filename(File::GetUserPath(D_TRIUSER_IDX) + "tricard_" +
-                                                SConfig::GetInstance().GetGameID().c_str() +
-                                                ".bin");
-
-                      File::IOFile card = File::IOFile(card_filename, "wb+");
-                      card.WriteBytes(m_card_memory, m_card_memory_size);
-                      card.Close();
+                      m_card_file.Assign(m_card_memory, m_card_memory_size);
 
                       m_card_bit = 2;
 
@@ -1173,14 +1947,14 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
                       break;
                     case CARDCommands::Eject:
                       NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "GC-AM: Command CARD Eject");
-                      if (AMMediaboard::GetGameType() != FZeroAX)
+                      if (m_game_type != FZeroAX)
                       {
                         m_card_bit = 0;
                       }
                       break;
                     case CARDCommands::SetShutter:
                       NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "GC-AM: Command CARD ShutterSet");
-                      if (AMMediaboard::GetGameType() != FZeroAX)
+                      if (m_game_type != FZeroAX)
                       {
                         m_card_bit = 0;
                       }
@@ -1227,660 +2001,22 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
               AMBASEBOARDDEBUG,
               "GC-AM: Command {:02x}, {:02x} {:02x} {:02x} {:02x} {:02x} {:02x} {:02x} (JVS IO)",
               ptr(0), ptr(1), ptr(2), ptr(3), ptr(4), ptr(5), ptr(6), ptr(7));
-          int pptr = 2;
           JVSIOMessage msg;
 
           msg.start(0);
           msg.addData(1);
 
-          static u8 RXReply = 0;
-          static int delay = 0;
-
           unsigned char jvs_io_buffer[0x80];
-          int nr_bytes = ptr(pptr + 2);  // byte after E0 xx
+          int nr_bytes = ptr(4);  // byte after E0 xx
           int jvs_io_length = 0;
 
-          for (int i = 0; i < nr_bytes + 3; ++i)
-            jvs_io_buffer[jvs_io_length++] = ptr(pptr + i);
-
-          int node = jvs_io_buffer[1];
-
-          unsigned char* jvs_io = jvs_io_buffer + 3;
-          jvs_io_length--;  // checksum
-
-          while (jvs_io < (jvs_io_buffer + jvs_io_length))
-          {
-            int cmd = *jvs_io++;
-            DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:node={}, command={:02x}", node, cmd);
-
-            switch (JVSIOCommands(cmd))
-            {
-            case JVSIOCommands::IOID:
-              msg.addData(1);
-              switch (AMMediaboard::GetGameType())
-              {
-              case FZeroAX:
-              case FZeroAXMonster:
-                // Specific version that enables DX mode on AX machines
-                msg.addData("SEGA ENTERPRISES,LTD.;837-13844-01 I/O CNTL BD2 ;");
-                break;
-              case MarioKartGP:
-              case MarioKartGP2:
-              default:
-                msg.addData("namco ltd.;FCA-1;Ver1.01;JPN,Multipurpose + Rotary Encoder");
-                break;
-              case VirtuaStriker3:
-              case VirtuaStriker4:
-                msg.addData("SEGA ENTERPRISES,LTD.;I/O BD JVS;837-13551;Ver1.00");
-                break;
-              }
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO: Command 10, BoardID");
-              msg.addData((u32)0);
-              break;
-            case JVSIOCommands::CommandRevision:
-              msg.addData(1);
-              msg.addData(0x11);
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO: Command 11, CMDFormatRevision");
-              break;
-            case JVSIOCommands::JVRevision:
-              msg.addData(1);
-              msg.addData(0x20);
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:  Command 12, Revision");
-              break;
-            case JVSIOCommands::CommunicationVersion:
-              msg.addData(1);
-              msg.addData(0x10);
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:  Command 13, COMVersion");
-              break;
-
-              // Slave features
-              /*
-                0x01: Player count, Bit per channel
-                0x02: Coin slots
-                0x03: Analog-in
-                0x04: Rotary
-                0x05: Keycode
-                0x06: Screen, x, y, ch
-                ....: unused
-                0x10: Card
-                0x11: Hopper-out
-                0x12: Driver-out
-                0x13: Analog-out
-                0x14: Character, Line (?)
-                0x15: Backup
-              */
-            case JVSIOCommands::CheckFunctionality:
-              msg.addData(1);
-              switch (AMMediaboard::GetGameType())
-              {
-              case FZeroAX:
-              case FZeroAXMonster:
-                // 2 Player (12bit) (p2=paddles), 1 Coin slot, 6 Analog-in
-                // msg.addData((void *)"\x01\x02\x0C\x00", 4);
-                // msg.addData((void *)"\x02\x01\x00\x00", 4);
-                // msg.addData((void *)"\x03\x06\x00\x00", 4);
-                // msg.addData((void *)"\x00\x00\x00\x00", 4);
-
-                /*
-                  01 02 0c 00
-                  02 02 00 00
-                  03 08 00 00
-                  12 16 00 00
-                */
-
-                // DX Version: 2 Player (22bit) (p2=paddles), 2 Coin slot, 8 Analog-in,
-                // 22 Driver-out
-                msg.addData((void*)"\x01\x02\x12\x00", 4);
-                msg.addData((void*)"\x02\x02\x00\x00", 4);
-                msg.addData((void*)"\x03\x08\x0A\x00", 4);
-                msg.addData((void*)"\x12\x16\x00\x00", 4);
-                msg.addData((void*)"\x00\x00\x00\x00", 4);
-                break;
-              case VirtuaStriker3:
-              case GekitouProYakyuu:
-                // 2 Player (13bit), 2 Coin slot, 4 Analog-in, 1 CARD, 8 Driver-out
-                msg.addData((void*)"\x01\x02\x0D\x00", 4);
-                msg.addData((void*)"\x02\x02\x00\x00", 4);
-                msg.addData((void*)"\x03\x04\x00\x00", 4);
-                msg.addData((void*)"\x10\x01\x00\x00", 4);
-                msg.addData((void*)"\x12\x08\x00\x00", 4);
-                msg.addData((void*)"\x00\x00\x00\x00", 4);
-                break;
-              case MarioKartGP:
-              case MarioKartGP2:
-              default:
-                // 1 Player (15bit), 1 Coin slot, 3 Analog-in, 1 CARD, 1 Driver-out
-                msg.addData((void*)"\x01\x01\x0F\x00", 4);
-                msg.addData((void*)"\x02\x01\x00\x00", 4);
-                msg.addData((void*)"\x03\x03\x00\x00", 4);
-                msg.addData((void*)"\x10\x01\x00\x00", 4);
-                msg.addData((void*)"\x12\x01\x00\x00", 4);
-                msg.addData((void*)"\x00\x00\x00\x00", 4);
-                break;
-              case VirtuaStriker4:
-                // 2 Player (13bit), 1 Coin slot, 4 Analog-in, 1 CARD
-                msg.addData((void*)"\x01\x02\x0D\x00", 4);
-                msg.addData((void*)"\x02\x01\x00\x00", 4);
-                msg.addData((void*)"\x03\x04\x00\x00", 4);
-                msg.addData((void*)"\x10\x01\x00\x00", 4);
-                msg.addData((void*)"\x00\x00\x00\x00", 4);
-                break;
-              }
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:  Command 14, SlaveFeatures");
-              break;
-            case JVSIOCommands::MainID:
-              while (*jvs_io++)
-              {
-              };
-              msg.addData(1);
-              break;
-            case JVSIOCommands::SwitchesInput:
-            {
-              int player_count = *jvs_io++;
-              int player_byte_count = *jvs_io++;
-
-              DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:  Command 20, SwitchInputs: {} {}",
-                            player_count, player_byte_count);
+          for (int i = 0; i < nr_bytes + 3 && i < static_cast<int>(sizeof(jvs_io_buffer)); ++i)
+            jvs_io_buffer[jvs_io_length++] = ptr(2 + i);
 
-              msg.addData(1);
-
-              GCPadStatus PadStatus;
-              PadStatus = Pad::GetStatus(0);
-
-              // Test button
-              if (PadStatus.button & PAD_TRIGGER_Z)
-                msg.addData(0x80);
-              else
-                msg.addData((u32)0x00);
-
-              for (int i = 0; i < player_count; ++i)
-              {
-                unsigned char player_data[3] = {0, 0, 0};
-
-                switch (AMMediaboard::GetGameType())
-                {
-                // Controller configuration for F-Zero AX (DX)
-                case FZeroAX:
-                  PadStatus = Pad::GetStatus(0);
-                  if (i == 0)
-                  {
-                    if (m_fzdx_seatbelt)
-                    {
-                      player_data[0] |= 0x01;
-                    }
-
-                    // Start
-                    if (PadStatus.button & PAD_BUTTON_START)
-                      player_data[0] |= 0x80;
-                    // Service button
-                    if (PadStatus.button & PAD_BUTTON_X)
-                      player_data[0] |= 0x40;
-                    // Boost
-                    if (PadStatus.button & PAD_BUTTON_Y)
-                      player_data[0] |= 0x02;
-                    // View Change 1
-                    if (PadStatus.button & PAD_BUTTON_RIGHT)
-                      player_data[0] |= 0x20;
-                    // View Change 2
-                    if (PadStatus.button & PAD_BUTTON_LEFT)
-                      player_data[0] |= 0x10;
-                    // View Change 3
-                    if (PadStatus.button & PAD_BUTTON_UP)
-                      player_data[0] |= 0x08;
-                    // View Change 4
-                    if (PadStatus.button & PAD_BUTTON_DOWN)
-                      player_data[0] |= 0x04;
-                    player_data[1] = RXReply & 0xF0;
-                  }
-                  else if (i == 1)
-                  {
-                    //  Paddle left
-                    if (PadStatus.button & PAD_BUTTON_A)
-                      player_data[0] |= 0x20;
-                    //  Paddle right
-                    if (PadStatus.button & PAD_BUTTON_B)
-                      player_data[0] |= 0x10;
-
-                    if (m_fzdx_motion_stop)
-                    {
-                      player_data[0] |= 2;
-                    }
-                    if (m_fzdx_sensor_right)
-                    {
-                      player_data[0] |= 4;
-                    }
-                    if (m_fzdx_sensor_left)
-                    {
-                      player_data[0] |= 8;
-                    }
-
-                    player_data[1] = RXReply << 4;
-                  }
-                  break;
-                // Controller configuration for F-Zero AX MonsterRide
-                case FZeroAXMonster:
-                  PadStatus = Pad::GetStatus(0);
-                  if (i == 0)
-                  {
-                    if (m_fzcc_sensor)
-                    {
-                      player_data[0] |= 0x01;
-                    }
-
-                    // Start
-                    if (PadStatus.button & PAD_BUTTON_START)
-                      player_data[0] |= 0x80;
-                    // Service button
-                    if (PadStatus.button & PAD_BUTTON_X)
-                      player_data[0] |= 0x40;
-                    // Boost
-                    if (PadStatus.button & PAD_BUTTON_Y)
-                      player_data[0] |= 0x02;
-                    // View Change 1
-                    if (PadStatus.button & PAD_BUTTON_RIGHT)
-                      player_data[0] |= 0x20;
-                    // View Change 2
-                    if (PadStatus.button & PAD_BUTTON_LEFT)
-                      player_data[0] |= 0x10;
-                    // View Change 3
-                    if (PadStatus.button & PAD_BUTTON_UP)
-                      player_data[0] |= 0x08;
-                    // View Change 4
-                    if (PadStatus.button & PAD_BUTTON_DOWN)
-                      player_data[0] |= 0x04;
-
-                    player_data[1] = RXReply & 0xF0;
-                  }
-                  else if (i == 1)
-                  {
-                    //  Paddle left
-                    if (PadStatus.button & PAD_BUTTON_A)
-                      player_data[0] |= 0x20;
-                    //  Paddle right
-                    if (PadStatus.button & PAD_BUTTON_B)
-                      player_data[0] |= 0x10;
-
-                    if (m_fzcc_seatbelt)
-                    {
-                      player_data[0] |= 2;
-                    }
-                    if (m_fzcc_service)
-                    {
-                      player_data[0] |= 4;
-                    }
-                    if (m_fzcc_emergency)
-                    {
-                      player_data[0] |= 8;
-                    }
-                  }
-                  break;
-                // Controller configuration for Virtua Striker 3 games
-                case VirtuaStriker3:
-                  PadStatus = Pad::GetStatus(i);
-                  // Start
-                  if (PadStatus.button & PAD_BUTTON_START)
-                    player_data[0] |= 0x80;
-                  // Service button
-                  if (PadStatus.button & PAD_BUTTON_X)
-                    player_data[0] |= 0x40;
-                  // Long Pass
-                  if (PadStatus.button & PAD_TRIGGER_L)
-                    player_data[0] |= 0x01;
-                  // Short Pass
-                  if (PadStatus.button & PAD_TRIGGER_R)
-                    player_data[1] |= 0x80;
-                  // Shoot
-                  if (PadStatus.button & PAD_BUTTON_A)
-                    player_data[0] |= 0x02;
-                  // Left
-                  if (PadStatus.button & PAD_BUTTON_LEFT)
-                    player_data[0] |= 0x08;
-                  // Up
-                  if (PadStatus.button & PAD_BUTTON_UP)
-                    player_data[0] |= 0x20;
-                  // Right
-                  if (PadStatus.button & PAD_BUTTON_RIGHT)
-                    player_data[0] |= 0x04;
-                  // Down
-                  if (PadStatus.button & PAD_BUTTON_DOWN)
-                    player_data[0] |= 0x10;
-                  break;
-                // Controller configuration for Virtua Striker 4 games
-                case VirtuaStriker4:
-                {
-                  PadStatus = Pad::GetStatus(i);
-                  // Start
-                  if (PadStatus.button & PAD_BUTTON_START)
-                    player_data[0] |= 0x80;
-                  // Service button
-                  if (PadStatus.button & PAD_BUTTON_X)
-                    player_data[0] |= 0x40;
-                  // Long Pass
-                  if (PadStatus.button & PAD_TRIGGER_L)
-                    player_data[0] |= 0x01;
-                  // Short Pass
-                  if (PadStatus.button & PAD_TRIGGER_R)
-                    player_data[0] |= 0x02;
-                  // Shoot
-                  if (PadStatus.button & PAD_BUTTON_A)
-                    player_data[1] |= 0x80;
-                  // Dash
-                  if (PadStatus.button & PAD_BUTTON_B)
-                    player_data[1] |= 0x40;
-                  // Tactics (U)
-                  if (PadStatus.button & PAD_BUTTON_LEFT)
-                    player_data[0] |= 0x20;
-                  // Tactics (M)
-                  if (PadStatus.button & PAD_BUTTON_UP)
-                    player_data[0] |= 0x08;
-                  // Tactics (D)
-                  if (PadStatus.button & PAD_BUTTON_RIGHT)
-                    player_data[0] |= 0x04;
-
-                  if (i == 0)
-                  {
-                    player_data[0] |= 0x10;  // IC-Card Switch ON
-
-                    // IC-Card Lock
-                    if (PadStatus.button & PAD_BUTTON_DOWN)
-                      player_data[1] |= 0x20;
-                  }
-                }
-                break;
-                // Controller configuration for Gekitou Pro Yakyuu
-                case GekitouProYakyuu:
-                  PadStatus = Pad::GetStatus(i);
-                  // Start
-                  if (PadStatus.button & PAD_BUTTON_START)
-                    player_data[0] |= 0x80;
-                  // Service button
-                  if (PadStatus.button & PAD_BUTTON_X)
-                    player_data[0] |= 0x40;
-                  //  A
-                  if (PadStatus.button & PAD_BUTTON_B)
-                    player_data[0] |= 0x01;
-                  //  B
-                  if (PadStatus.button & PAD_BUTTON_A)
-                    player_data[0] |= 0x02;
-                  //  Gekitou
-                  if (PadStatus.button & PAD_TRIGGER_L)
-                    player_data[1] |= 0x80;
-                  // Left
-                  if (PadStatus.button & PAD_BUTTON_LEFT)
-                    player_data[0] |= 0x08;
-                  // Up
-                  if (PadStatus.button & PAD_BUTTON_UP)
-                    player_data[0] |= 0x20;
-                  // Right
-                  if (PadStatus.button & PAD_BUTTON_RIGHT)
-                    player_data[0] |= 0x04;
-                  // Down
-                  if (PadStatus.button & PAD_BUTTON_DOWN)
-                    player_data[0] |= 0x10;
-                  break;
-                // Controller configuration for Mario Kart and other games
-                default:
-                case MarioKartGP:
-                case MarioKartGP2:
-                {
-                  PadStatus = Pad::GetStatus(0);
-                  // Start
-                  if (PadStatus.button & PAD_BUTTON_START)
-                    player_data[0] |= 0x80;
-                  // Service button
-                  if (PadStatus.button & PAD_BUTTON_X)
-                    player_data[0] |= 0x40;
-                  // Item button
-                  if (PadStatus.button & PAD_BUTTON_A)
-                    player_data[1] |= 0x20;
-                  // VS-Cancel button
-                  if (PadStatus.button & PAD_BUTTON_B)
-                    player_data[1] |= 0x02;
-                }
-                break;
-                }
-
-                for (int j = 0; j < player_byte_count; ++j)
-                  msg.addData(player_data[j]);
-              }
-              break;
-            }
-            case JVSIOCommands::CoinInput:
-            {
-              int slots = *jvs_io++;
-              msg.addData(1);
-              for (int i = 0; i < slots; i++)
-              {
-                GCPadStatus PadStatus;
-                PadStatus = Pad::GetStatus(i);
-                if ((PadStatus.button & PAD_TRIGGER_Z) && !m_coin_pressed[i])
-                {
-                  m_coin[i]++;
-                }
-                m_coin_pressed[i] = PadStatus.button & PAD_TRIGGER_Z;
-                msg.addData((m_coin[i] >> 8) & 0x3f);
-                msg.addData(m_coin[i] & 0xff);
-              }
-              // NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:Get Coins Slots:{} Unk:{}", slots, unk );
-              break;
-            }
-            case JVSIOCommands::AnalogInput:
-            {
-              msg.addData(1);  // status
-
-              int analogs = *jvs_io++;
-              GCPadStatus PadStatus;
-              GCPadStatus PadStatus2;
-              PadStatus = Pad::GetStatus(0);
-
-              DEBUG_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:Get Analog Inputs Analogs:{}", analogs);
-
-              switch (AMMediaboard::GetGameType())
-              {
-              case FZeroAX:
-              case FZeroAXMonster:
-                // Steering
-                if (m_motorinit == 1)
-                {
-                  if (m_motorforce_x > 0)
-                  {
-                    msg.addData(0x80 - (m_motorforce_x >> 8));
-                  }
-                  else
-                  {
-                    msg.addData((m_motorforce_x >> 8));
-                  }
-                  msg.addData((u8)0);
-
-                  msg.addData(PadStatus.stickY);
-                  msg.addData((u8)0);
-                }
-                else
-                {
-                  msg.addData(PadStatus.stickX);
-                  msg.addData((u8)0);
-
-                  msg.addData(PadStatus.stickY);
-                  msg.addData((u8)0);
-                }
-
-                // Unused
-                msg.addData((u8)0);
-                msg.addData((u8)0);
-                msg.addData((u8)0);
-                msg.addData((u8)0);
-
-                // Gas
-                msg.addData(PadStatus.triggerRight);
-                msg.addData((u8)0);
-
-                // Brake
-                msg.addData(PadStatus.triggerLeft);
-                msg.addData((u8)0);
-
-                msg.addData((u8)0x80);  // Motion Stop
-                msg.addData((u8)0);
-
-                msg.addData((u8)0);
-                msg.addData((u8)0);
-
-                break;
-              case VirtuaStriker3:
-              case VirtuaStriker4:
-              {
-                PadStatus2 = Pad::GetStatus(1);
-
-                msg.addData(PadStatus.stickX);
-                msg.addData((u8)0);
-                msg.addData(PadStatus.stickY);
-                msg.addData((u8)0);
-
-                msg.addData(PadStatus2.stickX);
-                msg.addData((u8)0);
-                msg.addData(PadStatus2.stickY);
-                msg.addData((u8)0);
-              }
-              break;
-              default:
-              case MarioKartGP:
-              case MarioKartGP2:
-                // Steering
-                msg.addData(PadStatus.stickX);
-                msg.addData((u8)0);
-
-                // Gas
-                msg.addData(PadStatus.triggerRight);
-                msg.addData((u8)0);
-
-                // Brake
-                msg.addData(PadStatus.triggerLeft);
-                msg.addData((u8)0);
-                break;
-              }
-              break;
-            }
-            case JVSIOCommands::CoinSubOutput:
-            {
-              u32 slot = *jvs_io++;
-              m_coin[slot] -= (*jvs_io++ << 8) | *jvs_io++;
-              msg.addData(1);
-              break;
-            }
-            case JVSIOCommands::GeneralDriverOutput:
-            {
-              u32 bytes = *jvs_io++;
-              if (bytes)
-              {
-                u8* buf = new u8[bytes];
-
-                for (u32 i = 0; i < bytes; ++i)
-                {
-                  buf[i] = *jvs_io++;
-                }
-
-                DEBUG_LOG_FMT(
-                    AMBASEBOARDDEBUG,
-                    "JVS-IO: Command 32, GPO: {:02x} {:02x} {} {:02x}{:02x}{:02x} ({:02x})", delay,
-                    RXReply, bytes, buf[0], buf[1], buf[2], Common::swap16(*(u16*)(buf + 1)) >> 2);
-
-                // TODO: figure this out
-
-                u8 trepl[] = {
-                    0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90, 0xA0, 0xB0, 0xC0,
-                    0xD0, 0xE0, 0xF0, 0x01, 0x11, 0x21, 0x31, 0x41, 0x51, 0x61, 0x71, 0x81, 0x91,
-                    0xA1, 0xB1, 0xC1, 0xD1, 0xE1, 0xF1, 0x02, 0x12, 0x22, 0x32, 0x42, 0x52, 0x62,
-                    0x72, 0x82, 0x92, 0xA2, 0xB2, 0xC2, 0xD2, 0xE2, 0xF2, 0x04, 0x14, 0x24, 0x34,
-                    0x44, 0x54, 0x64, 0x74, 0x84, 0x94, 0xA4, 0xB4, 0xC4, 0xD4, 0xE4, 0xF4, 0x05,
-                    0x15, 0x25, 0x35, 0x45, 0x55, 0x65, 0x75, 0x85, 0x95, 0xA5, 0xB5, 0xC5, 0xD5,
-                    0xE5, 0xF5, 0x06, 0x16, 0x26, 0x36, 0x46, 0x56, 0x66, 0x76, 0x86, 0x96, 0xA6,
-                    0xB6, 0xC6, 0xD6, 0xE6, 0xF6, 0x08, 0x18, 0x28, 0x38, 0x48, 0x58, 0x68, 0x78,
-                    0x88, 0x98, 0xA8, 0xB8, 0xC8, 0xD8, 0xE8, 0xF8, 0x09, 0x19, 0x29, 0x39, 0x49,
-                    0x59, 0x69, 0x79, 0x89, 0x99, 0xA9, 0xB9, 0xC9, 0xD9, 0xE9, 0xF9, 0x0A, 0x1A,
-                    0x2A, 0x3A, 0x4A, 0x5A, 0x6A, 0x7A, 0x8A, 0x9A, 0xAA, 0xBA, 0xCA, 0xDA, 0xEA,
-                    0xFA, 0x0C, 0x1C, 0x2C, 0x3C, 0x4C, 0x5C, 0x6C, 0x7C, 0x8C, 0x9C, 0xAC, 0xBC,
-                    0xCC, 0xDC, 0xEC, 0xFC, 0x0D, 0x1D, 0x2D, 0x3D, 0x4D, 0x5D, 0x6D, 0x7D, 0x8D,
-                    0x9D, 0xAD, 0xBD, 0xCD, 0xDD, 0xED, 0xFD, 0x0E, 0x1E, 0x2E, 0x3E, 0x4E, 0x5E,
-                    0x6E, 0x7E, 0x8E, 0x9E, 0xAE, 0xBE, 0xCE, 0xDE, 0xEE, 0xFE};
-
-                static u32 off = 0;
-                if (off > sizeof(trepl))
-                  off = 0;
-
-                switch (Common::swap16(*(u16*)(buf + 1)) >> 2)
-                {
-                case 0x70:
-                  delay++;
-                  if ((delay % 10) == 0)
-                  {
-                    RXReply = trepl[off++];
-                  }
-                  break;
-                default:
-                case 0x60:
-                case 0xA0:
-                case 0xF0:
-                  RXReply = 0;
-                  break;
-                }
-                ////if( buf[1] == 1 && buf[2] == 0x80 )
-                ////{
-                ////  INFO_LOG_FMT(DVDINTERFACE, "GCAM: PC:{:08x}", PC);
-                ////  PowerPC::breakpoints.Add( PC+8, false );
-                ////}
-
-                delete[] buf;
-              }
-              msg.addData(1);
-              break;
-            }
-            case JVSIOCommands::CoinAddOutput:
-            {
-              int slot = *jvs_io++;
-              m_coin[slot] += (*jvs_io++ << 8) | *jvs_io++;
-              msg.addData(1);
-              break;
-            }
-            case JVSIOCommands::NAMCOCommand:
-            {
-              int cmd_ = *jvs_io++;
-              if (cmd_ == 0x18)
-              {  // id check
-                jvs_io += 4;
-                msg.addData(1);
-                msg.addData(0xff);
-              }
-              else
-              {
-                msg.addData(1);
-                // ERROR_LOG(AMBASEBOARDDEBUG, "JVS-IO:Unknown");
-              }
-              break;
-            }
-            case JVSIOCommands::Reset:
-              if (*jvs_io++ == 0xD9)
-              {
-                NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:RESET");
-                delay = 0;
-                m_wheelinit = 0;
-                m_ic_card_state = 0x20;
-              }
-              msg.addData(1);
-
-              d10_1 |= 1;
-              break;
-            case JVSIOCommands::SetAddress:
-              node = *jvs_io++;
-              NOTICE_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO:SET ADDRESS, node={}", node);
-              msg.addData(node == 1);
-              d10_1 &= ~1;
-              break;
-            default:
-              ERROR_LOG_FMT(AMBASEBOARDDEBUG, "JVS-IO: node={}, command={:02x}", node, cmd);
-              break;
-            }
-
-            pptr += jvs_io_length;
-          }
+          // Without the checksum
+          JVSIORequest request{jvs_io_buffer + 3, jvs_io_buffer + jvs_io_length - 1,
+                               jvs_io_buffer[1]};
+          ProcessJVSIO(request, msg);
 
           msg.end();
 
@@ -1927,17 +2063,14 @@ int CSIDevice_AMBaseboard::RunBuffer(u8* _pBuffer, int request_length)
 
       // (tmbinc) hotfix: delay output by one command to work around their broken parser. this took
       // me a month to find. ARG!
-      static unsigned char last[2][0x80];
-      static int lastptr[2];
-
       {
-        memcpy(last + 1, _pBuffer, 0x80);
-        memcpy(_pBuffer, last, 0x80);
-        memcpy(last, last + 1, 0x80);
+        memcpy(m_last_reply[1], _pBuffer, 0x80);
+        memcpy(_pBuffer, m_last_reply[0], 0x80);
+        memcpy(m_last_reply[0], m_last_reply[1], 0x80);
 
-        lastptr[1] = _iLength;
-        _iLength = lastptr[0];
-        lastptr[0] = lastptr[1];
+        m_last_reply_length[1] = _iLength;
+        _iLength = m_last_reply_length[0];
+        m_last_reply_length[0] = m_last_reply_length[1];
       }
 
       iPosition = _iLength;
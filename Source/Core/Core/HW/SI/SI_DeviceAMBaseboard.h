@@ -2,14 +2,17 @@
 #pragma once
 
 #include <SFML/Network.hpp>
+#include <array>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
+#include "Core/HW/DVD/AMBackingFile.h"
 #include "Core/HW/SI/SI_Device.h"
 
 namespace SerialInterface
@@ -19,6 +22,13 @@ namespace SerialInterface
 class JVSIOMessage
 {
 public:
+  // Reply data that is already escaped, along with its checksum, see addEncoded
+  struct EncodedData
+  {
+    std::vector<u8> data;
+    u32 csum = 0;
+  };
+
   u32 m_ptr, m_last_start, m_csum;
   u8 m_msg[0x80];
 
@@ -28,7 +38,10 @@ public:
   void addData(const void* data, size_t len);
   void addData(const char* data);
   void addData(u32 n);
+  void addEncoded(const EncodedData& encoded);
   void end();
+
+  static EncodedData encode(const u8* data, size_t len);
 };  // end class JVSIOMessage
 
 // triforce (GC-AM) baseboard
@@ -111,6 +124,17 @@ private:
     WritePages = 0x35,
   };
 
+  // Commands of the JVS-IO packet being processed
+  struct JVSIORequest
+  {
+    const u8* data;
+    const u8* end;
+    int node;
+  };
+
+  using JVSIOHandler = void (CSIDevice_AMBaseboard::*)(JVSIORequest& request,
+                                                       JVSIOMessage& msg);
+
   union ICCommand
   {
     u8 data[64 + 4 + 4 + 4];
@@ -129,6 +153,23 @@ private:
     };
   };
 
+  // Cached AMMediaboard::GetGameType()
+  u32 m_game_type;
+
+  // Replies to the JVS-IO commands that only describe the I/O board, indexed by command.
+  // Commands without a cached reply go through m_jvs_handlers.
+  std::array<JVSIOMessage::EncodedData, 0x100> m_jvs_cached_replies;
+  std::array<JVSIOHandler, 0x100> m_jvs_handlers{};
+
+  // Baseboard switches, see command 0x10
+  u32 m_status_switches_0;
+  u32 m_status_switches_1;
+
+  // JVS general purpose output state, see JVSGeneralDriverOutput
+  u8 m_rx_reply;
+  u32 m_rx_reply_offset;
+  int m_gpo_delay;
+
   u16 m_coin[2];
   u32 m_coin_pressed[2];
 
@@ -153,6 +194,8 @@ private:
   u32 m_card_bit;
   u32 m_card_state_call_count;
   u8 m_card_offset;
+  // tricard_<game id>.bin
+  AMMediaboard::BackingFile m_card_file;
 
   u32 m_wheelinit;
 
@@ -172,8 +215,26 @@ private:
   u32 m_fzcc_emergency;
   u32 m_fzcc_service;
 
+  // Replies are sent back one command late, see RunBuffer
+  u8 m_last_reply[2][0x80];
+  u32 m_last_reply_length[2];
+
   void ICCardSendReply(ICCommand* iccommand, u8* buffer, u32* length);
 
+  void SetupJVSIO();
+  void ProcessJVSIO(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSMainID(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSSwitchesInput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSCoinInput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSAnalogInput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSCoinSubOutput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSGeneralDriverOutput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSCoinAddOutput(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSNAMCOCommand(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSReset(JVSIORequest& request, JVSIOMessage& msg);
+  void JVSSetAddress(JVSIORequest& request, JVSIOMessage& msg);
+  void GetPlayerSwitches(int player, u8* player_data);
+
 public:
   // constructor
   CSIDevice_AMBaseboard(Core::System& system, SIDevices device, int device_number);
@@ -186,6 +247,8 @@ public:
 
   // send a command directly
   void SendCommand(u32 command, u8 poll) override;
+
+  void DoState(PointerWrap& p) override;
 };
 
 }  // namespace SerialInterface
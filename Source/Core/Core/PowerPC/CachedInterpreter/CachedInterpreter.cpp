@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <utility>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -53,6 +55,27 @@ void CachedInterpreter::ExecuteOneBlock()
     return;
   }
 
+  ExecuteBlock(normal_entry);
+}
+
+void CachedInterpreter::CompileAndExecuteOneBlock()
+{
+  const u8* normal_entry = m_block_cache.Dispatch();
+  if (!normal_entry)
+  {
+    Jit(m_ppc_state.pc);
+
+    // Translating the address may have raised an ISI, which moved the PC to the exception handler
+    normal_entry = m_block_cache.Dispatch();
+    if (!normal_entry)
+      return;
+  }
+
+  ExecuteBlock(normal_entry);
+}
+
+void CachedInterpreter::ExecuteBlock(const u8* normal_entry)
+{
   auto& ppc_state = m_ppc_state;
   while (true)
   {
@@ -182,7 +205,52 @@ s32 CachedInterpreter::CheckIdle(PowerPC::PowerPCState& ppc_state,
 {
   const auto& [core_timing, idle_pc] = operands;
   if (ppc_state.npc == idle_pc)
-    core_timing.Idle();
+    core_timing.Idle(idle_pc);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool write_pc, CachedInterpreter::InterpreterOp... instructions>
+s32 CachedInterpreter::InterpretSequence(
+    PowerPC::PowerPCState& ppc_state,
+    const InterpretSequenceOperands<sizeof...(instructions)>& operands)
+{
+  static constexpr std::size_t count = sizeof...(instructions);
+  static constexpr std::array<InterpreterOp, count> funcs = {instructions...};
+
+  // The calls are direct, only the last instruction may need the PC
+  [&]<std::size_t... i>(std::index_sequence<i...>) {
+    (funcs[i](operands.interpreter, operands.insts[i]), ...);
+  }(std::make_index_sequence<count - 1>());
+  if constexpr (write_pc)
+  {
+    ppc_state.pc = operands.last_pc;
+    ppc_state.npc = operands.last_pc + 4;
+  }
+  funcs[count - 1](operands.interpreter, operands.insts[count - 1]);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::LoadImmediate(PowerPC::PowerPCState& ppc_state,
+                                     const LoadImmediateOperands& operands)
+{
+  const auto& [rd, imm] = operands;
+  ppc_state.gpr[rd] = imm;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::AddImmediate(PowerPC::PowerPCState& ppc_state,
+                                    const AddImmediateOperands& operands)
+{
+  const auto& [rd, ra, imm] = operands;
+  ppc_state.gpr[rd] = ppc_state.gpr[ra] + imm;
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::MoveRegister(PowerPC::PowerPCState& ppc_state,
+                                    const MoveRegisterOperands& operands)
+{
+  const auto& [ra, rs] = operands;
+  ppc_state.gpr[ra] = ppc_state.gpr[rs];
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
@@ -204,6 +272,143 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   return true;
 }
 
+void CachedInterpreter::CountInstruction(const PPCAnalyst::CodeOp& op)
+{
+  js.downcountAmount += op.opinfo->num_cycles;
+  if (op.opinfo->flags & FL_LOADSTORE)
+    ++js.numLoadStoreInst;
+  if (op.opinfo->flags & FL_USE_FPU)
+    ++js.numFloatingPointInst;
+}
+
+template <CachedInterpreter::InterpreterOp... instructions>
+constexpr CachedInterpreter::Superinstruction CachedInterpreter::MakeSuperinstruction()
+{
+  return {{instructions...},
+          sizeof...(instructions),
+          &CachedInterpreter::WriteInterpretSequence<instructions...>};
+}
+
+bool CachedInterpreter::CanFuseInstruction(const PPCAnalyst::CodeOp& op, bool first, bool last)
+{
+  if (op.skip)
+    return false;
+
+  // These need callbacks of their own right after the instruction
+  if (!last && (op.canEndBlock || op.branchIsIdleLoop))
+    return false;
+  if ((jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
+      (!op.canEndBlock && ShouldHandleFPExceptionForInstruction(&op)))
+  {
+    return false;
+  }
+
+  // The first instruction already went through these checks in DoJit
+  if (first)
+    return true;
+  if (!js.firstFPInstructionFound && (op.opinfo->flags & FL_USE_FPU) != 0)
+    return false;
+  return !HLE::TryReplaceFunction(m_ppc_symbol_db, op.address, PowerPC::CoreMode::JIT);
+}
+
+u32 CachedInterpreter::WriteSuperinstruction(u32 index)
+{
+  // Longer sequences come first, so that they are preferred over their prefixes
+  static constexpr std::array superinstructions = {
+      // Load, compare and branch
+      MakeSuperinstruction<Interpreter::lwz, Interpreter::cmpi, Interpreter::bcx>(),
+      MakeSuperinstruction<Interpreter::lwz, Interpreter::cmpli, Interpreter::bcx>(),
+      MakeSuperinstruction<Interpreter::lbz, Interpreter::cmpli, Interpreter::bcx>(),
+      // Compare and branch
+      MakeSuperinstruction<Interpreter::cmpi, Interpreter::bcx>(),
+      MakeSuperinstruction<Interpreter::cmpli, Interpreter::bcx>(),
+      MakeSuperinstruction<Interpreter::cmp, Interpreter::bcx>(),
+      MakeSuperinstruction<Interpreter::cmpl, Interpreter::bcx>(),
+      // Address computations and memory accesses
+      MakeSuperinstruction<Interpreter::addi, Interpreter::lwz>(),
+      MakeSuperinstruction<Interpreter::addi, Interpreter::stw>(),
+      MakeSuperinstruction<Interpreter::lwz, Interpreter::addi>(),
+      MakeSuperinstruction<Interpreter::rlwinmx, Interpreter::lwzx>(),
+      MakeSuperinstruction<Interpreter::lwz, Interpreter::lwz>(),
+      MakeSuperinstruction<Interpreter::stw, Interpreter::stw>(),
+      MakeSuperinstruction<Interpreter::addi, Interpreter::addi>(),
+      // Paired single and floating point loads and arithmetic
+      MakeSuperinstruction<Interpreter::psq_l, Interpreter::ps_mul>(),
+      MakeSuperinstruction<Interpreter::psq_l, Interpreter::ps_madd>(),
+      MakeSuperinstruction<Interpreter::psq_l, Interpreter::psq_l>(),
+      MakeSuperinstruction<Interpreter::lfs, Interpreter::fmulsx>(),
+      MakeSuperinstruction<Interpreter::lfs, Interpreter::faddsx>(),
+  };
+
+  // Breakpoints and stepping have to stop in between instructions
+  if (IsDebuggingEnabled())
+    return 0;
+
+  const InterpreterOp first = Interpreter::GetInterpreterOp(m_code_buffer[index].inst);
+  for (const Superinstruction& superinstruction : superinstructions)
+  {
+    if (superinstruction.instructions[0] != first ||
+        index + superinstruction.length > code_block.m_num_instructions)
+    {
+      continue;
+    }
+
+    bool match = true;
+    for (u32 i = 0; i < superinstruction.length && match; ++i)
+    {
+      const PPCAnalyst::CodeOp& op = m_code_buffer[index + i];
+      match = Interpreter::GetInterpreterOp(op.inst) == superinstruction.instructions[i] &&
+              CanFuseInstruction(op, i == 0, i + 1 == superinstruction.length);
+    }
+    if (!match)
+      continue;
+
+    (this->*superinstruction.write)(index);
+    return superinstruction.length;
+  }
+  return 0;
+}
+
+template <CachedInterpreter::InterpreterOp... instructions>
+void CachedInterpreter::WriteInterpretSequence(u32 index)
+{
+  static constexpr std::size_t count = sizeof...(instructions);
+
+  InterpretSequenceOperands<count> operands = {m_system.GetInterpreter(), {}, 0};
+  for (std::size_t i = 0; i < count; ++i)
+    operands.insts[i] = m_code_buffer[index + i].inst;
+  const PPCAnalyst::CodeOp& last = m_code_buffer[index + count - 1];
+  operands.last_pc = last.address;
+
+  Write(last.canEndBlock ? InterpretSequence<true, instructions...> :
+                           InterpretSequence<false, instructions...>,
+        operands);
+}
+
+bool CachedInterpreter::WriteSpecializedInstruction(const PPCAnalyst::CodeOp& op)
+{
+  const UGeckoInstruction inst = op.inst;
+  const InterpreterOp func = Interpreter::GetInterpreterOp(inst);
+
+  if (func == Interpreter::addi || func == Interpreter::addis)
+  {
+    const u32 imm = func == Interpreter::addi ? u32(inst.SIMM_16) : u32(inst.SIMM_16 << 16);
+    if (inst.RA == 0)
+      Write(LoadImmediate, {inst.RD, imm});
+    else
+      Write(AddImmediate, {inst.RD, inst.RA, imm});
+    return true;
+  }
+
+  if (func == Interpreter::orx && inst.RS == inst.RB && !inst.Rc)
+  {
+    Write(MoveRegister, {inst.RA, inst.RS});
+    return true;
+  }
+
+  return false;
+}
+
 bool CachedInterpreter::SetEmitterStateToFreeCodeRegion()
 {
   const auto free = m_free_ranges.by_size_begin();
@@ -313,11 +518,7 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
     js.compilerPC = op.address;
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
-    js.downcountAmount += op.opinfo->num_cycles;
-    if (op.opinfo->flags & FL_LOADSTORE)
-      ++js.numLoadStoreInst;
-    if (op.opinfo->flags & FL_USE_FPU)
-      ++js.numFloatingPointInst;
+    CountInstruction(op);
 
     if (HandleFunctionHooking(js.compilerPC))
       break;
@@ -347,16 +548,28 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
                                InterpretAndCheckExceptions<false>,
               operands);
       }
-      else
+      else if (const u32 length = WriteSuperinstruction(i))
+      {
+        // Account for the other instructions as if they had been written one by one. The checks
+        // below apply to the last one.
+        for (u32 j = 1; j < length; ++j)
+        {
+          js.op = &m_code_buffer[++i];
+          js.compilerPC = js.op->address;
+          js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
+          CountInstruction(*js.op);
+        }
+      }
+      else if (!WriteSpecializedInstruction(op))
       {
         const InterpretOperands operands = {interpreter, Interpreter::GetInterpreterOp(op.inst),
                                             js.compilerPC, op.inst};
         Write(op.canEndBlock ? Interpret<true> : Interpret<false>, operands);
       }
 
-      if (op.branchIsIdleLoop)
+      if (js.op->branchIsIdleLoop)
         Write(CheckIdle, {m_system.GetCoreTiming(), js.blockStart});
-      if (op.canEndBlock)
+      if (js.op->canEndBlock)
         Write(EndBlock, {js.downcountAmount, js.numLoadStoreInst, js.numFloatingPointInst});
     }
   }
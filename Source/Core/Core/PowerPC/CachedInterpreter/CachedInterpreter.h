@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 
 #include <rangeset/rangesizeset.h>
@@ -50,10 +51,38 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
+  // Runs the block at the current PC, compiling it first if needed. This is how another JIT runs
+  // code it has left to this one as its lower compilation tier.
+  void CompileAndExecuteOneBlock();
+
 private:
   void ExecuteOneBlock();
+  void ExecuteBlock(const u8* normal_entry);
 
   bool HandleFunctionHooking(u32 address);
+  void CountInstruction(const PPCAnalyst::CodeOp& op);
+
+  using InterpreterOp = void (*)(Interpreter&, UGeckoInstruction);  // Interpreter::Instruction
+
+  // A common sequence of instructions run by a single callback, without dispatching between them
+  struct Superinstruction
+  {
+    std::array<InterpreterOp, 3> instructions;
+    u32 length;
+    void (CachedInterpreter::*write)(u32 index);
+  };
+  template <InterpreterOp... instructions>
+  static constexpr Superinstruction MakeSuperinstruction();
+
+  bool CanFuseInstruction(const PPCAnalyst::CodeOp& op, bool first, bool last);
+  // Writes the superinstruction starting at the given instruction of the block, if there is one.
+  // Returns how many instructions it covers, or 0 if there was none.
+  u32 WriteSuperinstruction(u32 index);
+  template <InterpreterOp... instructions>
+  void WriteInterpretSequence(u32 index);
+  // Writes a native callback for common operand shapes (li, lis, mr and so on), which doesn't go
+  // through the interpreter at all. Returns false if the instruction isn't one of them.
+  bool WriteSpecializedInstruction(const PPCAnalyst::CodeOp& op);
 
   // Finds a free memory region and sets the code emitter to point at that region.
   // Returns false if no free memory region can be found.
@@ -69,6 +98,11 @@ private:
   struct WriteBrokenBlockNPCOperands;
   struct CheckHaltOperands;
   struct CheckIdleOperands;
+  template <std::size_t count>
+  struct InterpretSequenceOperands;
+  struct LoadImmediateOperands;
+  struct AddImmediateOperands;
+  struct MoveRegisterOperands;
 
   static s32 EndBlock(PowerPC::PowerPCState& ppc_state, const EndBlockOperands& operands);
   template <bool write_pc>
@@ -82,6 +116,12 @@ private:
   static s32 CheckFPU(PowerPC::PowerPCState& ppc_state, const CheckHaltOperands& operands);
   static s32 CheckBreakpoint(PowerPC::PowerPCState& ppc_state, const CheckHaltOperands& operands);
   static s32 CheckIdle(PowerPC::PowerPCState& ppc_state, const CheckIdleOperands& operands);
+  template <bool write_pc, InterpreterOp... instructions>
+  static s32 InterpretSequence(PowerPC::PowerPCState& ppc_state,
+                               const InterpretSequenceOperands<sizeof...(instructions)>& operands);
+  static s32 LoadImmediate(PowerPC::PowerPCState& ppc_state, const LoadImmediateOperands& operands);
+  static s32 AddImmediate(PowerPC::PowerPCState& ppc_state, const AddImmediateOperands& operands);
+  static s32 MoveRegister(PowerPC::PowerPCState& ppc_state, const MoveRegisterOperands& operands);
 
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges;
   CachedInterpreterBlockCache m_block_cache;
@@ -134,3 +174,32 @@ struct CachedInterpreter::CheckIdleOperands
   CoreTiming::CoreTimingManager& core_timing;
   u32 idle_pc;
 };
+
+template <std::size_t count>
+struct CachedInterpreter::InterpretSequenceOperands
+{
+  Interpreter& interpreter;
+  std::array<UGeckoInstruction, count> insts;
+  // Address of the last instruction, for sequences ending in a branch
+  u32 last_pc;
+};
+
+struct CachedInterpreter::LoadImmediateOperands
+{
+  u32 rd;
+  u32 imm;
+};
+
+struct CachedInterpreter::AddImmediateOperands
+{
+  u32 rd;
+  u32 ra;
+  u32 imm;
+  u32 : 32;
+};
+
+struct CachedInterpreter::MoveRegisterOperands
+{
+  u32 ra;
+  u32 rs;
+};
@@ -3,7 +3,9 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -16,6 +18,7 @@
 #endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/EnumUtils.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/IOFile.h"
@@ -23,6 +26,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -32,6 +36,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/MachineContext.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
@@ -254,6 +259,11 @@ void Jit64::Init()
 
   RefreshConfig();
 
+  // The dispatcher is generated for one convention or the other, so this can't change until the
+  // next Init
+  m_enable_pinned_registers =
+      Config::Get(Config::MAIN_JIT_PINNED_REGISTERS) && !IsDebuggingEnabled();
+
   EnableBlockLink();
 
   jo.optimizeGatherPipe = true;
@@ -294,12 +304,28 @@ void Jit64::Init()
   EnableOptimization();
 
   ResetFreeMemoryRanges();
+
+  m_hot_addresses.clear();
+  if (Config::Get(Config::MAIN_JIT_TIERED_COMPILATION) && !IsDebuggingEnabled())
+  {
+    m_cold_tier = std::make_unique<CachedInterpreter>(m_system);
+    m_cold_tier->Init();
+    blocks.SetLowerTier(m_cold_tier->GetBlockCache());
+    m_tier_up_threshold =
+        static_cast<u32>(std::max(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD), 1));
+  }
+
+  m_enable_hot_traces = Config::Get(Config::MAIN_JIT_HOT_TRACES) && !IsDebuggingEnabled();
+  m_branch_profiles.clear();
+  analyzer.ClearHotBranches();
 }
 
 void Jit64::ClearCache()
 {
   blocks.Clear();
   blocks.ClearRangesToFree();
+  // No code refers to the profiles anymore. The hot branches are kept, they still apply.
+  m_branch_profiles.clear();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
   m_const_pool.Clear();
@@ -326,6 +352,13 @@ void Jit64::Shutdown()
   auto& memory = m_system.GetMemory();
   memory.ShutdownFastmemArena();
 
+  if (m_cold_tier)
+  {
+    blocks.SetLowerTier(nullptr);
+    m_cold_tier->Shutdown();
+    m_cold_tier.reset();
+  }
+
   blocks.Shutdown();
   m_far_code.Shutdown();
   m_const_pool.Shutdown();
@@ -343,9 +376,11 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
   }
 
   Interpreter::Instruction instr = Interpreter::GetInterpreterOp(inst);
+  StorePinnedRegisters(*this);
   ABI_PushRegistersAndAdjustStack({}, 0);
   ABI_CallFunctionPC(instr, &m_system.GetInterpreter(), inst.hex);
   ABI_PopRegistersAndAdjustStack({}, 0);
+  LoadPinnedRegisters(*this);
 
   // If the instruction wrote to any registers which were marked as discarded,
   // we must mark them as no longer discarded
@@ -394,9 +429,29 @@ void Jit64::HLEFunction(u32 hook_index)
 {
   gpr.Flush();
   fpr.Flush();
+  StorePinnedRegisters(*this);
   ABI_PushRegistersAndAdjustStack({}, 0);
   ABI_CallFunctionCCP(HLE::ExecuteFromJIT, js.compilerPC, hook_index, &m_system);
   ABI_PopRegistersAndAdjustStack({}, 0);
+  LoadPinnedRegisters(*this);
+}
+
+void Jit64::StorePinnedRegisters(XEmitter& emitter) const
+{
+  if (!m_enable_pinned_registers)
+    return;
+
+  for (const auto& [preg, xreg] : PINNED_GPRS)
+    emitter.MOV(32, PPCSTATE_GPR(preg), R(xreg));
+}
+
+void Jit64::LoadPinnedRegisters(XEmitter& emitter) const
+{
+  if (!m_enable_pinned_registers)
+    return;
+
+  for (const auto& [preg, xreg] : PINNED_GPRS)
+    emitter.MOV(32, R(xreg), PPCSTATE_GPR(preg));
 }
 
 void Jit64::DoNothing(UGeckoInstruction _inst)
@@ -649,7 +704,7 @@ void Jit64::WriteRfiExitDestInRSCRATCH()
 void Jit64::WriteIdleExit(u32 destination)
 {
   ABI_PushRegistersAndAdjustStack({}, 0);
-  ABI_CallFunction(CoreTiming::GlobalIdle);
+  ABI_CallFunctionC(CoreTiming::GlobalIdle, destination);
   ABI_PopRegistersAndAdjustStack({}, 0);
   MOV(32, PPCSTATE(pc), Imm32(destination));
   WriteExceptionExit();
@@ -755,6 +810,13 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     m_free_ranges_far.insert(range.first, range.second);
   blocks.ClearRangesToFree();
 
+  // If there is no room for the stub, the regular path below clears the cache and retries
+  if (m_cold_tier && !IsDebuggingEnabled() && !m_hot_addresses.contains(em_address) &&
+      JitColdBlock(em_address))
+  {
+    return;
+  }
+
   std::size_t block_size = m_code_buffer.size();
 
   if (IsDebuggingEnabled())
@@ -776,6 +838,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_HOT_TRACE);
       }
       Trace();
     }
@@ -842,6 +905,86 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
+bool Jit64::JitColdBlock(u32 em_address)
+{
+  const CPUEmuFeatureFlags feature_flags = m_ppc_state.feature_flags;
+  JitBaseBlockCache& cold_blocks = *m_cold_tier->GetBlockCache();
+
+  JitBlock* cold_block = cold_blocks.GetBlockFromStartAddress(em_address, feature_flags);
+  if (!cold_block)
+  {
+    m_cold_tier->Jit(em_address);
+    cold_block = cold_blocks.GetBlockFromStartAddress(em_address, feature_flags);
+    if (!cold_block)
+    {
+      // Translating the address raised an ISI
+      m_system.GetJitInterface().UpdateMembase();
+      return true;
+    }
+  }
+
+  if (!SetEmitterStateToFreeCodeRegion())
+    return false;
+
+  u8* near_start = GetWritableCodePtr();
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  b->normalEntry = AlignCode4();
+
+  // Leave any frames the BLR optimization pushed behind, the block returns through the dispatcher
+  asm_routines.ResetStack(*this);
+  StorePinnedRegisters(*this);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPP(RunColdBlock, this, b);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  LoadPinnedRegisters(*this);
+
+  // The block may have changed MSR.DR or taken an exception
+  EmitUpdateMembase();
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(asm_routines.dispatcher, Jump::Near);
+
+  if (HasWriteFailed())
+  {
+    WARN_LOG_FMT(DYNA_REC, "JIT ran out of space in code region during code generation.");
+    blocks.EraseBlock(*b);
+    return false;
+  }
+
+  u8* near_end = GetWritableCodePtr();
+  m_free_ranges_near.erase(near_start, near_end);
+  b->near_begin = near_start;
+  b->near_end = near_end;
+  b->codeSize = static_cast<u32>(near_end - b->normalEntry);
+  b->originalSize = cold_block->originalSize;
+
+  // Cover the same code as the cold block, so that invalidating it also removes the stub
+  const std::set<u32> physical_addresses(cold_block->physical_addresses.begin(),
+                                         cold_block->physical_addresses.end());
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, physical_addresses);
+  return true;
+}
+
+void Jit64::RunColdBlock(Jit64& jit, JitBlock* block)
+{
+  jit.m_cold_tier->CompileAndExecuteOneBlock();
+  jit.m_system.GetJitInterface().UpdateMembase();
+
+  // The block may have invalidated its own code
+  if (!block->in_use || ++block->tier_run_count < jit.m_tier_up_threshold)
+    return;
+
+  // Drop the stub so that the next dispatch to this address compiles it with Jit64, right there on
+  // the CPU thread. We are still inside the stub, which is fine as destroying a block only
+  // overwrites its entry point.
+  const u32 address = block->effectiveAddress;
+  jit.m_hot_addresses.insert(address);
+
+  JitBaseBlockCache& cold_blocks = *jit.m_cold_tier->GetBlockCache();
+  if (JitBlock* cold_block = cold_blocks.GetBlockFromStartAddress(address, block->feature_flags))
+    cold_blocks.EraseBlock(*cold_block);
+  jit.blocks.EraseBlock(*block);
+}
+
 bool Jit64::SetEmitterStateToFreeCodeRegion()
 {
   // Find the largest free memory blocks and set code emitters to point at them.
@@ -1225,6 +1368,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_HOT_TRACE);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -1238,6 +1382,10 @@ void Jit64::IntializeSpeculativeConstants()
   const u8* target = nullptr;
   for (auto i : code_block.m_gpr_inputs)
   {
+    // The check below reads the register from ppcState, which is stale for pinned registers
+    if (gpr.IsPinned(i))
+      continue;
+
     u32 compileTimeValue = m_ppc_state.gpr[i];
     if (m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue) ||
         m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue - 0x8000) ||
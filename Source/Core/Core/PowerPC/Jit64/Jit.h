@@ -17,7 +17,10 @@
 // ----------
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <rangeset/rangesizeset.h>
 
@@ -40,6 +43,8 @@ struct CodeBlock;
 struct CodeOp;
 }  // namespace PPCAnalyst
 
+class CachedInterpreter;
+
 class Jit64 : public JitBase, public QuantizedMemoryRoutines
 {
 public:
@@ -85,6 +90,12 @@ public:
   void Run() override;
   void SingleStep() override;
 
+  // See PINNED_GPRS. Code which reads guest registers from ppcState has to store the pinned
+  // registers there first, and code which writes them has to load them back afterwards.
+  bool ArePinnedRegistersEnabled() const { return m_enable_pinned_registers; }
+  void StorePinnedRegisters(Gen::XEmitter& emitter) const;
+  void LoadPinnedRegisters(Gen::XEmitter& emitter) const;
+
   // Utilities for use by opcodes
 
   void EmitUpdateMembase();
@@ -103,6 +114,11 @@ public:
                         Gen::X64Reg reg_b, BitSet32 caller_save);
   void WriteBranchWatchDestInRSCRATCH(u32 origin, UGeckoInstruction inst, Gen::X64Reg reg_a,
                                       Gen::X64Reg reg_b, BitSet32 caller_save);
+  // Counts which way a conditional branch goes, for hot traces. Does nothing for branches which
+  // can't be followed, or already are.
+  void WriteBranchProfile(const PPCAnalyst::CodeOp& op, bool taken);
+  // Leaves the block on the fall-through path of a branch whose target was inlined
+  void WriteSideExit(u32 destination);
 
   bool Cleanup();
 
@@ -270,6 +286,20 @@ private:
 
   static void ImHere(Jit64& jit);
 
+  // Tiered compilation: new blocks get a stub which runs them in the cached interpreter. Only
+  // once a block has run m_tier_up_threshold times is it compiled by Jit64.
+  // Both compiles run on the CPU thread, this only defers the Jit64 one. Moving it to another
+  // thread would need a snapshot of the state DoJit reads while emitting: the GPRs it turns into
+  // speculative constants, MSR.DR and the BATs it uses to pick fast memory accesses. It would also
+  // need the CPU thread to do the block linking, which patches code that may be running.
+  // Returns false if there is no room for the stub.
+  bool JitColdBlock(u32 em_address);
+  static void RunColdBlock(Jit64& jit, JitBlock* block);
+
+  // Hot traces: once a conditional branch has been taken often enough, decides from its profile
+  // whether to mark it as hot and recompile the block with the branch target inlined.
+  static void SampleBranchProfile(Jit64& jit, JitBlock* block, u32 address);
+
   JitBlockCache blocks{*this};
   TrampolineCache trampolines{*this};
 
@@ -281,6 +311,21 @@ private:
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
 
+  std::unique_ptr<CachedInterpreter> m_cold_tier;
+  u32 m_tier_up_threshold = 0;
+  // Addresses of blocks which reached the threshold, these are compiled by Jit64 right away
+  std::unordered_set<u32> m_hot_addresses;
+
+  struct BranchProfile
+  {
+    u32 taken = 0;
+    u32 not_taken = 0;
+  };
+  bool m_enable_hot_traces = false;
+  bool m_enable_pinned_registers = false;
+  // Indexed by branch address. The generated code points into this, so entries must stay put.
+  std::unordered_map<u32, BranchProfile> m_branch_profiles;
+
   const bool m_im_here_debug = false;
   const bool m_im_here_log = false;
   std::map<u32, int> m_been_here;
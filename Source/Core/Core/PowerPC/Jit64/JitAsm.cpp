@@ -70,6 +70,10 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(CoreTiming::GlobalAdvance);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // The pinned registers are stored at do_timing, before leaving for C++. Events may have changed
+  // them, and on entry they don't hold guest values yet.
+  m_jit.LoadPinnedRegisters(*this);
+
   // When we've just entered the jit we need to update the membase
   // GlobalAdvance also checks exceptions after which we need to
   // update the membase so it makes sense to do this here.
@@ -230,6 +234,9 @@ void Jit64AsmRoutineManager::Generate()
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
 
+  // CoreTiming events and everything outside of the JIT read the guest registers from ppcState
+  m_jit.StorePinnedRegisters(*this);
+
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
   MOV(32, R(RSCRATCH), PPCSTATE(pc));
   MOV(32, PPCSTATE(npc), R(RSCRATCH));
@@ -28,6 +28,14 @@
 
 using namespace Gen;
 
+namespace
+{
+// A branch's profile is looked at every time it has been taken this many times
+constexpr u32 BRANCH_PROFILE_SAMPLE_COUNT = 256;
+// Branches taken at least this many times as often as not are considered hot
+constexpr u64 HOT_BRANCH_RATIO = 8;
+}  // namespace
+
 void Jit64::sc(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -129,6 +137,64 @@ void Jit64::WriteBranchWatchDestInRSCRATCH(u32 origin, UGeckoInstruction inst, X
   SetJumpTarget(branch_out);
 }
 
+void Jit64::WriteBranchProfile(const PPCAnalyst::CodeOp& op, bool taken)
+{
+  if (!m_enable_hot_traces || op.followTaken || analyzer.IsHotBranch(op.address) ||
+      !analyzer.CanFollowTakenBranch(op, js.blockStart))
+  {
+    return;
+  }
+
+  BranchProfile& profile = m_branch_profiles[op.address];
+
+  // Leave the flags alone, the fall-through path may still be using them
+  MOV(64, R(RSCRATCH), ImmPtr(taken ? &profile.taken : &profile.not_taken));
+  MOV(32, R(RSCRATCH2), MatR(RSCRATCH));
+  LEA(32, RSCRATCH2, MDisp(RSCRATCH2, 1));
+  MOV(32, MatR(RSCRATCH), R(RSCRATCH2));
+
+  if (!taken)
+    return;
+
+  // The taken path ends in an exit, so the flags are free here and all registers are flushed
+  CMP(32, R(RSCRATCH2), Imm32(BRANCH_PROFILE_SAMPLE_COUNT));
+  FixupBranch sample = J_CC(CC_AE, Jump::Near);
+  SwitchToFarCode();
+  SetJumpTarget(sample);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPPC(SampleBranchProfile, this, js.curBlock, op.address);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  FixupBranch sampled = J(Jump::Near);
+  SwitchToNearCode();
+  SetJumpTarget(sampled);
+}
+
+void Jit64::SampleBranchProfile(Jit64& jit, JitBlock* block, u32 address)
+{
+  BranchProfile& profile = jit.m_branch_profiles[address];
+  const bool hot = profile.taken >= profile.not_taken * HOT_BRANCH_RATIO;
+  profile = {};
+
+  // The branch may have become hot in another block since this one was compiled
+  if (!hot && !jit.analyzer.IsHotBranch(address))
+    return;
+
+  // Drop the block so that the next dispatch recompiles it with the branch target inlined. We are
+  // still inside the block, which is fine as destroying a block only overwrites its entry point.
+  jit.analyzer.AddHotBranch(address);
+  if (block->in_use)
+    jit.blocks.EraseBlock(*block);
+}
+
+void Jit64::WriteSideExit(u32 destination)
+{
+  RCForkGuard gpr_guard = gpr.Fork();
+  RCForkGuard fpr_guard = fpr.Fork();
+  gpr.Flush();
+  fpr.Flush();
+  WriteExit(destination);
+}
+
 void Jit64::bx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -232,6 +298,20 @@ void Jit64::bcx(UGeckoInstruction inst)
     return;
   }
 
+  // The analyzer continued the block at the branch target, so it is the fall-through path which
+  // leaves the block.
+  if (js.op->followTaken)
+  {
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+    WriteSideExit(js.compilerPC + 4);
+    SwitchToNearCode();
+    return;
+  }
+
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
@@ -249,6 +329,7 @@ void Jit64::bcx(UGeckoInstruction inst)
     }
     else
     {
+      WriteBranchProfile(*js.op, true);
       WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
     }
   }
@@ -258,6 +339,8 @@ void Jit64::bcx(UGeckoInstruction inst)
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
     SetJumpTarget(pCTRDontBranch);
 
+  WriteBranchProfile(*js.op, false);
+
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
     gpr.Flush();
@@ -414,6 +414,7 @@ void Jit64::DoMergedBranch()
       // ABI_PARAM1 is safe to use after a GPR flush for an optimization in this function.
       WriteBranchWatch<true>(nextPC, destination, next, ABI_PARAM1, RSCRATCH, {});
     }
+    WriteBranchProfile(js.op[1], true);
     WriteExit(destination, next.LK, nextPC + 4);
   }
   else if ((next.OPCD == 19) && (next.SUBOP10 == 528))  // bcctrx
@@ -481,6 +482,16 @@ void Jit64::DoMergedBranchCondition()
     break;
   }
 
+  // The block continues at the branch target, see bcx
+  if (js.op[1].followTaken)
+  {
+    SwitchToFarCode();
+    SetJumpTarget(pDontBranch);
+    WriteSideExit(nextPC + 4);
+    SwitchToNearCode();
+    return;
+  }
+
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
@@ -492,6 +503,7 @@ void Jit64::DoMergedBranchCondition()
   }
 
   SetJumpTarget(pDontBranch);
+  WriteBranchProfile(js.op[1], false);
 
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
@@ -539,6 +551,18 @@ void Jit64::DoMergedBranchImmediate(s64 val)
     break;
   }
 
+  // The block continues at the branch target, see bcx
+  if (js.op[1].followTaken)
+  {
+    if (!branch)
+    {
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(nextPC + 4);
+    }
+    return;
+  }
+
   if (branch)
   {
     gpr.Flush();
@@ -5,6 +5,7 @@
 
 #include "Common/x64Reg.h"
 #include "Core/PowerPC/Jit64/Jit.h"
+#include "Core/PowerPC/Jit64Common/Jit64Constants.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 
 using namespace Gen;
@@ -16,7 +17,11 @@ GPRRegCache::GPRRegCache(Jit64& jit) : RegCache{jit}
 void GPRRegCache::StoreRegister(preg_t preg, const OpArg& new_loc)
 {
   ASSERT_MSG(DYNA_REC, !m_regs[preg].IsDiscarded(), "Discarded register - {}", preg);
-  m_emitter->MOV(32, new_loc, m_regs[preg].Location().value());
+  const OpArg& location = m_regs[preg].Location().value();
+  // A pinned register bound in place is already at its default location
+  if (new_loc.IsSimpleReg() && location.IsSimpleReg(new_loc.GetSimpleReg()))
+    return;
+  m_emitter->MOV(32, new_loc, location);
 }
 
 void GPRRegCache::LoadRegister(preg_t preg, X64Reg new_loc)
@@ -27,9 +32,24 @@ void GPRRegCache::LoadRegister(preg_t preg, X64Reg new_loc)
 
 OpArg GPRRegCache::GetDefaultLocation(preg_t preg) const
 {
+  if (const std::optional<X64Reg> xreg = GetPinnedXReg(preg))
+    return ::Gen::R(*xreg);
   return PPCSTATE_GPR(preg);
 }
 
+std::optional<X64Reg> GPRRegCache::GetPinnedXReg(preg_t preg) const
+{
+  if (!m_jit.ArePinnedRegistersEnabled())
+    return std::nullopt;
+
+  for (const auto& [pinned_preg, xreg] : PINNED_GPRS)
+  {
+    if (pinned_preg == preg)
+      return xreg;
+  }
+  return std::nullopt;
+}
+
 std::span<const X64Reg> GPRRegCache::GetAllocationOrder() const
 {
   static constexpr X64Reg allocation_order[] = {
@@ -41,6 +61,18 @@ std::span<const X64Reg> GPRRegCache::GetAllocationOrder() const
       R8,  R9,  R10, R11, RCX
 #endif
   };
+  // Without the host registers of PINNED_GPRS
+  static constexpr X64Reg allocation_order_pinned[] = {
+#ifdef _WIN32
+      RSI, RDI, R15, R8,
+      R9,  R10, R11, RCX
+#else
+      R15, RSI, RDI, R8,
+      R9,  R10, R11, RCX
+#endif
+  };
+  if (m_jit.ArePinnedRegistersEnabled())
+    return allocation_order_pinned;
   return allocation_order;
 }
 
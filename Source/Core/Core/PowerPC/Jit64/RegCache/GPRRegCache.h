@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
 
 class Jit64;
@@ -13,6 +15,9 @@ public:
   explicit GPRRegCache(Jit64& jit);
   void SetImmediate32(preg_t preg, u32 imm_value, bool dirty = true);
 
+  // Whether the register lives in a host register across blocks, see PINNED_GPRS
+  bool IsPinned(preg_t preg) const { return GetPinnedXReg(preg).has_value(); }
+
 protected:
   Gen::OpArg GetDefaultLocation(preg_t preg) const override;
   void StoreRegister(preg_t preg, const Gen::OpArg& new_loc) override;
@@ -20,4 +25,7 @@ protected:
   std::span<const Gen::X64Reg> GetAllocationOrder() const override;
   BitSet32 GetRegUtilization() const override;
   BitSet32 CountRegsIn(preg_t preg, u32 lookahead) const override;
+
+private:
+  std::optional<Gen::X64Reg> GetPinnedXReg(preg_t preg) const;
 };
@@ -510,7 +510,12 @@ void RegCache::BindToRegister(preg_t i, bool doLoad, bool makeDirty)
 {
   if (!m_regs[i].IsBound())
   {
-    X64Reg xr = GetFreeXReg();
+    // Registers whose default location is a host register are bound in place, unless the old value
+    // has to stay there in case the instruction is reverted
+    const OpArg default_location = GetDefaultLocation(i);
+    const bool in_place =
+        default_location.IsSimpleReg() && !m_constraints[i].ShouldBeRevertable();
+    X64Reg xr = in_place ? default_location.GetSimpleReg() : GetFreeXReg();
 
     ASSERT_MSG(DYNA_REC, !m_xregs[xr].IsDirty(), "Xreg {} already dirty", Common::ToUnderlying(xr));
     ASSERT_MSG(DYNA_REC, !m_xregs[xr].IsLocked(), "GetFreeXReg returned locked register");
@@ -521,13 +526,15 @@ void RegCache::BindToRegister(preg_t i, bool doLoad, bool makeDirty)
     if (doLoad)
     {
       ASSERT_MSG(DYNA_REC, !m_regs[i].IsDiscarded(), "Attempted to load a discarded value");
-      LoadRegister(i, xr);
+      if (!m_regs[i].Location()->IsSimpleReg(xr))
+        LoadRegister(i, xr);
     }
 
     ASSERT_MSG(DYNA_REC,
                std::none_of(m_regs.begin(), m_regs.end(),
-                            [xr](const auto& r) {
-                              return r.Location().has_value() && r.Location()->IsSimpleReg(xr);
+                            [&](const auto& r) {
+                              return &r != &m_regs[i] && r.Location().has_value() &&
+                                     r.Location()->IsSimpleReg(xr);
                             }),
                "Xreg {} already bound", Common::ToUnderlying(xr));
 
@@ -719,7 +726,10 @@ void RegCache::Realize(preg_t preg)
 
   if (m_constraints[preg].ShouldBeRevertable())
   {
-    StoreFromRegister(preg, FlushMode::MaintainState);
+    // If the default location is a host register, the value has to move out of it for the
+    // old one to be kept
+    const bool home_is_register = GetDefaultLocation(preg).IsSimpleReg();
+    StoreFromRegister(preg, home_is_register ? FlushMode::Full : FlushMode::MaintainState);
     do_bind();
     m_regs[preg].SetRevertable();
     return;
@@ -3,8 +3,11 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <limits>
+#include <optional>
 
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
@@ -131,6 +134,98 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled() ? Jump::Near : Jump::Short);
 }
 
+EmuCodeBlock::SoftTLBLookup EmuCodeBlock::SoftTLBLookupAddress(X64Reg reg_addr, int access_size,
+                                                               bool write,
+                                                               BitSet32 registers_in_use,
+                                                               BitSet32 excluded_regs)
+{
+  // Prefer registers which are free, and save the ones that aren't
+  static constexpr std::array<X64Reg, 4> candidates = {RSCRATCH, RSCRATCH2, RSCRATCH_EXTRA, R8};
+  std::array<X64Reg, 2> regs{};
+  size_t count = 0;
+  for (const bool in_use : {false, true})
+  {
+    for (const X64Reg reg : candidates)
+    {
+      if (count < regs.size() && !excluded_regs[reg] && registers_in_use[reg] == in_use)
+        regs[count++] = reg;
+    }
+  }
+
+  SoftTLBLookup lookup;
+  lookup.entry = regs[0];
+  lookup.tmp = regs[1];
+  BitSet32 lookup_regs;
+  lookup_regs[lookup.entry] = true;
+  lookup_regs[lookup.tmp] = true;
+  lookup.saved_regs = registers_in_use & lookup_regs;
+  if (lookup.saved_regs[lookup.entry])
+    PUSH(lookup.entry);
+  if (lookup.saved_regs[lookup.tmp])
+    PUSH(lookup.tmp);
+
+  const PowerPC::SoftTLB& tlb = m_jit.m_mmu.GetSoftTLB(write);
+  MOV(32, R(lookup.tmp), R(reg_addr));
+  SHR(32, R(lookup.tmp), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT - PowerPC::SOFT_TLB_ENTRY_SHIFT));
+  AND(32, R(lookup.tmp), Imm32((PowerPC::SOFT_TLB_SIZE - 1) << PowerPC::SOFT_TLB_ENTRY_SHIFT));
+  MOV(64, R(lookup.entry), ImmPtr(tlb.data()));
+  ADD(64, R(lookup.entry), R(lookup.tmp));
+
+  // Misaligned accesses always miss, so that they can't cross into the next page
+  MOV(32, R(lookup.tmp), R(reg_addr));
+  AND(32, R(lookup.tmp), Imm32(~static_cast<u32>(PowerPC::HW_PAGE_MASK) | (access_size / 8 - 1)));
+  CMP(32, R(lookup.tmp), MDisp(lookup.entry, offsetof(PowerPC::SoftTLBEntry, tag)));
+  lookup.miss = J_CC(CC_NE);
+  MOV(64, R(lookup.entry), MDisp(lookup.entry, offsetof(PowerPC::SoftTLBEntry, host_offset)));
+
+  return lookup;
+}
+
+void EmuCodeBlock::SoftTLBRestoreRegisters(const SoftTLBLookup& lookup)
+{
+  if (lookup.saved_regs[lookup.tmp])
+    POP(lookup.tmp);
+  if (lookup.saved_regs[lookup.entry])
+    POP(lookup.entry);
+}
+
+FixupBranch EmuCodeBlock::SoftTLBFinish(const SoftTLBLookup& lookup)
+{
+  SoftTLBRestoreRegisters(lookup);
+  FixupBranch hit = J(Jump::Near);
+  SetJumpTarget(lookup.miss);
+  SoftTLBRestoreRegisters(lookup);
+  return hit;
+}
+
+FixupBranch EmuCodeBlock::SoftTLBLoadToReg(X64Reg reg_value, X64Reg reg_addr, int access_size,
+                                           BitSet32 registers_in_use, bool sign_extend)
+{
+  // reg_value has to survive a miss, in case the slow access raises an exception
+  BitSet32 excluded_regs;
+  excluded_regs[reg_addr] = true;
+  excluded_regs[reg_value] = true;
+  const SoftTLBLookup lookup =
+      SoftTLBLookupAddress(reg_addr, access_size, false, registers_in_use, excluded_regs);
+  LoadAndSwap(access_size, reg_value, MComplex(lookup.entry, reg_addr, SCALE_1, 0), sign_extend);
+  return SoftTLBFinish(lookup);
+}
+
+FixupBranch EmuCodeBlock::SoftTLBWriteRegToReg(const OpArg& reg_value, X64Reg reg_addr,
+                                               int access_size, BitSet32 registers_in_use,
+                                               bool swap)
+{
+  BitSet32 excluded_regs;
+  excluded_regs[reg_addr] = true;
+  if (!reg_value.IsImm())
+    excluded_regs[reg_value.GetSimpleReg()] = true;
+
+  const SoftTLBLookup lookup =
+      SoftTLBLookupAddress(reg_addr, access_size, true, registers_in_use, excluded_regs);
+  WriteRegToMemory(reg_value, MComplex(lookup.entry, reg_addr, SCALE_1, 0), access_size, swap);
+  return SoftTLBFinish(lookup);
+}
+
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
                                        bool swap, MovInfo* info)
 {
@@ -140,7 +235,12 @@ void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acc
     info->nonAtomicSwapStore = false;
   }
 
-  OpArg dest = MComplex(RMEM, reg_addr, SCALE_1, offset);
+  WriteRegToMemory(reg_value, MComplex(RMEM, reg_addr, SCALE_1, offset), accessSize, swap, info);
+}
+
+void EmuCodeBlock::WriteRegToMemory(OpArg reg_value, const OpArg& dest, int accessSize, bool swap,
+                                    MovInfo* info)
+{
   if (reg_value.IsImm())
   {
     if (swap)
@@ -386,6 +486,12 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     SetJumpTarget(slow);
   }
 
+  // The asm routines are shared between blocks compiled under different settings, so they can't
+  // use the software TLB
+  std::optional<FixupBranch> soft_tlb_hit;
+  if (dr_set && m_jit.jo.soft_tlb && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
+    soft_tlb_hit = SoftTLBLoadToReg(reg_value, reg_addr, accessSize, registersInUse, signExtend);
+
   // PC is used by memory watchpoints (if enabled), profiling where to insert gather pipe
   // interrupt checks, and printing accurate PC locations in debug logs.
   //
@@ -426,6 +532,9 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (soft_tlb_hit)
+    SetJumpTarget(*soft_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -560,6 +669,10 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     SetJumpTarget(slow);
   }
 
+  std::optional<FixupBranch> soft_tlb_hit;
+  if (dr_set && m_jit.jo.soft_tlb && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
+    soft_tlb_hit = SoftTLBWriteRegToReg(reg_value, reg_addr, accessSize, registersInUse, swap);
+
   // PC is used by memory watchpoints (if enabled), profiling where to insert gather pipe
   // interrupt checks, and printing accurate PC locations in debug logs.
   //
@@ -607,6 +720,9 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (soft_tlb_hit)
+    SetJumpTarget(*soft_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
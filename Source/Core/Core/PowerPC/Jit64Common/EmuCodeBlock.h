@@ -125,6 +125,34 @@ public:
   void Clear();
 
 protected:
+  // Registers used by a software TLB lookup, and which of them it saved on the stack
+  struct SoftTLBLookup
+  {
+    Gen::X64Reg entry;
+    Gen::X64Reg tmp;
+    BitSet32 saved_regs;
+    Gen::FixupBranch miss;
+  };
+
+  // Looks reg_addr up in the MMU's software TLB. On a hit, entry holds the host offset of the page
+  // afterwards. Clobbers no registers other than those in excluded_regs.
+  SoftTLBLookup SoftTLBLookupAddress(Gen::X64Reg reg_addr, int access_size, bool write,
+                                     BitSet32 registers_in_use, BitSet32 excluded_regs);
+  void SoftTLBRestoreRegisters(const SoftTLBLookup& lookup);
+  // Restores the registers of a lookup on both paths. Returns the branch taken on a hit, a miss
+  // falls through.
+  Gen::FixupBranch SoftTLBFinish(const SoftTLBLookup& lookup);
+
+  // Do the access through the software TLB, if the address is in it. Jump to the returned
+  // FixupBranch once the access has been done; on a miss, execution continues after these.
+  Gen::FixupBranch SoftTLBLoadToReg(Gen::X64Reg reg_value, Gen::X64Reg reg_addr, int access_size,
+                                    BitSet32 registers_in_use, bool sign_extend);
+  Gen::FixupBranch SoftTLBWriteRegToReg(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
+                                        int access_size, BitSet32 registers_in_use, bool swap);
+
+  void WriteRegToMemory(Gen::OpArg reg_value, const Gen::OpArg& dest, int accessSize, bool swap,
+                        Gen::MovInfo* info = nullptr);
+
   Jit64& m_jit;
   ConstantPool m_const_pool;
   FarCodeCache m_far_code;
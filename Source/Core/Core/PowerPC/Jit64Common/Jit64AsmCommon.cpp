@@ -469,13 +469,11 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
     {
       SHR(32, R(RSCRATCH2), Imm8(5));
       LEA(64, RSCRATCH, MConst(m_quantizeTableS));
-      MOVQ_xmm(XMM1, MRegSum(RSCRATCH2, RSCRATCH));
-      MULPS(XMM0, R(XMM1));
+      ScalePair(MRegSum(RSCRATCH2, RSCRATCH));
     }
     else if (quantize > 0)
     {
-      MOVQ_xmm(XMM1, MConst(m_quantizeTableS, quantize * 2));
-      MULPS(XMM0, R(XMM1));
+      ScalePair(MConst(m_quantizeTableS, quantize * 2));
     }
 
     bool hasPACKUSDW = cpu_info.bSSE4_1;
@@ -683,17 +681,31 @@ void QuantizedMemoryRoutines::GenQuantizedLoad(bool single, EQuantizeType type,
     {
       SHR(32, R(RSCRATCH2), Imm8(5));
       LEA(64, RSCRATCH, MConst(m_dequantizeTableS));
-      MOVQ_xmm(XMM1, MRegSum(RSCRATCH2, RSCRATCH));
-      MULPS(XMM0, R(XMM1));
+      ScalePair(MRegSum(RSCRATCH2, RSCRATCH));
     }
     else if (quantize > 0)
     {
-      MOVQ_xmm(XMM1, MConst(m_dequantizeTableS, quantize * 2));
-      MULPS(XMM0, R(XMM1));
+      ScalePair(MConst(m_dequantizeTableS, quantize * 2));
     }
   }
 }
 
+void QuantizedMemoryRoutines::ScalePair(const OpArg& scale)
+{
+  if (cpu_info.bAVX)
+  {
+    // VEX-encoded instructions don't need aligned memory operands, so the pair can be used
+    // straight from the table. This reads the next pair as well, but the upper half of XMM0 is
+    // zero and stays zero.
+    VMULPS(XMM0, XMM0, scale);
+  }
+  else
+  {
+    MOVQ_xmm(XMM1, scale);
+    MULPS(XMM0, R(XMM1));
+  }
+}
+
 void QuantizedMemoryRoutines::GenQuantizedLoadFloat(bool single, bool isInline)
 {
   int size = single ? 32 : 64;
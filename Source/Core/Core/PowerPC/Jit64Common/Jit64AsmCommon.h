@@ -21,6 +21,8 @@ public:
 private:
   void GenQuantizedLoadFloat(bool single, bool isInline);
   void GenQuantizedStoreFloat(bool single, bool isInline);
+  // Multiplies the pair in XMM0 by a pair of scale factors in (de)quantizeTableS
+  void ScalePair(const Gen::OpArg& scale);
 };
 
 class CommonAsmRoutines : public CommonAsmRoutinesBase, public QuantizedMemoryRoutines
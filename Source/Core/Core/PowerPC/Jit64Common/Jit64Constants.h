@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 
 #include "Common/x64Reg.h"
@@ -20,4 +21,21 @@ constexpr Gen::X64Reg RMEM = Gen::RBX;
 // to address as much as possible in a one-byte offset form.
 constexpr Gen::X64Reg RPPCSTATE = Gen::RBP;
 
+// With pinned registers enabled, these guest GPRs live in these host registers for as long as JIT
+// code runs, across block links and the dispatcher, instead of being flushed at every block exit.
+// Their copies in ppcState are only written back around code which uses them from there. The host
+// registers are callee-saved in both ABIs, so calls into C++ preserve them.
+struct PinnedGPR
+{
+  size_t preg;
+  Gen::X64Reg xreg;
+};
+constexpr std::array<PinnedGPR, 3> PINNED_GPRS = {{
+    // Stack pointer
+    {1, Gen::R12},
+    // Small data area base pointers
+    {2, Gen::R13},
+    {13, Gen::R14},
+}};
+
 constexpr size_t CODE_SIZE = 1024 * 1024 * 128;
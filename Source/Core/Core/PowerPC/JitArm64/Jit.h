@@ -280,6 +280,10 @@ protected:
                                          Arm64Gen::ARM64Reg tmp, const void* bat_table);
   Arm64Gen::FixupBranch CheckIfSafeAddress(Arm64Gen::ARM64Reg addr, Arm64Gen::ARM64Reg tmp1,
                                            Arm64Gen::ARM64Reg tmp2);
+  // Looks addr up in the MMU's software TLB. If it hits, writes the host offset of the page to
+  // host_offset. If not, jumps to the returned FixupBranch. Clobbers tmp.
+  Arm64Gen::FixupBranch SoftTLBLookup(Arm64Gen::ARM64Reg addr, Arm64Gen::ARM64Reg host_offset,
+                                      Arm64Gen::ARM64Reg tmp, u32 access_size, bool write);
 
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
@@ -348,6 +352,7 @@ protected:
   void FixGTBeforeSettingCRFieldBit(Arm64Gen::ARM64Reg reg);
   void UpdateFPExceptionSummary(Arm64Gen::ARM64Reg fpscr);
   void UpdateRoundingMode();
+  void SRUpdated();
 
   void ComputeRC0(Arm64Gen::ARM64Reg reg);
   void ComputeRC0(u32 imm);
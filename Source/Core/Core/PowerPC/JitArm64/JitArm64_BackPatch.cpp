@@ -53,6 +53,28 @@ void JitArm64::DoBacktrace(uintptr_t access_address, SContext* ctx)
   ERROR_LOG_FMT(DYNA_REC, "Full block: {}", pc_memory);
 }
 
+FixupBranch JitArm64::SoftTLBLookup(ARM64Reg addr, ARM64Reg host_offset, ARM64Reg tmp,
+                                    u32 access_size, bool write)
+{
+  addr = EncodeRegTo32(addr);
+  host_offset = EncodeRegTo64(host_offset);
+  tmp = EncodeRegTo32(tmp);
+
+  MOVP2R(host_offset, m_mmu.GetSoftTLB(write).data());
+  UBFX(tmp, addr, PowerPC::HW_PAGE_INDEX_SHIFT, MathUtil::IntLog2(PowerPC::SOFT_TLB_SIZE));
+  ADD(host_offset, host_offset, EncodeRegTo64(tmp),
+      ArithOption(EncodeRegTo64(tmp), ShiftType::LSL, PowerPC::SOFT_TLB_ENTRY_SHIFT));
+  LDR(IndexType::Unsigned, tmp, host_offset, offsetof(PowerPC::SoftTLBEntry, tag));
+
+  // Misaligned accesses always miss, so that they can't cross into the next page
+  EOR(tmp, tmp, addr);
+  TST(tmp, LogicalImm(~static_cast<u32>(PowerPC::HW_PAGE_MASK) | (access_size / 8 - 1),
+                      GPRSize::B32));
+  FixupBranch miss = B(CC_NEQ);
+  LDR(IndexType::Unsigned, host_offset, host_offset, offsetof(PowerPC::SoftTLBEntry, host_offset));
+  return miss;
+}
+
 void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS, ARM64Reg addr,
                                     BitSet32 gprs_to_push, BitSet32 fprs_to_push,
                                     bool emitting_routine)
@@ -200,6 +222,13 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
       STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
     }
 
+    // Before calling into the MMU, try the software TLB. A hit does the access the same way as the
+    // call would and then skips it. Everything caller-saved is either free or pushed by now.
+    const bool soft_tlb = jo.soft_tlb && !emitting_routine &&
+                          !(flags & BackPatchInfo::FLAG_ZERO_256) &&
+                          (m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR);
+    std::optional<FixupBranch> soft_tlb_hit;
+
     if (flags & BackPatchInfo::FLAG_STORE)
     {
       ARM64Reg src_reg = RS;
@@ -222,6 +251,28 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
         src_reg = dst_reg;
       }
 
+      if (soft_tlb)
+      {
+        const ARM64Reg tmp = DecodeReg(src_reg) == DecodeReg(ARM64Reg::W0) ? ARM64Reg::W3 :
+                                                                              ARM64Reg::W0;
+        const FixupBranch miss = SoftTLBLookup(addr, ARM64Reg::X30, tmp, access_size, true);
+
+        // src_reg is in the form the Write functions take, so swap it the same way they do
+        const u32 size_flags = flags & ~(BackPatchInfo::FLAG_FLOAT | BackPatchInfo::FLAG_PAIR);
+        const ARM64Reg value =
+            ByteswapBeforeStore(this, &m_float_emit, access_size == 64 ? EncodeRegTo64(tmp) : tmp,
+                                src_reg, size_flags, true);
+        if (access_size == 64 || access_size == 32)
+          STR(value, ARM64Reg::X30, addr);
+        else if (access_size == 16)
+          STRH(value, ARM64Reg::X30, addr);
+        else
+          STRB(value, ARM64Reg::X30, addr);
+
+        soft_tlb_hit = B();
+        SetJumpTarget(miss);
+      }
+
       const bool reverse = (flags & BackPatchInfo::FLAG_REVERSE) != 0;
 
       if (access_size == 64)
@@ -250,6 +301,36 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
     }
     else
     {
+      if (soft_tlb)
+      {
+        const FixupBranch miss =
+            SoftTLBLookup(addr, ARM64Reg::X30, ARM64Reg::W0, access_size, false);
+
+        // Return the value in W0 or X0, the same way as the Read functions
+        if (access_size == 64)
+        {
+          LDR(ARM64Reg::X0, ARM64Reg::X30, addr);
+          REV64(ARM64Reg::X0, ARM64Reg::X0);
+        }
+        else if (access_size == 32)
+        {
+          LDR(ARM64Reg::W0, ARM64Reg::X30, addr);
+          REV32(ARM64Reg::W0, ARM64Reg::W0);
+        }
+        else if (access_size == 16)
+        {
+          LDRH(ARM64Reg::W0, ARM64Reg::X30, addr);
+          REV16(ARM64Reg::W0, ARM64Reg::W0);
+        }
+        else
+        {
+          LDRB(ARM64Reg::W0, ARM64Reg::X30, addr);
+        }
+
+        soft_tlb_hit = B();
+        SetJumpTarget(miss);
+      }
+
       if (access_size == 64)
         ABI_CallFunction(&PowerPC::ReadU64FromJit, &m_mmu, ARM64Reg::W1);
       else if (access_size == 32)
@@ -260,6 +341,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
         ABI_CallFunction(&PowerPC::ReadU8FromJit, &m_mmu, ARM64Reg::W1);
     }
 
+    if (soft_tlb_hit)
+      SetJumpTarget(*soft_tlb_hit);
+
     m_float_emit.ABI_PopRegisters(fprs_to_push, ARM64Reg::X30);
     ABI_PopRegisters(gprs_to_push & ~gprs_to_push_early);
 
@@ -194,10 +194,7 @@ void JitArm64::bx(UGeckoInstruction inst)
     }
 
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
     gpr.Unlock(WA);
 
     WriteExceptionExit(js.op->branchTo);
@@ -274,10 +271,7 @@ void JitArm64::bcx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
@@ -435,10 +429,7 @@ void JitArm64::bclrx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
@@ -87,6 +87,18 @@ void JitArm64::UpdateRoundingMode()
   ABI_PopRegisters(gprs_to_save);
 }
 
+void JitArm64::SRUpdated()
+{
+  const BitSet32 gprs_to_save = gpr.GetCallerSavedUsed();
+  const BitSet32 fprs_to_save = fpr.GetCallerSavedUsed();
+
+  ABI_PushRegisters(gprs_to_save);
+  m_float_emit.ABI_PushRegisters(fprs_to_save, ARM64Reg::X8);
+  ABI_CallFunction(&PowerPC::SRUpdatedFromJit, &m_mmu);
+  m_float_emit.ABI_PopRegisters(fprs_to_save, ARM64Reg::X8);
+  ABI_PopRegisters(gprs_to_save);
+}
+
 void JitArm64::mtmsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -174,6 +186,7 @@ void JitArm64::mtsr(UGeckoInstruction inst)
   JITDISABLE(bJITSystemRegistersOff);
 
   STR(IndexType::Unsigned, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF_SR(inst.SR));
+  SRUpdated();
 }
 
 void JitArm64::mfsrin(UGeckoInstruction inst)
@@ -214,6 +227,8 @@ void JitArm64::mtsrin(UGeckoInstruction inst)
   STR(RD, EncodeRegTo64(addr), ArithOption(EncodeRegTo64(index), true));
 
   gpr.Unlock(index, addr);
+
+  SRUpdated();
 }
 
 void JitArm64::twx(UGeckoInstruction inst)
@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Hash map from u64 keys using open addressing with linear probing. Entries are stored inline,
+// so a lookup usually touches a single cache line instead of chasing nodes. Erasing shifts the
+// following entries back rather than leaving tombstones, so lookups don't slow down as blocks
+// are created and destroyed.
+//
+// Pointers to values are invalidated by any insertion or erasure.
+template <typename Value>
+class FlatHashMap
+{
+public:
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  Value* Find(u64 key)
+  {
+    if (m_size == 0)
+      return nullptr;
+
+    for (size_t i = Hash(key) & m_mask;; i = (i + 1) & m_mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.used)
+        return nullptr;
+      if (slot.key == key)
+        return &slot.value;
+    }
+  }
+
+  const Value* Find(u64 key) const { return const_cast<FlatHashMap*>(this)->Find(key); }
+
+  // Inserts a default constructed value if the key isn't present yet
+  Value& operator[](u64 key)
+  {
+    // Keep the load factor at or below one half so that probe sequences stay short
+    if ((m_size + 1) * 2 > m_slots.size())
+      Grow();
+
+    for (size_t i = Hash(key) & m_mask;; i = (i + 1) & m_mask)
+    {
+      Slot& slot = m_slots[i];
+      if (slot.used && slot.key == key)
+        return slot.value;
+      if (!slot.used)
+      {
+        slot.used = true;
+        slot.key = key;
+        slot.value = Value();
+        ++m_size;
+        return slot.value;
+      }
+    }
+  }
+
+  void Erase(u64 key)
+  {
+    if (m_size == 0)
+      return;
+
+    size_t hole = Hash(key) & m_mask;
+    while (true)
+    {
+      if (!m_slots[hole].used)
+        return;
+      if (m_slots[hole].key == key)
+        break;
+      hole = (hole + 1) & m_mask;
+    }
+
+    // Move back every following entry of the cluster that may live in the hole, that is whose
+    // home slot doesn't lie cyclically between the hole and the entry's current slot.
+    for (size_t i = (hole + 1) & m_mask; m_slots[i].used; i = (i + 1) & m_mask)
+    {
+      const size_t home = Hash(m_slots[i].key) & m_mask;
+      if (((i - home) & m_mask) >= ((i - hole) & m_mask))
+      {
+        m_slots[hole] = std::move(m_slots[i]);
+        hole = i;
+      }
+    }
+
+    m_slots[hole].used = false;
+    m_slots[hole].value = Value();
+    --m_size;
+  }
+
+  void Clear()
+  {
+    m_slots.clear();
+    m_mask = 0;
+    m_size = 0;
+  }
+
+  template <typename F>
+  void ForEach(F f) const
+  {
+    for (const Slot& slot : m_slots)
+    {
+      if (slot.used)
+        f(slot.key, slot.value);
+    }
+  }
+
+private:
+  struct Slot
+  {
+    u64 key = 0;
+    Value value{};
+    bool used = false;
+  };
+
+  static size_t Hash(u64 key)
+  {
+    // Fibonacci hashing, block addresses are 4 byte aligned and clustered so the key itself
+    // makes for a poor index
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> old_slots = std::exchange(m_slots, {});
+    m_slots.resize(std::max<size_t>(16, old_slots.size() * 2));
+    m_mask = m_slots.size() - 1;
+    m_size = 0;
+
+    for (Slot& slot : old_slots)
+    {
+      if (slot.used)
+        (*this)[slot.key] = std::move(slot.value);
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_mask = 0;
+  size_t m_size = 0;
+};
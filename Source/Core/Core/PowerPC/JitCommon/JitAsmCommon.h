@@ -8,8 +8,10 @@
 alignas(16) extern const u8 pbswapShuffle1x4[16];
 alignas(16) extern const u8 pbswapShuffle2x4[16];
 alignas(16) extern const float m_one[4];
-alignas(16) extern const float m_quantizeTableS[128];
-alignas(16) extern const float m_dequantizeTableS[128];
+// One pair of scale factors per GQR scale, followed by a padding pair, so that a 16-byte read of
+// the last pair stays in bounds
+alignas(16) extern const float m_quantizeTableS[130];
+alignas(16) extern const float m_dequantizeTableS[130];
 
 struct CommonAsmRoutinesBase
 {
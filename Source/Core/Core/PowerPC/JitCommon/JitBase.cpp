@@ -90,6 +90,9 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  if (jit.GetBlockCache()->PrecompileProfiledBlocks(em_address))
+    return;
+
   jit.Jit(em_address);
 }
 
@@ -138,6 +141,8 @@ void JitBase::RefreshConfig()
   jo.fastmem = m_fastmem_enabled && jo.fastmem_arena && (m_ppc_state.msr.DR || !any_watchpoints) &&
                EMM::IsExceptionHandlerSupported();
   jo.memcheck = m_system.IsMMUMode() || m_system.IsPauseOnPanicMode() || any_watchpoints;
+  // Accesses which hit the software TLB skip the watchpoint checks and the data cache
+  jo.soft_tlb = m_system.IsMMUMode() && !any_watchpoints && !m_accurate_cpu_cache_enabled;
   jo.fp_exceptions = m_enable_float_exceptions;
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
 }
@@ -84,6 +84,8 @@ protected:
     bool fastmem;
     bool fastmem_arena;
     bool memcheck;
+    // Look up accesses which miss fastmem in the MMU's software TLB before calling into the MMU
+    bool soft_tlb;
     bool fp_exceptions;
     bool div_by_zero_exceptions;
   };
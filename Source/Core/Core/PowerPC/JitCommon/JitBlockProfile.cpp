@@ -0,0 +1,126 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
+
+#include <utility>
+
+#include "Common/Logging/Log.h"
+
+class JitBlockProfile::Reader final : public Common::LinearDiskCacheReader<DiskKey, u32>
+{
+public:
+  explicit Reader(JitBlockProfile& profile) : m_profile(profile) {}
+
+  void Read(const DiskKey& key, const u32* value, u32 value_size) override
+  {
+    m_profile.m_known.emplace(key.kind, key.effective_address, key.feature_flags, key.code_hash);
+
+    if (key.kind != EntryKind::Block)
+    {
+      m_profile.m_learned[key.kind].insert(key.effective_address);
+      return;
+    }
+
+    const u64 pending_key = PendingKey(key.effective_address, key.feature_flags);
+    Block block{key.effective_address, key.physical_address, key.feature_flags, key.code_hash,
+                std::vector<u32>(value, value + value_size)};
+
+    // A block that changed since it was recorded has a second entry, the last one wins
+    if (!m_profile.m_pending.insert_or_assign(pending_key, std::move(block)).second)
+      return;
+
+    m_profile.m_pending_regions[key.effective_address >> REGION_SHIFT].push_back(pending_key);
+  }
+
+private:
+  JitBlockProfile& m_profile;
+};
+
+void JitBlockProfile::Open(const std::string& filename)
+{
+  Close();
+
+  Reader reader(*this);
+  const u32 count = m_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} JIT profile entries ({} blocks) from {}", count,
+               m_pending.size(), filename);
+  m_open = true;
+}
+
+void JitBlockProfile::Close()
+{
+  if (!m_open)
+    return;
+
+  m_disk_cache.Sync();
+  m_disk_cache.Close();
+  m_open = false;
+
+  m_known.clear();
+  m_pending.clear();
+  m_pending_regions.clear();
+  m_learned.clear();
+}
+
+void JitBlockProfile::AddBlock(Block block)
+{
+  if (!m_known.emplace(EntryKind::Block, block.effective_address, block.feature_flags,
+                       block.code_hash)
+           .second)
+  {
+    return;
+  }
+
+  const DiskKey key{block.code_hash, block.effective_address, block.physical_address,
+                    block.feature_flags, EntryKind::Block};
+  m_disk_cache.Append(key, block.physical_addresses.data(),
+                      static_cast<u32>(block.physical_addresses.size()));
+}
+
+void JitBlockProfile::AddLearnedAddresses(EntryKind kind,
+                                          const std::unordered_set<u32>& addresses)
+{
+  std::unordered_set<u32>& learned = m_learned[kind];
+  for (const u32 address : addresses)
+  {
+    if (!learned.insert(address).second)
+      continue;
+
+    m_known.emplace(kind, address, 0, 0);
+    const DiskKey key{0, address, 0, 0, kind};
+    m_disk_cache.Append(key, nullptr, 0);
+  }
+}
+
+void JitBlockProfile::ApplyLearnedAddresses(EntryKind kind,
+                                            std::unordered_set<u32>* addresses) const
+{
+  const auto it = m_learned.find(kind);
+  if (it != m_learned.end())
+    addresses->insert(it->second.begin(), it->second.end());
+}
+
+std::vector<JitBlockProfile::Block> JitBlockProfile::TakeBlocksNear(u32 address, u32 feature_flags)
+{
+  std::vector<Block> blocks;
+  if (!m_pending.contains(PendingKey(address, feature_flags)))
+    return blocks;
+
+  // Every block is handed out at most once, so code that was since overwritten doesn't cost a
+  // hash check on every miss in its region
+  std::vector<u64>& region = m_pending_regions[address >> REGION_SHIFT];
+  std::erase_if(region, [&](u64 key) {
+    const auto it = m_pending.find(key);
+    if (it == m_pending.end())
+      return true;
+    if (it->second.feature_flags != feature_flags)
+      return false;
+
+    blocks.push_back(std::move(it->second));
+    m_pending.erase(it);
+    return true;
+  });
+
+  return blocks;
+}
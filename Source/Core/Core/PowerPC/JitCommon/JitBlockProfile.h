@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+// Remembers which blocks a game compiled in earlier sessions, along with the addresses the JIT
+// learned to treat specially, so that later boots can compile those blocks in batches up front
+// instead of one at a time as execution first reaches each of them.
+//
+// Only guest addresses and a hash of the guest code are stored, not host code: the emitted code
+// refers to the dispatcher, the asm routines and the far code by absolute address.
+class JitBlockProfile
+{
+public:
+  enum class EntryKind : u32
+  {
+    Block,
+    // The addresses in JitBase::JitState that force a block to be recompiled once discovered
+    FifoWrite,
+    PairedQuantize,
+    NoSpeculativeConstants,
+  };
+
+  // On disk key, the value is the block's physical addresses
+  struct DiskKey
+  {
+    u64 code_hash;
+    u32 effective_address;
+    u32 physical_address;
+    u32 feature_flags;
+    EntryKind kind;
+  };
+
+  struct Block
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 feature_flags;
+    u64 code_hash;
+    // Sorted, as in JitBlock::physical_addresses
+    std::vector<u32> physical_addresses;
+  };
+
+  // Blocks are grouped in regions of this size, see TakeBlocksNear()
+  static constexpr u32 REGION_SHIFT = 20;
+
+  bool IsOpen() const { return m_open; }
+  void Open(const std::string& filename);
+  void Close();
+
+  void AddBlock(Block block);
+  void AddLearnedAddresses(EntryKind kind, const std::unordered_set<u32>& addresses);
+  void ApplyLearnedAddresses(EntryKind kind, std::unordered_set<u32>* addresses) const;
+
+  bool HasPendingBlocks() const { return !m_pending.empty(); }
+  // If a profiled block starts at address, removes and returns the pending blocks in the same
+  // region with the same feature flags. Returns nothing otherwise.
+  std::vector<Block> TakeBlocksNear(u32 address, u32 feature_flags);
+
+private:
+  class Reader;
+
+  static u64 PendingKey(u32 address, u32 feature_flags)
+  {
+    return (u64{feature_flags} << 32) | address;
+  }
+
+  bool m_open = false;
+  Common::LinearDiskCache<DiskKey, u32> m_disk_cache;
+
+  // Everything already in the file, so that it is only appended once
+  std::set<std::tuple<EntryKind, u32, u32, u64>> m_known;
+
+  std::unordered_map<u64, Block> m_pending;
+  std::map<u32, std::vector<u64>> m_pending_regions;
+
+  std::map<EntryKind, std::unordered_set<u32>> m_learned;
+};
@@ -7,13 +7,21 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
@@ -26,10 +34,18 @@
 
 using namespace Gen;
 
+namespace
+{
+u64 LookupKey(u32 em_address, CPUEmuFeatureFlags feature_flags)
+{
+  return (u64{feature_flags} << 32) | em_address;
+}
+}  // namespace
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto it = std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address);
+  return it != physical_addresses.end() && *it < u64{address} + length;
 }
 
 void JitBlock::ProfileData::BeginProfiling(ProfileData* data)
@@ -60,6 +76,8 @@ void JitBaseBlockCache::Init()
     m_entry_points_ptr = reinterpret_cast<u8**>(m_entry_points_arena.Create(FAST_BLOCK_MAP_SIZE));
 #endif
 
+  OpenBlockProfile();
+
   Clear();
 }
 
@@ -67,6 +85,10 @@ void JitBaseBlockCache::Shutdown()
 {
   Common::JitRegister::Shutdown();
 
+  SaveLearnedAddresses();
+  m_block_profile.Close();
+  m_precompile_queue.clear();
+
   m_entry_points_arena.Release();
 }
 
@@ -77,16 +99,25 @@ void JitBaseBlockCache::Clear()
 #if defined(_DEBUG) || defined(DEBUGFAST)
   Core::DisplayMessage("Clearing code cache.", 3000);
 #endif
+  SaveLearnedAddresses();
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
-  for (auto& e : block_map)
+  RestoreLearnedAddresses();
+  for (JitBlock& block : m_block_arena)
   {
-    DestroyBlock(e.second);
+    if (block.in_use)
+      DestroyBlock(block);
   }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
+  m_block_arena.clear();
+  m_free_blocks.clear();
+  block_lookup.Clear();
+  links_to.Clear();
+  for (auto& chunk : block_pages)
+    chunk.reset();
+
+  if (m_lower_tier)
+    m_lower_tier->Clear();
 
   valid_block.ClearAll();
 
@@ -113,20 +144,54 @@ JitBlock** JitBaseBlockCache::GetFastBlockMapFallback()
 void JitBaseBlockCache::RunOnBlocks(const Core::CPUThreadGuard&,
                                     std::function<void(const JitBlock&)> f) const
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  std::vector<const JitBlock*> blocks;
+  for (const JitBlock& block : m_block_arena)
+  {
+    if (block.in_use)
+      blocks.push_back(&block);
+  }
+
+  // Keep the order stable for the users which dump the blocks
+  std::stable_sort(blocks.begin(), blocks.end(), [](const JitBlock* a, const JitBlock* b) {
+    return a->physicalAddress < b->physicalAddress;
+  });
+  for (const JitBlock* block : blocks)
+    f(*block);
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = m_jit.m_mmu.JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, m_jit.IsProfilingEnabled())->second;
-  b.effectiveAddress = em_address;
-  b.physicalAddress = physical_address;
-  b.feature_flags = m_jit.m_ppc_state.feature_flags;
-  b.linkData.clear();
-  b.fast_block_map_index = 0;
-  return &b;
+  const bool profiling_enabled = m_jit.IsProfilingEnabled();
+
+  JitBlock* b;
+  if (m_free_blocks.empty())
+  {
+    b = &m_block_arena.emplace_back(profiling_enabled);
+  }
+  else
+  {
+    b = m_free_blocks.back();
+    m_free_blocks.pop_back();
+    b->profile_data = profiling_enabled ? std::make_unique<JitBlock::ProfileData>() : nullptr;
+  }
+
+  static_cast<JitBlockData&>(*b) = {};
+
+  b->effectiveAddress = em_address;
+  b->physicalAddress = physical_address;
+  b->feature_flags = m_jit.m_ppc_state.feature_flags;
+  b->linkData.clear();
+  b->physical_addresses.clear();
+  b->fast_block_map_index = 0;
+  b->in_use = true;
+  b->tier_run_count = 0;
+
+  // Register the block right away so that it can link to itself
+  JitBlock*& head = block_lookup[LookupKey(em_address, b->feature_flags)];
+  b->next_in_lookup = head;
+  head = b;
+  return b;
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
@@ -144,20 +209,40 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   }
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
+
+  if (m_block_profile.IsOpen())
+  {
+    const std::optional<u64> hash =
+        HashGuestCode(block.effectiveAddress, block.physicalAddress, block.physical_addresses);
+    if (hash)
+    {
+      m_block_profile.AddBlock({block.effectiveAddress, block.physicalAddress,
+                                block.feature_flags, *hash, block.physical_addresses});
+    }
+  }
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
+  // The addresses are sorted, so each page only needs to be compared with the previous one
+  u32 last_page = UINT32_MAX;
+  for (u32 addr : block.physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+
+    const u32 page = addr >> BLOCK_PAGE_SHIFT;
+    if (page != last_page)
+    {
+      GetBlockPage(page).push_back(&block);
+      last_page = page;
+    }
   }
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      std::vector<JitBlock*>& sources = links_to[e.exitAddress];
+      if (std::find(sources.begin(), sources.end(), &block) == sources.end())
+        sources.push_back(&block);
     }
 
     LinkBlock(block);
@@ -190,12 +275,14 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFla
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  JitBlock* const* head = block_lookup.Find(LookupKey(addr, feature_flags));
+  if (!head)
+    return nullptr;
+
+  for (JitBlock* b = *head; b; b = b->next_in_lookup)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.feature_flags == feature_flags)
-      return &b;
+    if (b->physicalAddress == translated_addr)
+      return b;
   }
 
   return nullptr;
@@ -238,6 +325,58 @@ const u8* JitBaseBlockCache::Dispatch()
   return block->normalEntry;
 }
 
+bool JitBaseBlockCache::PrecompileProfiledBlocks(u32 em_address)
+{
+  if (m_jit.IsDebuggingEnabled())
+    return false;
+
+  const CPUEmuFeatureFlags feature_flags = m_jit.m_ppc_state.feature_flags;
+  if (m_block_profile.HasPendingBlocks())
+  {
+    // The missed block goes first, the rest of its region waits for the following misses
+    std::vector<JitBlockProfile::Block> profiled_blocks =
+        m_block_profile.TakeBlocksNear(em_address, feature_flags);
+    for (JitBlockProfile::Block& profiled : profiled_blocks)
+    {
+      if (profiled.effective_address == em_address)
+        m_precompile_queue.push_front(std::move(profiled));
+      else
+        m_precompile_queue.push_back(std::move(profiled));
+    }
+  }
+
+  size_t compiled = 0;
+  while (!m_precompile_queue.empty() && compiled < MAX_PRECOMPILES_PER_MISS)
+  {
+    const JitBlockProfile::Block profiled = std::move(m_precompile_queue.front());
+    m_precompile_queue.pop_front();
+
+    // Blocks queued under other feature flags are left to be compiled on demand
+    if (profiled.feature_flags != feature_flags ||
+        GetBlockFromStartAddress(profiled.effective_address, feature_flags))
+    {
+      continue;
+    }
+
+    // Skip code that was overwritten or is mapped differently since it was profiled
+    const std::optional<u64> hash = HashGuestCode(
+        profiled.effective_address, profiled.physical_address, profiled.physical_addresses);
+    if (hash != profiled.code_hash)
+      continue;
+
+    m_jit.Jit(profiled.effective_address);
+    ++compiled;
+  }
+
+  if (compiled != 0)
+  {
+    DEBUG_LOG_FMT(DYNA_REC, "Precompiled {} profiled blocks at {:#010x}, {} still queued",
+                  compiled, em_address, m_precompile_queue.size());
+  }
+
+  return GetBlockFromStartAddress(em_address, feature_flags) != nullptr;
+}
+
 void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 {
   const u32 cache_line_address = address & ~0x1f;
@@ -304,6 +443,8 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   {
     // destroy JIT blocks
     ErasePhysicalRange(physical_address, length);
+    if (m_lower_tier)
+      m_lower_tier->ErasePhysicalRange(physical_address, length);
 
     // If the code was actually modified, we need to clear the relevant entries from the
     // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
@@ -323,51 +464,170 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Collect the overlapping blocks of all pages in the range first, a block spanning several
+  // pages shows up once per page and erasing it modifies the page lists.
+  m_blocks_to_erase.clear();
+  const u32 first_page = address >> BLOCK_PAGE_SHIFT;
+  const u32 last_page = static_cast<u32>((u64{address} + length - 1) >> BLOCK_PAGE_SHIFT);
+  for (u32 page = first_page; page <= last_page; ++page)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    const std::vector<JitBlock*>* blocks = FindBlockPage(page);
+    if (!blocks)
+      continue;
+
+    for (JitBlock* block : *blocks)
     {
-      JitBlock* block = *iter;
       if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+        m_blocks_to_erase.push_back(block);
     }
+  }
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+  std::sort(m_blocks_to_erase.begin(), m_blocks_to_erase.end());
+  m_blocks_to_erase.erase(std::unique(m_blocks_to_erase.begin(), m_blocks_to_erase.end()),
+                          m_blocks_to_erase.end());
+
+  for (JitBlock* block : m_blocks_to_erase)
+    EraseBlock(*block);
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  DestroyBlock(block);
+  UnregisterBlockLookup(block);
+
+  u32 last_page = UINT32_MAX;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr >> BLOCK_PAGE_SHIFT;
+    if (page == last_page)
+      continue;
+    last_page = page;
+
+    // The order within a page doesn't matter, so swap with the last element instead of shifting
+    std::vector<JitBlock*>& blocks = GetBlockPage(page);
+    const auto it = std::find(blocks.begin(), blocks.end(), &block);
+    if (it != blocks.end())
+    {
+      *it = blocks.back();
+      blocks.pop_back();
+    }
+  }
+
+  block.in_use = false;
+  block.linkData.clear();
+  block.physical_addresses.clear();
+  block.profile_data.reset();
+  m_free_blocks.push_back(&block);
+}
+
+void JitBaseBlockCache::SetLowerTier(JitBaseBlockCache* lower_tier)
+{
+  m_lower_tier = lower_tier;
+
+  // The lower tier compiles the same addresses under the same profile name, only this cache
+  // should record them
+  if (m_lower_tier)
+    m_lower_tier->m_block_profile.Close();
+}
+
+void JitBaseBlockCache::UnregisterBlockLookup(JitBlock& block)
+{
+  const u64 key = LookupKey(block.effectiveAddress, block.feature_flags);
+  JitBlock** head = block_lookup.Find(key);
+  if (!head)
+    return;
+
+  for (JitBlock** link = head; *link; link = &(*link)->next_in_lookup)
+  {
+    if (*link == &block)
+    {
+      *link = block.next_in_lookup;
+      break;
+    }
   }
+  block.next_in_lookup = nullptr;
+
+  if (!*head)
+    block_lookup.Erase(key);
+}
+
+std::vector<JitBlock*>& JitBaseBlockCache::GetBlockPage(u32 page)
+{
+  std::unique_ptr<BlockPageChunk>& chunk = block_pages[page >> BLOCK_PAGE_CHUNK_SHIFT];
+  if (!chunk)
+    chunk = std::make_unique<BlockPageChunk>();
+  return (*chunk)[page & (BLOCK_PAGE_CHUNK_ELEMENTS - 1)];
+}
+
+const std::vector<JitBlock*>* JitBaseBlockCache::FindBlockPage(u32 page) const
+{
+  const std::unique_ptr<BlockPageChunk>& chunk = block_pages[page >> BLOCK_PAGE_CHUNK_SHIFT];
+  if (!chunk)
+    return nullptr;
+  return &(*chunk)[page & (BLOCK_PAGE_CHUNK_ELEMENTS - 1)];
+}
+
+void JitBaseBlockCache::OpenBlockProfile()
+{
+  m_block_profile.Close();
+  m_precompile_queue.clear();
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (!Config::Get(Config::MAIN_JIT_BLOCK_PROFILE) || game_id.empty())
+    return;
+
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + JITPROFILE_DIR DIR_SEP;
+  if (!File::Exists(dir))
+    File::CreateFullPath(dir);
+
+  // Where blocks end depends on the CPU core and on branch following
+  m_block_profile.Open(fmt::format("{}{}-{}{}.cache", dir, game_id,
+                                   static_cast<int>(Config::Get(Config::MAIN_CPU_CORE)),
+                                   Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH) ? "-bf" : ""));
+}
+
+void JitBaseBlockCache::SaveLearnedAddresses()
+{
+  if (!m_block_profile.IsOpen())
+    return;
+
+  using Kind = JitBlockProfile::EntryKind;
+  m_block_profile.AddLearnedAddresses(Kind::FifoWrite, m_jit.js.fifoWriteAddresses);
+  m_block_profile.AddLearnedAddresses(Kind::PairedQuantize, m_jit.js.pairedQuantizeAddresses);
+  m_block_profile.AddLearnedAddresses(Kind::NoSpeculativeConstants,
+                                      m_jit.js.noSpeculativeConstantsAddresses);
+}
+
+void JitBaseBlockCache::RestoreLearnedAddresses()
+{
+  if (!m_block_profile.IsOpen())
+    return;
+
+  using Kind = JitBlockProfile::EntryKind;
+  m_block_profile.ApplyLearnedAddresses(Kind::FifoWrite, &m_jit.js.fifoWriteAddresses);
+  m_block_profile.ApplyLearnedAddresses(Kind::PairedQuantize, &m_jit.js.pairedQuantizeAddresses);
+  m_block_profile.ApplyLearnedAddresses(Kind::NoSpeculativeConstants,
+                                        &m_jit.js.noSpeculativeConstantsAddresses);
+}
+
+std::optional<u64> JitBaseBlockCache::HashGuestCode(u32 em_address, u32 physical_address,
+                                                    std::span<const u32> physical_addresses)
+{
+  std::vector<u32> code;
+  code.reserve(physical_addresses.size());
+  for (const u32 address : physical_addresses)
+  {
+    const auto read = m_jit.m_mmu.TryReadInstruction(em_address + (address - physical_address));
+    if (!read.valid || read.physical_address != address)
+      return std::nullopt;
+    code.push_back(read.hex);
+  }
+
+  return Common::GetHash64(reinterpret_cast<const u8*>(code.data()),
+                           static_cast<u32>(code.size() * sizeof(u32)), 0);
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -404,11 +664,11 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
 
-  for (JitBlock* b2 : it->second)
+  for (JitBlock* b2 : *sources)
   {
     if (block.feature_flags == b2->feature_flags)
       LinkBlockExits(*b2);
@@ -424,10 +684,10 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
-  for (JitBlock* sourceBlock : it->second)
+  for (JitBlock* sourceBlock : *sources)
   {
     if (sourceBlock->feature_flags != block.feature_flags)
       continue;
@@ -465,12 +725,17 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   // Delete linking addresses
   for (const auto& e : block.linkData)
   {
-    auto it = links_to.find(e.exitAddress);
-    if (it == links_to.end())
+    std::vector<JitBlock*>* sources = links_to.Find(e.exitAddress);
+    if (!sources)
       continue;
-    it->second.erase(&block);
-    if (it->second.empty())
-      links_to.erase(it);
+    const auto it = std::find(sources->begin(), sources->end(), &block);
+    if (it != sources->end())
+    {
+      *it = sources->back();
+      sources->pop_back();
+    }
+    if (sources->empty())
+      links_to.Erase(e.exitAddress);
   }
 
   // Raise an signal if we are going to call this block again
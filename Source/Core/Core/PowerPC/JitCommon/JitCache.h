@@ -7,18 +7,20 @@
 #include <bitset>
 #include <chrono>
 #include <cstring>
+#include <deque>
 #include <functional>
-#include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <span>
 #include <type_traits>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitCommon/FlatHashMap.h"
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
 
 class JitBase;
 
@@ -40,7 +42,7 @@ struct JitBlockData
   // The effective address (PC) for the beginning of the block.
   u32 effectiveAddress;
   // The physical address of the code represented by this block.
-  // Various maps in the cache are indexed by this (block_map
+  // Various maps in the cache are indexed by this (the page index
   // and valid_block in particular). This is useful because of
   // of the way the instruction cache works on PowerPC.
   u32 physicalAddress;
@@ -102,10 +104,18 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical addresses of all occupied instructions, sorted.
+  std::vector<u32> physical_addresses;
 
   std::unique_ptr<ProfileData> profile_data;
+
+  // The next block with the same effective address and feature flags but a different physical
+  // address, see JitBaseBlockCache::block_lookup.
+  JitBlock* next_in_lookup = nullptr;
+  // False while the block sits in the free list waiting to be reused.
+  bool in_use = false;
+  // How often the block ran while it was compiled by a lower tier, see Jit64::RunColdBlock.
+  u32 tier_run_count = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -176,9 +186,21 @@ public:
   // assembly version.)
   const u8* Dispatch();
 
+  // Called before compiling the block at em_address. If the block profile has it, queues all
+  // profiled blocks near it, then compiles up to MAX_PRECOMPILES_PER_MISS queued blocks whose
+  // guest code is unchanged, starting with em_address. Returns true if the block at em_address
+  // was compiled as part of that.
+  bool PrecompileProfiledBlocks(u32 em_address);
+
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Destroys the block, removes it from all lookup structures and returns it to the free list
+  void EraseBlock(JitBlock& block);
+
+  // Sets the block cache of a lower compilation tier that runs the same guest code, or nullptr.
+  // Clearing this cache or invalidating guest code in it does the same to the lower tier.
+  void SetLowerTier(JitBaseBlockCache* lower_tier);
 
   u32* GetBlockBitSet() const;
 
@@ -194,31 +216,65 @@ private:
   void LinkBlockExits(JitBlock& block);
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
+  void UnregisterBlockLookup(JitBlock& block);
+  std::vector<JitBlock*>& GetBlockPage(u32 page);
+  const std::vector<JitBlock*>* FindBlockPage(u32 page) const;
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
 
+  void OpenBlockProfile();
+  void SaveLearnedAddresses();
+  void RestoreLearnedAddresses();
+  // Hashes the guest code of a block, assuming it is mapped linearly around its start address as
+  // it is with BATs. Returns nothing if the code can't be read or isn't mapped that way.
+  std::optional<u64> HashGuestCode(u32 em_address, u32 physical_address,
+                                   std::span<const u32> physical_addresses);
+
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
+  // All blocks live in this arena. A deque never moves its elements, so block pointers stay
+  // valid, and erased blocks are put on the free list to be reused by the next allocation.
+  std::deque<JitBlock> m_block_arena;
+  std::vector<JitBlock*> m_free_blocks;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  FlatHashMap<std::vector<JitBlock*>> links_to;  // destination_PC -> source blocks
 
-  // Map indexed by the physical address of the entry point.
+  // Blocks indexed by feature flags and effective address of the entry point. Blocks which only
+  // differ in their physical address are chained through JitBlock::next_in_lookup.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  FlatHashMap<JitBlock*> block_lookup;
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  // The blocks overlapping each 4 KiB page of physical memory, used for invalidating memory
+  // regions. The page table has two levels so that only the parts of the address space which
+  // hold code take up memory.
+  static constexpr u32 BLOCK_PAGE_SHIFT = 12;
+  static constexpr u32 BLOCK_PAGE_CHUNK_SHIFT = 10;
+  static constexpr u32 BLOCK_PAGE_CHUNK_ELEMENTS = 1 << BLOCK_PAGE_CHUNK_SHIFT;
+  static constexpr u32 BLOCK_PAGE_CHUNKS = 1 << (32 - BLOCK_PAGE_SHIFT - BLOCK_PAGE_CHUNK_SHIFT);
+  using BlockPageChunk = std::array<std::vector<JitBlock*>, BLOCK_PAGE_CHUNK_ELEMENTS>;
+  std::array<std::unique_ptr<BlockPageChunk>, BLOCK_PAGE_CHUNKS> block_pages;
+
+  // Scratch space for ErasePhysicalRange, kept around to avoid allocating on every invalidation
+  std::vector<JitBlock*> m_blocks_to_erase;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
+  // Blocks compiled in earlier sessions of the running game, see JitBlockProfile
+  JitBlockProfile m_block_profile;
+
+  // Profiled blocks taken from m_block_profile but not compiled yet. A region can hold thousands
+  // of blocks, so they are spread over the following misses instead of stalling a single one.
+  static constexpr size_t MAX_PRECOMPILES_PER_MISS = 16;
+  std::deque<JitBlockProfile::Block> m_precompile_queue;
+
+  JitBaseBlockCache* m_lower_tier = nullptr;
+
   // This contains the entry points for each block.
   // It is used by the assembly dispatcher to quickly
   // know where to jump based on pc and msr bits.
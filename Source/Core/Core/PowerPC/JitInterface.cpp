@@ -224,6 +224,25 @@ JitInterface::GetHostCode(u32 address) const
   return result;
 }
 
+void JitInterface::GetBlocksFromHostCode(const Core::CPUThreadGuard& guard,
+                                         std::span<const uintptr_t> host_addresses,
+                                         std::span<std::optional<u32>> block_addresses) const
+{
+  std::ranges::fill(block_addresses, std::nullopt);
+  if (!m_jit)
+    return;
+
+  m_jit->GetBlockCache()->RunOnBlocks(guard, [&](const JitBlock& block) {
+    const auto find = [&](const u8* begin, const u8* end) {
+      auto it = std::ranges::lower_bound(host_addresses, reinterpret_cast<uintptr_t>(begin));
+      for (; it != host_addresses.end() && *it < reinterpret_cast<uintptr_t>(end); ++it)
+        block_addresses[it - host_addresses.begin()] = block.effectiveAddress;
+    };
+    find(block.near_begin, block.near_end);
+    find(block.far_begin, block.far_end);
+  });
+}
+
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
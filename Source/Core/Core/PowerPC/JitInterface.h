@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -58,6 +60,11 @@ public:
   void UpdateMembase();
   void JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
+  // Finds the JIT block containing each of the sorted host code addresses, and stores the effective
+  // address of that block, or nullopt if there is none.
+  void GetBlocksFromHostCode(const Core::CPUThreadGuard& guard,
+                             std::span<const uintptr_t> host_addresses,
+                             std::span<std::optional<u32>> block_addresses) const;
 
   // Memory Utilities
   bool HandleFault(uintptr_t access_address, SContext* ctx);
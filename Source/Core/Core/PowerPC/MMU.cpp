@@ -54,6 +54,7 @@ namespace PowerPC
 MMU::MMU(Core::System& system, Memory::MemoryManager& memory, PowerPC::PowerPCManager& power_pc)
     : m_system(system), m_memory(memory), m_power_pc(power_pc), m_ppc_state(power_pc.GetPPCState())
 {
+  InvalidateSoftTLB();
 }
 
 MMU::~MMU() = default;
@@ -169,7 +170,9 @@ T MMU::ReadFromHardware(u32 em_address)
     return static_cast<T>(var);
   }
 
+  const u32 effective_address = em_address;
   bool wi = false;
+  bool cache_translation = false;
 
   if (!never_translate &&
       (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value()))
@@ -183,6 +186,8 @@ T MMU::ReadFromHardware(u32 em_address)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    cache_translation = flag == XCheckTLBFlag::Read && !wi &&
+                        translated_addr.result == TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED;
   }
 
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
@@ -217,6 +222,8 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetRAM()[em_address], sizeof(T));
+      if (cache_translation)
+        UpdateSoftTLB(m_soft_tlb_read, effective_address, &m_memory.GetRAM()[em_address]);
     }
     else
     {
@@ -236,6 +243,8 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetEXRAM()[em_address], sizeof(T));
+      if (cache_translation)
+        UpdateSoftTLB(m_soft_tlb_read, effective_address, &m_memory.GetEXRAM()[em_address]);
     }
     else
     {
@@ -288,7 +297,9 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     return;
   }
 
+  const u32 effective_address = em_address;
   bool wi = false;
+  bool cache_translation = false;
 
   if (!never_translate && m_ppc_state.msr.DR)
   {
@@ -301,6 +312,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    // The C bit of the page table entry has been set by now, so later writes don't need to
+    // go through the translation
+    cache_translation = flag == XCheckTLBFlag::Write && !wi &&
+                        translated_addr.result == TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED;
   }
 
   // Check for a gather pipe write (which are not implemented through the MMIO system).
@@ -417,6 +432,9 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
       std::memcpy(&m_memory.GetRAM()[em_address], &swapped_data, size);
 
+    if (cache_translation && !m_ppc_state.m_enable_dcache)
+      UpdateSoftTLB(m_soft_tlb_write, effective_address, &m_memory.GetRAM()[em_address]);
+
     return;
   }
 
@@ -434,6 +452,9 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
       std::memcpy(&m_memory.GetEXRAM()[em_address], &swapped_data, size);
 
+    if (cache_translation && !m_ppc_state.m_enable_dcache)
+      UpdateSoftTLB(m_soft_tlb_write, effective_address, &m_memory.GetEXRAM()[em_address]);
+
     return;
   }
 
@@ -1324,6 +1345,49 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  InvalidateSoftTLB();
+}
+
+void MMU::SRUpdated()
+{
+  InvalidateSoftTLB();
+}
+
+void MMU::InvalidateSoftTLB()
+{
+  for (u32 i = 0; i < SOFT_TLB_SIZE; ++i)
+    InvalidateSoftTLBPage(i);
+}
+
+void MMU::InvalidateSoftTLBPage(u32 page_index)
+{
+  const u32 entry_index = page_index % SOFT_TLB_SIZE;
+  // The page right after (or before) this one always maps to a different entry
+  const u32 invalid_tag = (entry_index ^ 1) << HW_PAGE_INDEX_SHIFT;
+
+  m_soft_tlb_read[entry_index] = {.tag = invalid_tag, .host_offset = 0};
+  m_soft_tlb_write[entry_index] = {.tag = invalid_tag, .host_offset = 0};
+}
+
+void MMU::UpdateSoftTLB(SoftTLB& tlb, u32 effective_address, u8* host_address)
+{
+  SoftTLBEntry& entry = tlb[(effective_address >> HW_PAGE_INDEX_SHIFT) % SOFT_TLB_SIZE];
+  entry.tag = effective_address & ~static_cast<u32>(HW_PAGE_MASK);
+  entry.host_offset = reinterpret_cast<uintptr_t>(host_address) - effective_address;
+}
+
+u8* MMU::LookupSoftTLB(u32 effective_address, u32 access_size, bool write) const
+{
+  const SoftTLBEntry& entry =
+      GetSoftTLB(write)[(effective_address >> HW_PAGE_INDEX_SHIFT) % SOFT_TLB_SIZE];
+
+  // Misaligned accesses always miss, so that they can't cross into the next page
+  const u32 tag = effective_address & (~static_cast<u32>(HW_PAGE_MASK) | (access_size / 8 - 1));
+  if (tag != entry.tag)
+    return nullptr;
+
+  return reinterpret_cast<u8*>(entry.host_offset + effective_address);
 }
 
 enum class TLBLookupResult
@@ -1413,6 +1477,10 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+
+  // tlbie invalidates the whole congruence class, no matter which segment the pages are in
+  for (u32 i = entry_index; i < SOFT_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+    InvalidateSoftTLBPage(i);
 }
 
 // Page Address Translation
@@ -1643,6 +1711,8 @@ void MMU::DBATUpdated()
   m_memory.UpdateLogicalMemory(m_dbat_table);
 #endif
 
+  InvalidateSoftTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   m_system.GetJitInterface().ClearSafe();
 }
@@ -1692,6 +1762,10 @@ void ClearDCacheLineFromJit(MMU& mmu, u32 address)
 {
   mmu.ClearDCacheLine(address);
 }
+void SRUpdatedFromJit(MMU& mmu)
+{
+  mmu.SRUpdated();
+}
 u32 ReadU8FromJit(MMU& mmu, u32 address)
 {
   return mmu.Read_U8(address);
@@ -72,6 +72,25 @@ constexpr size_t HW_PAGE_MASK = HW_PAGE_SIZE - 1;
 constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
 constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
 
+// The software TLB caches the host pointers of recently used page table translations, so that
+// the JITs can do an MMU-mode access which misses fastmem without calling into the MMU. It is
+// direct-mapped, and indexed by the low bits of the effective page number.
+constexpr u32 SOFT_TLB_SIZE = 1024;
+constexpr u32 SOFT_TLB_ENTRY_SHIFT = 4;
+
+struct SoftTLBEntry
+{
+  // Effective address of the page. Entries which aren't in use hold a page that can't map to
+  // their index.
+  u32 tag;
+  u32 : 32;
+  // Host pointer of the page minus the effective address of the page
+  u64 host_offset;
+};
+static_assert(sizeof(SoftTLBEntry) == 1 << SOFT_TLB_ENTRY_SHIFT);
+
+using SoftTLB = std::array<SoftTLBEntry, SOFT_TLB_SIZE>;
+
 // Return value of MMU::TryReadInstruction().
 struct TryReadInstResult
 {
@@ -241,6 +260,7 @@ public:
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
+  void SRUpdated();
 
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
@@ -256,6 +276,17 @@ public:
   BatTable& GetIBATTable() { return m_ibat_table; }
   BatTable& GetDBATTable() { return m_dbat_table; }
 
+  // Only holds translations which are safe to use for accesses of this kind without an exception
+  // check: readable pages for reads, and pages with the C bit set for writes.
+  const SoftTLB& GetSoftTLB(bool write) const
+  {
+    return write ? m_soft_tlb_write : m_soft_tlb_read;
+  }
+
+  // The lookup the JITs emit inline. Returns the host pointer for an access of access_size bits,
+  // or nullptr on a miss.
+  u8* LookupSoftTLB(u32 effective_address, u32 access_size, bool write) const;
+
 private:
   enum class TranslateAddressResultEnum : u8
   {
@@ -305,6 +336,10 @@ private:
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
 
+  void InvalidateSoftTLB();
+  void InvalidateSoftTLBPage(u32 page_index);
+  static void UpdateSoftTLB(SoftTLB& tlb, u32 effective_address, u8* host_address);
+
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
   template <XCheckTLBFlag flag, bool never_translate = false>
@@ -326,9 +361,13 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  SoftTLB m_soft_tlb_read;
+  SoftTLB m_soft_tlb_write;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
+void SRUpdatedFromJit(MMU& mmu);
 u32 ReadU8FromJit(MMU& mmu, u32 address);   // Returns zero-extended 32bit value
 u32 ReadU16FromJit(MMU& mmu, u32 address);  // Returns zero-extended 32bit value
 u32 ReadU32FromJit(MMU& mmu, u32 address);
@@ -43,6 +43,9 @@ namespace PPCAnalyst
 {
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Hot conditional branches are counted separately, so that they don't use up the budget for the
+// unconditional ones
+constexpr u32 HOT_BRANCH_FOLLOWING_THRESHOLD = 4;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -737,54 +740,92 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
+static bool CanRunInBusyWaitLoop(const CodeOp& op)
+{
+  const UGeckoInstruction inst = op.inst;
+  switch (op.opinfo->type)
+  {
+  case OpType::Branch:
+  case OpType::CR:
+  case OpType::Load:
+    return true;
+  case OpType::Integer:
+    // The summary overflow bit is sticky, so the next iteration would see it set
+    return !((op.opinfo->flags & FL_SET_OE) && inst.OE);
+  case OpType::System:
+    // mcrf, mfcr, mfmsr, sync and eieio
+    if (inst.OPCD == 19)
+      return inst.SUBOP10 == 0;
+    return inst.OPCD == 31 && (inst.SUBOP10 == 19 || inst.SUBOP10 == 83 ||
+                               inst.SUBOP10 == 598 || inst.SUBOP10 == 854);
+  case OpType::DataCache:
+    // dcbst, dcbf, dcbtst, dcbt and dcbi, but not dcbz, which writes to memory
+    return inst.SUBOP10 == 54 || inst.SUBOP10 == 86 || inst.SUBOP10 == 246 ||
+           inst.SUBOP10 == 278 || inst.SUBOP10 == 470;
+  case OpType::InstructionCache:
+    // isync
+    return inst.OPCD == 19 && inst.SUBOP10 == 150;
+  default:
+    return false;
+  }
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
-  // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  // Detects loops that only poll memory, which can't do anything new until an interrupt, a DMA
+  // or another event changes that memory:
+  //   * It loops to the start of the block. Other branches may only leave the loop, or be the
+  //     calls and returns of followed functions, and must not decrement CTR.
+  //   * It does not write to memory or to any SPR except LR. Loads, lwarx included, and cache
+  //     maintenance do the same thing every time they run with the same address.
+  //   * It only reads the registers, CR fields, carry and LR it wrote to earlier in the loop, or
+  //     it does not write to them.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
+  // Every iteration then computes the same values from the same memory, so the CPU can skip to
+  // the next event instead of running it over and over.
+  BitSet32 write_disallowed_regs(0);
+  BitSet32 written_regs(0);
+  BitSet8 write_disallowed_crs(0);
+  BitSet8 written_crs(0);
+  bool write_disallowed_ca = false;
+  bool written_ca = false;
+  bool write_disallowed_lr = false;
+  bool written_lr = false;
   for (size_t i = 0; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
-    {
-      if (code[i].branchUsesCtr)
-        return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
-    }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    const CodeOp& op = code[i];
+    if (!CanRunInBusyWaitLoop(op))
+      return false;
+
+    write_disallowed_regs |= op.regsIn & ~written_regs;
+    write_disallowed_crs |= op.crIn & ~written_crs;
+    write_disallowed_ca |= op.wantsCA && !written_ca;
+    if ((op.regsOut & write_disallowed_regs) || (op.crOut & write_disallowed_crs) ||
+        (op.outputCA && write_disallowed_ca))
     {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
       return false;
     }
-    else
+    written_regs |= op.regsOut;
+    written_crs |= op.crOut;
+    written_ca |= op.outputCA;
+
+    if (op.opinfo->type == OpType::Branch)
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
+      if (op.branchUsesCtr)
+        return false;
+
+      // bclrx
+      if (op.inst.OPCD == 19 && op.inst.SUBOP10 == 16)
+        write_disallowed_lr |= !written_lr;
+      if (op.inst.LK)
       {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
+        if (write_disallowed_lr)
           return false;
-        written_regs[reg] = true;
+        written_lr = true;
       }
+
+      if (op.branchTo == block->m_address && i == instructions)
+        return true;
     }
   }
   return false;
@@ -800,6 +841,22 @@ static bool CanCauseGatherPipeInterruptCheck(const CodeOp& op)
          op.opinfo->type == OpType::StorePS;
 }
 
+bool PPCAnalyzer::CanFollowTakenBranch(const CodeOp& op, u32 block_address) const
+{
+  if (!m_enable_branch_following || m_is_debugging_enabled || !HasOption(OPTION_HOT_TRACE) ||
+      !HasOption(OPTION_BRANCH_FOLLOW) || !HasOption(OPTION_CONDITIONAL_CONTINUE))
+  {
+    return false;
+  }
+
+  // Only conditional bcx without LK. Branches back to the start of the block are left alone, they
+  // are already handled well by linking the block to itself.
+  const UGeckoInstruction inst = op.inst;
+  return inst.OPCD == 16 && !inst.LK &&
+         ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0) &&
+         op.branchTo != block_address;
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
                          std::size_t block_size) const
 {
@@ -826,6 +883,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numHotFollows = 0;
   u32 num_inst = 0;
 
   const bool enable_follow = m_enable_branch_following;
@@ -942,10 +1000,24 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       }
     }
 
+    if (conditional_continue && numHotFollows < HOT_BRANCH_FOLLOWING_THRESHOLD &&
+        IsHotBranch(code[i].address) && CanFollowTakenBranch(code[i], block->m_address))
+    {
+      code[i].followTaken = true;
+    }
+
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (code[i].followTaken)
+    {
+      // Continue with the path the branch usually takes. As with conditional continue, leaving
+      // through the side exit means we can't guarantee the matching CALL/RET pair.
+      numHotFollows++;
+      found_call = false;
+      address = code[i].branchTo;
+    }
+    else if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -51,6 +52,8 @@ struct CodeOp  // 16B
   bool canCauseException = false;
   bool skipLRStack = false;
   bool skip = false;  // followed BL-s for example
+  // Conditional branch whose target was inlined, the fall-through path leaves the block
+  bool followTaken = false;
   BitSet8 crInUse;
   BitSet8 crDiscardable;
   // which registers are still needed after this instruction in this block
@@ -171,6 +174,11 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Inline the target of conditional branches marked with AddHotBranch, turning the
+    // fall-through path into a side exit. Only used when branch following is enabled.
+    // Requires JIT support to be enabled.
+    OPTION_HOT_TRACE = (1 << 7),
   };
 
   // Option setting/getting
@@ -181,6 +189,14 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+
+  // Conditional branches which the JIT found to be taken most of the time
+  void AddHotBranch(u32 address) { m_hot_branches.insert(address); }
+  bool IsHotBranch(u32 address) const { return m_hot_branches.contains(address); }
+  void ClearHotBranches() { m_hot_branches.clear(); }
+  // Whether the branch at op can be inlined by OPTION_HOT_TRACE, hot or not
+  bool CanFollowTakenBranch(const CodeOp& op, u32 block_address) const;
+
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
@@ -205,6 +221,8 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+
+  std::unordered_set<u32> m_hot_branches;
 };
 
 void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
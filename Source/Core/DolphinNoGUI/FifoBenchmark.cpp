@@ -0,0 +1,199 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/HookableEvent.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "VideoCommon/StageTimings.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace FifoBenchmark
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct StageName
+{
+  StageTimings::Stage stage;
+  std::string_view name;
+};
+
+constexpr std::array<StageName, 5> s_stages = {{
+    {StageTimings::Stage::OpcodeDecoding, "Opcode decoding"},
+    {StageTimings::Stage::VertexLoading, "Vertex loading"},
+    {StageTimings::Stage::TextureDecoding, "Texture decoding"},
+    {StageTimings::Stage::ShaderLookup, "Shader lookup"},
+    {StageTimings::Stage::Drawing, "Drawing"},
+}};
+
+struct Counter
+{
+  int Statistics::ThisFrame::*member;
+  std::string_view name;
+};
+
+constexpr std::array<Counter, 11> s_counters = {{
+    {&Statistics::ThisFrame::num_bp_loads, "BP loads"},
+    {&Statistics::ThisFrame::num_cp_loads, "CP loads"},
+    {&Statistics::ThisFrame::num_xf_loads, "XF loads"},
+    {&Statistics::ThisFrame::num_dlists_called, "Display lists"},
+    {&Statistics::ThisFrame::num_prims, "Primitives"},
+    {&Statistics::ThisFrame::num_draw_calls, "Draw calls"},
+    {&Statistics::ThisFrame::num_shader_changes, "Shader changes"},
+    {&Statistics::ThisFrame::num_triangles_drawn, "Triangles drawn"},
+    {&Statistics::ThisFrame::rasterized_pixels, "Rasterized pixels"},
+    {&Statistics::ThisFrame::tev_pixels_in, "TEV pixels in"},
+    {&Statistics::ThisFrame::tev_pixels_out, "TEV pixels out"},
+}};
+
+u64 s_total_loops = 0;
+
+std::function<void()> s_on_finished;
+Common::EventHook s_after_frame_hook;
+
+// Only touched on the CPU thread, which also runs the GPU in single core mode
+u64 s_loops = 0;
+bool s_measuring = false;
+std::array<u64, s_counters.size()> s_counter_totals{};
+u64 s_frames = 0;
+std::optional<Clock::time_point> s_start_time;
+std::optional<Clock::time_point> s_end_time;
+
+void OnFrameWritten()
+{
+  const FifoPlayer& player = Core::System::GetInstance().GetFifoPlayer();
+  if (s_end_time || player.GetCurrentFrameNum() != player.GetFrameRangeStart())
+    return;
+
+  // A new loop starts
+  if (!s_start_time)
+  {
+    // The first loop fills the shader and texture caches, so start timing at the second one
+    if (s_loops++ == 0)
+      return;
+
+    StageTimings::Reset();
+    StageTimings::SetEnabled(true);
+    s_measuring = true;
+    s_loops = 0;
+    s_frames = 0;
+    s_start_time = Clock::now();
+    return;
+  }
+
+  if (++s_loops < s_total_loops)
+    return;
+
+  StageTimings::SetEnabled(false);
+  s_measuring = false;
+  s_end_time = Clock::now();
+  s_on_finished();
+}
+
+void OnAfterFrame()
+{
+  if (!s_measuring)
+    return;
+
+  ++s_frames;
+  for (size_t i = 0; i < s_counters.size(); ++i)
+    s_counter_totals[i] += static_cast<u64>(g_stats.this_frame.*s_counters[i].member);
+}
+
+double ToSeconds(std::chrono::nanoseconds time)
+{
+  return std::chrono::duration<double>(time).count();
+}
+
+void PrintTime(std::string_view name, std::chrono::nanoseconds time, double elapsed)
+{
+  const double seconds = ToSeconds(time);
+  fmt::print("  {:<20} {:8.3f} s {:6.2f}%", name, seconds,
+             elapsed > 0 ? seconds * 100 / elapsed : 0.0);
+}
+}  // namespace
+
+bool Prepare(u64 loops)
+{
+  s_total_loops = loops;
+
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  // Keep the GPU on the CPU thread, so the stages are timed on one thread and add up to the
+  // elapsed time
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  return true;
+}
+
+void Start(std::function<void()> on_finished)
+{
+  s_on_finished = std::move(on_finished);
+
+  Core::System::GetInstance().GetFifoPlayer().SetFrameWrittenCallback(
+      [] { OnFrameWritten(); });
+  s_after_frame_hook =
+      AfterFrameEvent::Register([](Core::System&) { OnAfterFrame(); }, "FifoBenchmark");
+}
+
+void Finish()
+{
+  Core::System::GetInstance().GetFifoPlayer().SetFrameWrittenCallback({});
+  s_after_frame_hook.reset();
+  StageTimings::SetEnabled(false);
+  s_measuring = false;
+
+  if (!s_start_time)
+  {
+    fmt::print(stderr, "The benchmark stopped before the end of the warm-up loop\n");
+    return;
+  }
+
+  if (!s_end_time)
+  {
+    fmt::print(stderr, "The benchmark stopped after {} of {} loops\n", s_loops, s_total_loops);
+    s_end_time = Clock::now();
+  }
+
+  const std::chrono::nanoseconds elapsed_time = *s_end_time - *s_start_time;
+  const double elapsed = ToSeconds(elapsed_time);
+
+  fmt::print("FIFO benchmark: {} loops, {} frames in {:.3f} s\n", s_loops, s_frames, elapsed);
+  fmt::print("  FPS: {:.2f}\n", elapsed > 0 ? s_frames / elapsed : 0.0);
+
+  // Everything else: the FIFO player itself, the rest of the frontend and presenting
+  std::chrono::nanoseconds other_time = elapsed_time;
+  for (const StageName& stage : s_stages)
+  {
+    const StageTimings::Totals totals = StageTimings::GetTotals(stage.stage);
+    PrintTime(stage.name, totals.time, elapsed);
+    fmt::print(" {:>10} calls\n", totals.calls);
+    other_time -= totals.time;
+  }
+  PrintTime("Other", other_time, elapsed);
+  fmt::print("\n");
+
+  fmt::print("  Per frame:\n");
+  for (size_t i = 0; i < s_counters.size(); ++i)
+  {
+    const double per_frame =
+        s_frames > 0 ? static_cast<double>(s_counter_totals[i]) / s_frames : 0.0;
+    fmt::print("  {:<20} {:12.1f}\n", s_counters[i].name, per_frame);
+  }
+  std::fflush(stdout);
+}
+}  // namespace FifoBenchmark
@@ -0,0 +1,25 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+
+#include "Common/CommonTypes.h"
+
+// Replays a FIFO log uncapped for a fixed number of loops and reports the speed, the time spent in
+// each stage of the video frontend and the work done, as counted by the statistics. The first loop
+// is a warm-up and isn't measured. Meant to be used with the Null or Software video backends, so
+// it runs without a GPU.
+namespace FifoBenchmark
+{
+// Sets up looping playback, single core and an unlimited emulation speed for this run. Must be
+// called before booting.
+bool Prepare(u64 loops);
+
+// Starts counting loops. on_finished is called on the CPU thread after the last loop.
+void Start(std::function<void()> on_finished);
+
+// Prints the results
+void Finish();
+}  // namespace FifoBenchmark
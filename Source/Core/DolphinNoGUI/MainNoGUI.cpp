@@ -1,9 +1,13 @@
 // Copyright 2008 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "DolphinNoGUI/FifoBenchmark.h"
 #include "DolphinNoGUI/Platform.h"
+#include "DolphinNoGUI/TriforceBenchmark.h"
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -11,6 +15,8 @@
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 #ifndef _WIN32
 #include <unistd.h>
 #else
@@ -22,6 +28,7 @@
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
 #include "Core/Core.h"
+#include "Core/Debugger/SamplingProfiler.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
 #include "Core/System.h"
@@ -185,6 +192,23 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static void PrintTopFunctions(const SamplingProfiler::Summary& summary)
+{
+  fmt::print("Sampling profiler: {} samples, {} dropped\n", summary.total_samples,
+             summary.dropped_samples);
+  fmt::print("  {:>8} {:>7} {:>8} {:>8}  {}\n", "samples", "%", "jit", "host", "function");
+  for (const SamplingProfiler::FunctionSamples& function : summary.functions)
+  {
+    const u64 total = function.jit + function.host;
+    const double percent = summary.total_samples == 0 ?
+                               0.0 :
+                               total * 100.0 / static_cast<double>(summary.total_samples);
+    fmt::print("  {:>8} {:>6.2f}% {:>8} {:>8}  {}\n", total, percent, function.jit, function.host,
+               function.name);
+  }
+  std::fflush(stdout);
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -216,6 +240,37 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--triforce_benchmark")
+      .action("store")
+      .type("long")
+      .metavar("<fields>")
+      .help("Run a Triforce game uncapped for the given number of fields and report timings");
+  parser->add_option("--benchmark_input")
+      .action("store")
+      .metavar("<file>")
+      .help("Input script to play back during --triforce_benchmark");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .type("long")
+      .metavar("<loops>")
+      .help("Replay a FIFO log uncapped for the given number of loops, after a warm-up loop, and "
+            "report timings. Meant for the Null and Software video backends");
+  parser->add_option("--profile")
+      .action("store")
+      .metavar("<file>")
+      .help("Sample the emulated CPU and write the time spent per guest function as folded stacks");
+  parser->add_option("--profile_top")
+      .action("store")
+      .type("long")
+      .set_default(20)
+      .metavar("<count>")
+      .help("Number of guest functions to list after a --profile run [default: %default]");
+  parser->add_option("--profile_interval")
+      .action("store")
+      .type("long")
+      .set_default(1000)
+      .metavar("<microseconds>")
+      .help("Time between two --profile samples [default: %default]");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -290,6 +345,59 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  const bool benchmark = options.is_set("triforce_benchmark");
+  if (benchmark)
+  {
+    const long fields = static_cast<long>(options.get("triforce_benchmark"));
+    std::string script_path;
+    if (options.is_set("benchmark_input"))
+      script_path = static_cast<const char*>(options.get("benchmark_input"));
+    if (fields <= 0 || !game_specified)
+    {
+      fprintf(stderr, "The Triforce benchmark needs a game and a positive number of fields.\n");
+      return 1;
+    }
+    if (!TriforceBenchmark::Prepare(static_cast<u64>(fields), script_path))
+      return 1;
+
+    TriforceBenchmark::Start([] { s_platform->Stop(); });
+  }
+  Common::ScopeGuard benchmark_guard([benchmark] {
+    if (benchmark)
+      TriforceBenchmark::Finish();
+  });
+
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark)
+  {
+    const long loops = static_cast<long>(options.get("fifo_benchmark"));
+    if (loops <= 0 || !game_specified)
+    {
+      fprintf(stderr, "The FIFO benchmark needs a FIFO log and a positive number of loops.\n");
+      return 1;
+    }
+    if (!FifoBenchmark::Prepare(static_cast<u64>(loops)))
+      return 1;
+
+    FifoBenchmark::Start([] { s_platform->Stop(); });
+  }
+  Common::ScopeGuard fifo_benchmark_guard([fifo_benchmark] {
+    if (fifo_benchmark)
+      FifoBenchmark::Finish();
+  });
+
+  const bool profile = options.is_set("profile");
+  if (profile)
+  {
+    const long interval = static_cast<long>(options.get("profile_interval"));
+    if (!SamplingProfiler::IsSupported() || interval <= 0)
+    {
+      fprintf(stderr, "Profiling needs a positive interval and is not supported on all hosts.\n");
+      return 1;
+    }
+    SamplingProfiler::Start(Core::System::GetInstance(), std::chrono::microseconds(interval));
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -321,6 +429,16 @@ int main(int argc, char* argv[])
 #endif
 
   s_platform->MainLoop();
+
+  if (profile)
+  {
+    // Sampling has normally ended with the emulation already, this only covers the other cases
+    SamplingProfiler::Stop(Core::System::GetInstance());
+    SamplingProfiler::WriteFoldedStacks(static_cast<const char*>(options.get("profile")));
+    PrintTopFunctions(SamplingProfiler::GetTopFunctions(static_cast<size_t>(
+        std::max(static_cast<long>(options.get("profile_top")), 0L))));
+  }
+
   Core::Stop(Core::System::GetInstance());
 
   Core::Shutdown(Core::System::GetInstance());
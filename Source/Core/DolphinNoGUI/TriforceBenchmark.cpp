@@ -0,0 +1,338 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/TriforceBenchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/HookableEvent.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/DVD/AMTimings.h"
+#include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/GCPad.h"
+#include "Core/HW/GCPadEmu.h"
+#include "Core/HW/SI/SI_Device.h"
+#include "InputCommon/ControllerEmu/ControllerEmu.h"
+#include "InputCommon/ControllerEmu/StickGate.h"
+#include "InputCommon/InputConfig.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace TriforceBenchmark
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int NUM_PADS = 4;
+
+struct ScriptInput
+{
+  std::string_view name;
+  std::string_view group;
+  std::string_view control;
+};
+
+constexpr std::array<ScriptInput, 19> s_script_inputs = {{
+    {"a", GCPad::BUTTONS_GROUP, GCPad::A_BUTTON},
+    {"b", GCPad::BUTTONS_GROUP, GCPad::B_BUTTON},
+    {"x", GCPad::BUTTONS_GROUP, GCPad::X_BUTTON},
+    {"y", GCPad::BUTTONS_GROUP, GCPad::Y_BUTTON},
+    {"z", GCPad::BUTTONS_GROUP, GCPad::Z_BUTTON},
+    // The baseboard reads Z as the coin switch
+    {"coin", GCPad::BUTTONS_GROUP, GCPad::Z_BUTTON},
+    {"start", GCPad::BUTTONS_GROUP, GCPad::START_BUTTON},
+    {"up", GCPad::DPAD_GROUP, DIRECTION_UP},
+    {"down", GCPad::DPAD_GROUP, DIRECTION_DOWN},
+    {"left", GCPad::DPAD_GROUP, DIRECTION_LEFT},
+    {"right", GCPad::DPAD_GROUP, DIRECTION_RIGHT},
+    {"l", GCPad::TRIGGERS_GROUP, GCPad::L_DIGITAL},
+    {"r", GCPad::TRIGGERS_GROUP, GCPad::R_DIGITAL},
+    {"l-analog", GCPad::TRIGGERS_GROUP, GCPad::L_ANALOG},
+    {"r-analog", GCPad::TRIGGERS_GROUP, GCPad::R_ANALOG},
+    {"stick-x", GCPad::MAIN_STICK_GROUP, ControllerEmu::ReshapableInput::X_INPUT_OVERRIDE},
+    {"stick-y", GCPad::MAIN_STICK_GROUP, ControllerEmu::ReshapableInput::Y_INPUT_OVERRIDE},
+    {"c-stick-x", GCPad::C_STICK_GROUP, ControllerEmu::ReshapableInput::X_INPUT_OVERRIDE},
+    {"c-stick-y", GCPad::C_STICK_GROUP, ControllerEmu::ReshapableInput::Y_INPUT_OVERRIDE},
+}};
+
+struct ScriptEvent
+{
+  u64 field;
+  int pad;
+  size_t input;
+  ControlState value;
+};
+
+using PadOverrides = std::array<std::optional<ControlState>, s_script_inputs.size()>;
+
+u64 s_total_fields = 0;
+std::vector<ScriptEvent> s_script;
+
+// Written on the CPU thread at the end of each field, read whenever the pads are polled
+std::mutex s_overrides_lock;
+std::array<PadOverrides, NUM_PADS> s_overrides;
+size_t s_next_event = 0;
+
+std::function<void()> s_on_finished;
+Common::EventHook s_end_field_hook;
+Common::EventHook s_after_frame_hook;
+
+u64 s_fields = 0;
+std::atomic<u64> s_frames{0};
+u64 s_frames_at_end = 0;
+std::optional<Clock::time_point> s_start_time;
+std::optional<Clock::time_point> s_end_time;
+std::optional<std::chrono::nanoseconds> s_start_cpu_time;
+std::optional<std::chrono::nanoseconds> s_end_cpu_time;
+
+// CPU time used by the calling thread so far
+std::optional<std::chrono::nanoseconds> GetThreadCPUTime()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel, &user))
+    return std::nullopt;
+  const auto to_100ns = [](const FILETIME& time) {
+    return (u64(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  return std::chrono::nanoseconds((to_100ns(kernel) + to_100ns(user)) * 100);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return std::nullopt;
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+std::optional<size_t> FindScriptInput(std::string_view name)
+{
+  const auto it = std::find_if(s_script_inputs.begin(), s_script_inputs.end(),
+                               [name](const ScriptInput& input) { return input.name == name; });
+  if (it == s_script_inputs.end())
+    return std::nullopt;
+  return static_cast<size_t>(it - s_script_inputs.begin());
+}
+
+bool LoadScript(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+  {
+    fmt::print(stderr, "Could not read the benchmark input script {}\n", path);
+    return false;
+  }
+
+  const std::vector<std::string> lines = SplitString(contents, '\n');
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    const std::string_view line = StripWhitespace(lines[i]);
+    if (line.empty() || line.front() == '#')
+      continue;
+
+    std::istringstream stream{std::string(line)};
+    u64 field;
+    int pad;
+    std::string name;
+    ControlState value;
+    if (!(stream >> field >> pad >> name >> value) || pad < 1 || pad > NUM_PADS)
+    {
+      fmt::print(stderr, "{}:{}: Expected \"<field> <pad> <input> <value>\"\n", path, i + 1);
+      return false;
+    }
+
+    const std::optional<size_t> input = FindScriptInput(name);
+    if (!input)
+    {
+      fmt::print(stderr, "{}:{}: Unknown input \"{}\"\n", path, i + 1, name);
+      return false;
+    }
+
+    s_script.push_back({field, pad - 1, *input, value});
+  }
+
+  std::stable_sort(s_script.begin(), s_script.end(),
+                   [](const ScriptEvent& a, const ScriptEvent& b) { return a.field < b.field; });
+  return true;
+}
+
+void ApplyScript(u64 field)
+{
+  std::lock_guard lk(s_overrides_lock);
+  for (; s_next_event < s_script.size() && s_script[s_next_event].field <= field; ++s_next_event)
+  {
+    const ScriptEvent& event = s_script[s_next_event];
+    s_overrides[event.pad][event.input] = event.value;
+  }
+}
+
+ControllerEmu::InputOverrideFunction GetInputOverrideFunction(int pad)
+{
+  return [pad](std::string_view group_name, std::string_view control_name,
+               ControlState) -> std::optional<ControlState> {
+    for (size_t i = 0; i < s_script_inputs.size(); ++i)
+    {
+      const ScriptInput& input = s_script_inputs[i];
+      if (input.group != group_name || input.control != control_name)
+        continue;
+
+      std::lock_guard lk(s_overrides_lock);
+      if (s_overrides[pad][i])
+        return s_overrides[pad][i];
+    }
+    return std::nullopt;
+  };
+}
+
+void OnEndField()
+{
+  if (s_end_time)
+    return;
+
+  if (!s_start_time)
+  {
+    // Start timing at the first field so that booting isn't counted
+    AMTimings::Reset();
+    AMTimings::SetEnabled(true);
+    s_frames.store(0, std::memory_order_relaxed);
+    s_start_time = Clock::now();
+    // Fields end on the CPU thread, which also runs the Triforce hardware
+    s_start_cpu_time = GetThreadCPUTime();
+  }
+
+  ApplyScript(s_fields);
+
+  if (++s_fields < s_total_fields)
+    return;
+
+  AMTimings::SetEnabled(false);
+  s_end_time = Clock::now();
+  s_end_cpu_time = GetThreadCPUTime();
+  s_frames_at_end = s_frames.load(std::memory_order_relaxed);
+  s_on_finished();
+}
+
+double ToSeconds(std::chrono::nanoseconds time)
+{
+  return std::chrono::duration<double>(time).count();
+}
+
+void PrintTime(std::string_view name, std::chrono::nanoseconds time, double elapsed)
+{
+  const double seconds = ToSeconds(time);
+  fmt::print("  {:<20} {:8.3f} s {:6.2f}%", name, seconds,
+             elapsed > 0 ? seconds * 100 / elapsed : 0.0);
+}
+
+void PrintSubsystem(std::string_view name, const AMTimings::Totals& totals, double elapsed)
+{
+  PrintTime(name, totals.time, elapsed);
+  fmt::print(" {:>10} calls\n", totals.calls);
+}
+}  // namespace
+
+bool Prepare(u64 fields, const std::string& script_path)
+{
+  s_total_fields = fields;
+  if (!script_path.empty() && !LoadScript(script_path))
+    return false;
+
+  Config::SetCurrent(Config::MAIN_SERIAL_PORT_1, ExpansionInterface::EXIDeviceType::AMMediaboard);
+  Config::SetCurrent(Config::GetInfoForSIDevice(0), SerialInterface::SIDEVICE_AM_BASEBOARD);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  return true;
+}
+
+void Start(std::function<void()> on_finished)
+{
+  s_on_finished = std::move(on_finished);
+
+  for (int i = 0; i < NUM_PADS; ++i)
+    Pad::GetConfig()->GetController(i)->SetInputOverrideFunction(GetInputOverrideFunction(i));
+
+  s_end_field_hook = VIEndFieldEvent::Register([] { OnEndField(); }, "TriforceBenchmark");
+  s_after_frame_hook = AfterFrameEvent::Register(
+      [](Core::System&) { s_frames.fetch_add(1, std::memory_order_relaxed); },
+      "TriforceBenchmark");
+}
+
+void Finish()
+{
+  s_end_field_hook.reset();
+  s_after_frame_hook.reset();
+  AMTimings::SetEnabled(false);
+
+  for (int i = 0; i < NUM_PADS; ++i)
+    Pad::GetConfig()->GetController(i)->ClearInputOverrideFunction();
+
+  if (!s_start_time)
+  {
+    fmt::print(stderr, "The benchmark stopped before the first field\n");
+    return;
+  }
+
+  if (!s_end_time)
+  {
+    fmt::print(stderr, "The benchmark stopped after {} of {} fields\n", s_fields, s_total_fields);
+    s_end_time = Clock::now();
+    s_frames_at_end = s_frames.load(std::memory_order_relaxed);
+  }
+
+  const double elapsed = ToSeconds(*s_end_time - *s_start_time);
+  const AMTimings::Totals baseboard = AMTimings::GetTotals(AMTimings::Subsystem::Baseboard);
+  const AMTimings::Totals mediaboard = AMTimings::GetTotals(AMTimings::Subsystem::Mediaboard);
+
+  fmt::print("Triforce benchmark: {} fields, {} frames in {:.3f} s\n", s_fields, s_frames_at_end,
+             elapsed);
+  fmt::print("  VPS: {:.2f}\n", elapsed > 0 ? s_fields / elapsed : 0.0);
+  fmt::print("  FPS: {:.2f}\n", elapsed > 0 ? s_frames_at_end / elapsed : 0.0);
+  PrintSubsystem("SI (AM baseboard)", baseboard, elapsed);
+  PrintSubsystem("DVD (media board)", mediaboard, elapsed);
+
+  // The CPU thread time is only known when the run ended on the CPU thread
+  if (!s_start_cpu_time || !s_end_cpu_time)
+  {
+    fmt::print("  CPU thread time is unavailable\n");
+    std::fflush(stdout);
+    return;
+  }
+
+  // The Triforce hardware runs on the CPU thread, so the rest of its time went to the PowerPC core
+  // and the other devices. For the rest of the wall time the CPU thread was waiting, on the GPU
+  // thread or for the host to schedule it.
+  const std::chrono::nanoseconds cpu_thread_time = *s_end_cpu_time - *s_start_cpu_time;
+  const std::chrono::nanoseconds wall_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(*s_end_time - *s_start_time);
+  const std::chrono::nanoseconds other_time =
+      std::max(cpu_thread_time - baseboard.time - mediaboard.time, std::chrono::nanoseconds{});
+  const std::chrono::nanoseconds waiting_time =
+      std::max(wall_time - cpu_thread_time, std::chrono::nanoseconds{});
+  PrintTime("PowerPC and others", other_time, elapsed);
+  fmt::print("\n");
+  PrintTime("CPU thread waiting", waiting_time, elapsed);
+  fmt::print("\n");
+  PrintTime("CPU thread total", cpu_thread_time, elapsed);
+  fmt::print("\n");
+  std::fflush(stdout);
+}
+}  // namespace TriforceBenchmark
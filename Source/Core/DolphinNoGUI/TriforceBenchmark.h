@@ -0,0 +1,29 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Runs a Triforce game uncapped for a fixed number of fields, feeding it a scripted input
+// timeline, and reports the speed and the time spent in the baseboard and the media board.
+//
+// The script has one input change per line, in the form "<field> <pad> <input> <value>", where
+// pad is 1-4, and value is 0/1 for buttons, 0 to 1 for triggers and -1 to 1 for sticks. The
+// inputs are a, b, x, y, z, coin (same as z), start, up, down, left, right, l, r, l-analog,
+// r-analog, stick-x, stick-y, c-stick-x and c-stick-y. Lines starting with # are ignored.
+namespace TriforceBenchmark
+{
+// Loads the script, if any, and sets up the media board, the baseboard and an unlimited emulation
+// speed for this run. Must be called before booting.
+bool Prepare(u64 fields, const std::string& script_path);
+
+// Installs the input overrides. on_finished is called on the CPU thread after the last field.
+void Start(std::function<void()> on_finished);
+
+// Removes the input overrides and prints the results
+void Finish();
+}  // namespace TriforceBenchmark
@@ -0,0 +1,168 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/AMTraceCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Core/HW/DVD/AMCommandTrace.h"
+#include "Core/HW/DVD/AMMediaboard.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+int AMTraceCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: amtrace [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, the media board firmware is loaded from its system folder. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the media board command trace FILE, as recorded with TriforceCommandTrace.")
+      .metavar("FILE");
+
+  parser.add_option("-g", "--game")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the disc image the trace was recorded with. Without it, reads "
+            "from the game's DIMM image return zeroes.")
+      .metavar("FILE");
+
+  parser.add_option("-q", "--quiet")
+      .action("store_true")
+      .help("Optional. Only print the summary, not every mismatch.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  AMMediaboard::CommandTraceReader reader;
+  if (!reader.Open(input_file_path))
+  {
+    fmt::print(std::cerr, "Error: {} is not a media board command trace\n", input_file_path);
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<DiscIO::VolumeDisc> disc;
+  if (options.is_set("game"))
+  {
+    disc = DiscIO::CreateDisc(options["game"]);
+    if (!disc)
+    {
+      fmt::print(std::cerr, "Error: Unable to open disc image\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const bool quiet = options.is_set_by_user("quiet");
+
+  AMMediaboard::InitReplay(reader.GetGameType());
+  if (disc)
+    AMMediaboard::InitDIMM(*disc);
+
+  u64 commands = 0;
+  u64 network_replies = 0;
+  u64 mismatches = 0;
+  std::chrono::nanoseconds time{0};
+
+  AMMediaboard::TraceRecord record;
+  std::vector<u8> payload;
+  std::vector<u8> buffer;
+  u64 index = 0;
+  for (; reader.Read(&record, &payload); ++index)
+  {
+    switch (record.kind)
+    {
+    case AMMediaboard::TraceRecordKind::Command:
+    {
+      // Writes come with their data, everything else starts from a clean buffer so that the
+      // hash of a read only depends on what the media board returned
+      buffer.assign(record.length, 0);
+      std::copy_n(payload.begin(), std::min(payload.size(), buffer.size()), buffer.begin());
+
+      const auto start = std::chrono::steady_clock::now();
+      const u32 result = AMMediaboard::ReplayCommand(record, buffer.data());
+      time += std::chrono::steady_clock::now() - start;
+      ++commands;
+
+      const bool result_matches = result == record.result;
+      // Only reads are hashed
+      const bool data_matches =
+          record.hash == 0 ||
+          AMMediaboard::HashTracePayload(buffer.data(), record.length) == record.hash;
+      if (result_matches && data_matches)
+        break;
+
+      ++mismatches;
+      if (quiet)
+        break;
+
+      fmt::print(std::cout, "Record {}: command {:02x} offset {:08x} length {:x}:", index,
+                 record.command, record.offset, record.length);
+      if (!result_matches)
+        fmt::print(std::cout, " result {:08x}, expected {:08x}", result, record.result);
+      if (!data_matches)
+        fmt::print(std::cout, " data differs");
+      fmt::print(std::cout, "\n");
+      break;
+    }
+    case AMMediaboard::TraceRecordKind::NetworkReply:
+      if (!AMMediaboard::ReplayNetworkReply(payload))
+      {
+        fmt::print(std::cerr, "Error: Record {} holds an invalid network reply\n", index);
+        AMMediaboard::ShutdownReplay();
+        return EXIT_FAILURE;
+      }
+      ++network_replies;
+      break;
+    case AMMediaboard::TraceRecordKind::FirmwareMap:
+      AMMediaboard::FirmwareMap((record.flags & AMMediaboard::TRACE_FIRMWARE_MAPPED) != 0);
+      break;
+    default:
+      fmt::print(std::cerr, "Error: Record {} has an unknown kind\n", index);
+      AMMediaboard::ShutdownReplay();
+      return EXIT_FAILURE;
+    }
+  }
+
+  AMMediaboard::ShutdownReplay();
+
+  const double seconds = std::chrono::duration<double>(time).count();
+  fmt::print(std::cout, "Replayed {} commands and {} network replies in {:.3f} s\n", commands,
+             network_replies, seconds);
+  if (seconds > 0)
+    fmt::print(std::cout, "Commands per second: {:.0f}\n", commands / seconds);
+  fmt::print(std::cout, "Mismatches: {}\n", mismatches);
+
+  return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -14,6 +14,7 @@
 #include "Common/StringUtil.h"
 #include "Core/Core.h"
 
+#include "DolphinTool/AMTraceCommand.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/ExtractCommand.h"
 #include "DolphinTool/HeaderCommand.h"
@@ -23,7 +24,7 @@ static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header, extract]\n");
+                        "commands supported: [convert, verify, header, extract, amtrace]\n");
 }
 
 #ifdef _WIN32
@@ -52,6 +53,8 @@ int main(int argc, char* argv[])
     return DolphinTool::HeaderCommand(args);
   else if (command_str == "extract")
     return DolphinTool::Extract(args);
+  else if (command_str == "amtrace")
+    return DolphinTool::AMTraceCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
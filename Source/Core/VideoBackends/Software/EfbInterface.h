@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/PerfQueryBase.h"
@@ -56,7 +58,15 @@ u8* GetPixelPointer(u16 x, u16 y, bool depth);
 void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>& source_rect,
                float y_scale, float gamma);
 
+// Pixels counted by a single rasterizer thread, which are added to the perf query results with
+// AddPerfCounters once the thread is done drawing.
+struct PerfCounters
+{
+  std::array<u32, PQ_NUM_MEMBERS> pixels{};
+};
+
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+void IncPerfCounterQuadCount(PerfCounters& counters, PerfQueryType type);
+void AddPerfCounters(PerfCounters& counters);
 }  // namespace EfbInterface
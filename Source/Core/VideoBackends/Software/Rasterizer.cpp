@@ -4,15 +4,26 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TevCombiner.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/PerfQueryBase.h"
@@ -96,21 +107,115 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Triangles are binned into square tiles of this size, which the threads draw in parallel. Must be
+// a multiple of BLOCK_SIZE, so that no block is split between threads.
+static constexpr s32 TILE_SIZE = 64;
+static constexpr u32 TILES_WIDE = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr u32 TILES_HIGH = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+// Batches with fewer triangles are drawn by the GPU thread alone, as waking up the workers would
+// take longer than drawing them.
+static constexpr size_t MIN_PARALLEL_TRIANGLES = 8;
+
+// Everything needed to draw a triangle within one scissor rectangle
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor
+  s32 minx, maxx, miny, maxy;
+};
+
+// The state each thread needs to draw its tiles
+struct ThreadContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  ThreadCounters counters;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+struct Worker
+{
+  std::thread thread;
+  Common::Event start;
+};
+
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+static std::vector<TriangleSetup> triangles;
+static std::array<std::vector<u32>, TILES_WIDE * TILES_HIGH> tileBins;
+// Tiles with at least one triangle binned into them, in the order they were first used
+static std::vector<u32> usedTiles;
+static std::atomic<u32> nextTile;
+
+// The GPU thread uses the first context, each worker the one after its index
+static std::vector<std::unique_ptr<ThreadContext>> contexts;
+static std::vector<std::unique_ptr<Worker>> workers;
+static std::atomic<u32> runningWorkers;
+static Common::Event workersDone;
+static Common::Flag quitWorkers;
+
+static void DrawTiles(ThreadContext& context);
+
+static void WorkerThread(Worker& worker, ThreadContext& context)
+{
+  Common::SetCurrentThreadName("Software Rasterizer");
+
+  while (true)
+  {
+    worker.start.Wait();
+    if (quitWorkers.IsSet())
+      return;
+
+    DrawTiles(context);
+
+    if (runningWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      workersDone.Set();
+  }
+}
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  // Leave a core for the CPU thread. The GPU thread draws tiles along with the workers.
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  const u32 num_workers = std::min(num_threads - 1, TILES_WIDE * TILES_HIGH - 1);
+
+  contexts.clear();
+  contexts.push_back(std::make_unique<ThreadContext>());
+
+  quitWorkers.Clear();
+  for (u32 i = 0; i < num_workers; i++)
+  {
+    auto& context = contexts.emplace_back(std::make_unique<ThreadContext>());
+    auto& worker = workers.emplace_back(std::make_unique<Worker>());
+    worker->thread = std::thread(WorkerThread, std::ref(*worker), std::ref(*context));
+  }
+}
+
+void Shutdown()
+{
+  quitWorkers.Set();
+  for (auto& worker : workers)
+  {
+    worker->start.Set();
+    worker->thread.join();
+  }
+  workers.clear();
+  contexts.clear();
 }
 
 void ScissorChanged()
@@ -142,56 +247,80 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  for (auto& context : contexts)
+    context->tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+// Draws the pixels of the 2x2 block at x, y that are set in mask, with pixel (ix, iy) at bit
+// iy * 2 + ix
+static void DrawQuad(ThreadContext& context, const TriangleSetup& setup, s32 x, s32 y, u32 mask)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  ThreadCounters& counters = context.counters;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
-
-  if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
+  for (u32 i = 0; i < TevCombiner::QUAD_SIZE; i++)
   {
-    // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
-    if (bpmem.zmode.testenable)
+    if (!(mask & (1u << i)))
+      continue;
+
+    const s32 xi = i & 1;
+    const s32 yi = i >> 1;
+    const s32 px = x + xi;
+    const s32 py = y + yi;
+
+    counters.rasterized_pixels++;
+
+    s32 z = (s32)std::clamp<float>(setup.ZSlope.GetValue(px, py), 0.0f, 16777215.0f);
+
+    if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
     {
-      // early z
-      if (!EfbInterface::ZCompare(x, y, z))
-        return;
+      // TODO: Test if perf regs are incremented even if test is disabled
+      EfbInterface::IncPerfCounterQuadCount(counters.perf, PQ_ZCOMP_INPUT_ZCOMPLOC);
+      if (bpmem.zmode.testenable)
+      {
+        // early z
+        if (!EfbInterface::ZCompare(px, py, z))
+        {
+          mask &= ~(1u << i);
+          continue;
+        }
+      }
+      EfbInterface::IncPerfCounterQuadCount(counters.perf, PQ_ZCOMP_OUTPUT_ZCOMPLOC);
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
-  }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+    const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-  tev.Position[0] = x;
-  tev.Position[1] = y;
-  tev.Position[2] = z;
+    tev.Position[i][0] = px;
+    tev.Position[i][1] = py;
+    tev.Position[i][2] = z;
 
-  //  colors
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
+    //  colors
+    for (unsigned int j = 0; j < bpmem.genMode.numcolchans; j++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      for (int comp = 0; comp < 4; comp++)
+      {
+        u16 color = (u16)setup.ColorSlopes[j][comp].GetValue(px, py);
 
-      // clamp color value to 0
-      u16 mask = ~(color >> 8);
+        // clamp color value to 0
+        u16 color_mask = ~(color >> 8);
 
-      tev.Color[i][comp] = color & mask;
+        tev.Color[i][j][comp] = color & color_mask;
+      }
     }
-  }
 
-  // tex coords
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    // multiply by 128 because TEV stores UVs as s17.7
-    tev.Uv[i].s = (s32)(pixel.Uv[i][0] * 128);
-    tev.Uv[i].t = (s32)(pixel.Uv[i][1] * 128);
+    // tex coords
+    for (unsigned int j = 0; j < bpmem.genMode.numtexgens; j++)
+    {
+      // multiply by 128 because TEV stores UVs as s17.7
+      tev.Uv[i][j].s = (s32)(pixel.Uv[j][0] * 128);
+      tev.Uv[i][j].t = (s32)(pixel.Uv[j][1] * 128);
+    }
   }
 
+  if (mask == 0)
+    return;
+
   for (unsigned int i = 0; i < bpmem.genMode.numindstages; i++)
   {
     tev.IndirectLod[i] = rasterBlock.IndirectLod[i];
@@ -204,10 +333,11 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
-  tev.Draw();
+  tev.Draw(mask, counters);
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +348,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +388,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& setup, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +400,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / setup.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = setup.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = setup.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = setup.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +422,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +435,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,9 +453,8 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+static void BinTriangle(const OutputVertexData* v0, const OutputVertexData* v1,
+                        const OutputVertexData* v2, const BPFunctions::ScissorRect& scissor)
 {
   // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
   // zfreeze depends on it
@@ -340,24 +472,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
   const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
 
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
-
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
-
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -378,41 +492,105 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (minx >= maxx || miny >= maxy)
     return;
 
+  TriangleSetup& setup = triangles.emplace_back();
+  setup.minx = minx;
+  setup.maxx = maxx;
+  setup.miny = miny;
+  setup.maxy = maxy;
+
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
+  setup.ZSlope = ZSlope;
+
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  setup.WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      setup.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      setup.TexSlopes[i][comp] =
+          Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
+  // Deltas
+  setup.DX12 = X1 - X2;
+  setup.DX23 = X2 - X3;
+  setup.DX31 = X3 - X1;
+
+  setup.DY12 = Y1 - Y2;
+  setup.DY23 = Y2 - Y3;
+  setup.DY31 = Y3 - Y1;
+
   // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
+  setup.C1 = setup.DY12 * X1 - setup.DX12 * Y1;
+  setup.C2 = setup.DY23 * X2 - setup.DX23 * Y2;
+  setup.C3 = setup.DY31 * X3 - setup.DX31 * Y3;
 
   // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
+  if (setup.DY12 < 0 || (setup.DY12 == 0 && setup.DX12 > 0))
+    setup.C1++;
+  if (setup.DY23 < 0 || (setup.DY23 == 0 && setup.DX23 > 0))
+    setup.C2++;
+  if (setup.DY31 < 0 || (setup.DY31 == 0 && setup.DX31 > 0))
+    setup.C3++;
+
+  const u32 index = static_cast<u32>(triangles.size() - 1);
+  for (s32 tile_y = miny / TILE_SIZE; tile_y <= (maxy - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = minx / TILE_SIZE; tile_x <= (maxx - 1) / TILE_SIZE; tile_x++)
+    {
+      const u32 tile = tile_y * TILES_WIDE + tile_x;
+      if (tileBins[tile].empty())
+        usedTiles.push_back(tile);
+      tileBins[tile].push_back(index);
+    }
+  }
+}
+
+static void DrawTriangle(ThreadContext& context, const TriangleSetup& setup, s32 tile_x,
+                         s32 tile_y)
+{
+  const s32 C1 = setup.C1;
+  const s32 C2 = setup.C2;
+  const s32 C3 = setup.C3;
+
+  const s32 DX12 = setup.DX12;
+  const s32 DX23 = setup.DX23;
+  const s32 DX31 = setup.DX31;
+
+  const s32 DY12 = setup.DY12;
+  const s32 DY23 = setup.DY23;
+  const s32 DY31 = setup.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  // Only draw the part of the triangle within the tile
+  const s32 minx = std::max(setup.minx, tile_x);
+  const s32 maxx = std::min(setup.maxx, tile_x + TILE_SIZE);
+  const s32 miny = std::max(setup.miny, tile_y);
+  const s32 maxy = std::min(setup.maxy, tile_y + TILE_SIZE);
 
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
@@ -455,19 +633,13 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, setup, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
       if (a == 0xF && b == 0xF && c == 0xF && x >= minx && x1_ < maxx && y >= miny && y1_ < maxy)
       {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            Draw(x + ix, y + iy, ix, iy);
-          }
-        }
+        DrawQuad(context, setup, x, y, 0xF);
       }
       else  // Partially covered block
       {
@@ -475,6 +647,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
         s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
 
+        u32 mask = 0;
         for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
         {
           s32 CX1 = CY1;
@@ -488,7 +661,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                mask |= 1u << (iy * BLOCK_SIZE + ix);
             }
 
             CX1 -= FDY12;
@@ -500,17 +673,86 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
           CY2 += FDX23;
           CY3 += FDX31;
         }
+
+        if (mask != 0)
+          DrawQuad(context, setup, x, y, mask);
       }
     }
   }
 }
 
+static void DrawTiles(ThreadContext& context)
+{
+  // Each tile is drawn by a single thread, which draws its triangles in the order they were
+  // submitted. Tiles never share pixels, so the result doesn't depend on how they're split.
+  while (true)
+  {
+    const u32 index = nextTile.fetch_add(1, std::memory_order_relaxed);
+    if (index >= usedTiles.size())
+      return;
+
+    const u32 tile = usedTiles[index];
+    const s32 tile_x = static_cast<s32>(tile % TILES_WIDE) * TILE_SIZE;
+    const s32 tile_y = static_cast<s32>(tile / TILES_WIDE) * TILE_SIZE;
+    for (const u32 triangle : tileBins[tile])
+      DrawTriangle(context, triangles[triangle], tile_x, tile_y);
+  }
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
   INCSTAT(g_stats.this_frame.num_triangles_drawn);
 
   for (const auto& scissor : scissors)
-    DrawTriangleFrontFace(v0, v1, v2, scissor);
+    BinTriangle(v0, v1, v2, scissor);
+}
+
+void Flush()
+{
+  if (triangles.empty())
+    return;
+
+  // Textures and TLUTs are only ever loaded or written between flushes, so the decoded texels can
+  // be reused for the whole batch but not any longer than that.
+  TextureSampler::InvalidateTexelCaches();
+
+  nextTile.store(0, std::memory_order_relaxed);
+
+  u32 num_workers = 0;
+  if (triangles.size() >= MIN_PARALLEL_TRIANGLES)
+    num_workers = static_cast<u32>(std::min(workers.size(), usedTiles.size() - 1));
+
+  runningWorkers.store(num_workers, std::memory_order_relaxed);
+  for (u32 i = 0; i < num_workers; i++)
+    workers[i]->start.Set();
+
+  DrawTiles(*contexts[0]);
+
+  if (num_workers != 0)
+    workersDone.Wait();
+
+  for (const u32 tile : usedTiles)
+    tileBins[tile].clear();
+  usedTiles.clear();
+  triangles.clear();
+
+  for (auto& context : contexts)
+  {
+    ThreadCounters& counters = context->counters;
+
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, counters.rasterized_pixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, counters.tev_pixels_in);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, counters.tev_pixels_out);
+    EfbInterface::AddPerfCounters(counters.perf);
+
+    if (counters.bbox_left <= counters.bbox_right)
+    {
+      BBoxManager::Update(counters.bbox_left, counters.bbox_right, counters.bbox_top,
+                          counters.bbox_bottom);
+    }
+
+    counters = {};
+  }
 }
 }  // namespace Rasterizer
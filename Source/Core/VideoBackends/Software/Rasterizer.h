@@ -4,18 +4,24 @@
 #pragma once
 
 #include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
 
 struct OutputVertexData;
 
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
                   const OutputVertexData* v2, s32 x_off, s32 y_off);
+// Sets up the triangle and bins it into the screen tiles it covers. It is drawn by Flush.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+// Draws the binned triangles, with the tiles split between the rasterizer threads, and waits for
+// them to finish. Must be called before anything else accesses the EFB.
+void Flush();
 
 void SetTevKonstColors();
 
@@ -33,4 +39,19 @@ struct RasterBlock
   s32 TextureLod[16];
   bool TextureLinear[16];
 };
+
+// What a rasterizer thread counts while drawing. This is added to the statistics, perf counters
+// and bounding box once all the threads are done.
+struct ThreadCounters
+{
+  u32 rasterized_pixels = 0;
+  u32 tev_pixels_in = 0;
+  u32 tev_pixels_out = 0;
+  EfbInterface::PerfCounters perf;
+
+  u16 bbox_left = 0xffff;
+  u16 bbox_right = 0;
+  u16 bbox_top = 0xffff;
+  u16 bbox_bottom = 0;
+};
 }  // namespace Rasterizer
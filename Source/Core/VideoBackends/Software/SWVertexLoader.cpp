@@ -93,6 +93,10 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded);
   }
 
+  // The batch is always drawn in full here, as the state can change or the EFB be accessed as soon
+  // as it returns
+  Rasterizer::Flush();
+
   INCSTAT(g_stats.this_frame.num_drawn_objects);
 }
 
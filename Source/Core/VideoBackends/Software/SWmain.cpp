@@ -106,14 +106,21 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
   Clipper::Init();
   Rasterizer::Init();
 
-  return InitializeShared(std::make_unique<SWGfx>(std::move(window)),
-                          std::make_unique<SWVertexLoader>(), std::make_unique<PerfQuery>(),
-                          std::make_unique<SWBoundingBox>(), std::make_unique<SWRenderer>(),
-                          std::make_unique<TextureCache>());
+  if (!InitializeShared(std::make_unique<SWGfx>(std::move(window)),
+                        std::make_unique<SWVertexLoader>(), std::make_unique<PerfQuery>(),
+                        std::make_unique<SWBoundingBox>(), std::make_unique<SWRenderer>(),
+                        std::make_unique<TextureCache>()))
+  {
+    Rasterizer::Shutdown();
+    return false;
+  }
+
+  return true;
 }
 
 void VideoSoftware::Shutdown()
 {
   ShutdownShared();
+  Rasterizer::Shutdown();
 }
 }  // namespace SW
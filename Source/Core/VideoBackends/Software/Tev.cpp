@@ -13,12 +13,10 @@
 #include "Core/System.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -29,49 +27,41 @@
 #define ALLOW_TEV_DUMPS 0
 #endif
 
-static inline s16 Clamp255(s16 in)
+void Tev::SetRasColor(u32 pixel, RasColorChan colorChan, u32 swaptable)
 {
-  return std::clamp<s16>(in, 0, 255);
-}
-
-static inline s16 Clamp1024(s16 in)
-{
-  return std::clamp<s16>(in, -1024, 1023);
-}
+  TevColor& ras_color = Sources[pixel][SRC_RAS];
 
-void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
-{
   switch (colorChan)
   {
   case RasColorChan::Color0:
   {
-    const u8* color = Color[0];
+    const u8* color = Color[pixel][0];
     const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
-    RasColor.r = color[u32(swap[ColorChannel::Red])];
-    RasColor.g = color[u32(swap[ColorChannel::Green])];
-    RasColor.b = color[u32(swap[ColorChannel::Blue])];
-    RasColor.a = color[u32(swap[ColorChannel::Alpha])];
+    ras_color.r = color[u32(swap[ColorChannel::Red])];
+    ras_color.g = color[u32(swap[ColorChannel::Green])];
+    ras_color.b = color[u32(swap[ColorChannel::Blue])];
+    ras_color.a = color[u32(swap[ColorChannel::Alpha])];
   }
   break;
   case RasColorChan::Color1:
   {
-    const u8* color = Color[1];
+    const u8* color = Color[pixel][1];
     const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
-    RasColor.r = color[u32(swap[ColorChannel::Red])];
-    RasColor.g = color[u32(swap[ColorChannel::Green])];
-    RasColor.b = color[u32(swap[ColorChannel::Blue])];
-    RasColor.a = color[u32(swap[ColorChannel::Alpha])];
+    ras_color.r = color[u32(swap[ColorChannel::Red])];
+    ras_color.g = color[u32(swap[ColorChannel::Green])];
+    ras_color.b = color[u32(swap[ColorChannel::Blue])];
+    ras_color.a = color[u32(swap[ColorChannel::Alpha])];
   }
   break;
   case RasColorChan::AlphaBump:
   {
-    RasColor = TevColor::All(AlphaBump);
+    ras_color = TevColor::All(AlphaBump[pixel]);
   }
   break;
   case RasColorChan::NormalizedAlphaBump:
   {
-    const u8 normalized = AlphaBump | AlphaBump >> 5;
-    RasColor = TevColor::All(normalized);
+    const u8 normalized = AlphaBump[pixel] | AlphaBump[pixel] >> 5;
+    ras_color = TevColor::All(normalized);
   }
   break;
   default:
@@ -79,125 +69,12 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
     if (colorChan != RasColorChan::Zero)
       PanicAlertFmt("Invalid ras color channel: {}", colorChan);
 
-    RasColor = TevColor::All(0);
+    ras_color = TevColor::All(0);
   }
   break;
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = BLU_C; i <= RED_C; i++)
-  {
-    const InputRegType& InputReg = inputs[i];
-
-    const u16 c = InputReg.c + (InputReg.c >> 7);
-
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= s_ScaleLShiftLUT[cc.scale];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
-
-    s32 result = ((InputReg.d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
-    result = result >> s_ScaleRShiftLUT[cc.scale];
-
-    Reg[cc.dest][i] = result;
-  }
-}
-
-void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = BLU_C; i <= RED_C; i++)
-  {
-    u32 a, b;
-    switch (cc.compare_mode)
-    {
-    case TevCompareMode::R8:
-      a = inputs[RED_C].a;
-      b = inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::GR16:
-      a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::BGR24:
-      a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      break;
-
-    case TevCompareMode::RGB8:
-      a = inputs[i].a;
-      b = inputs[i].b;
-      break;
-
-    default:
-      PanicAlertFmt("Invalid compare mode {}", cc.compare_mode);
-      continue;
-    }
-
-    if (cc.comparison == TevComparison::GT)
-      Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
-    else
-      Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
-  }
-}
-
-void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  const InputRegType& InputReg = inputs[ALP_C];
-
-  const u16 c = InputReg.c + (InputReg.c >> 7);
-
-  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= s_ScaleLShiftLUT[ac.scale];
-  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
-  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
-
-  s32 result = ((InputReg.d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
-  result = result >> s_ScaleRShiftLUT[ac.scale];
-
-  Reg[ac.dest].a = result;
-}
-
-void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  u32 a, b;
-  switch (ac.compare_mode)
-  {
-  case TevCompareMode::R8:
-    a = inputs[RED_C].a;
-    b = inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::GR16:
-    a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::BGR24:
-    a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    break;
-
-  case TevCompareMode::A8:
-    a = inputs[ALP_C].a;
-    b = inputs[ALP_C].b;
-    break;
-
-  default:
-    PanicAlertFmt("Invalid compare mode {}", ac.compare_mode);
-    return;
-  }
-
-  if (ac.comparison == TevComparison::GT)
-    Reg[ac.dest].a = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
-  else
-    Reg[ac.dest].a = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
-}
-
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
 {
   switch (comp)
@@ -269,10 +146,12 @@ static inline s32 WrapIndirectCoord(s32 coord, IndTexWrap wrapMode)
   }
 }
 
-void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
+void Tev::Indirect(u32 pixel, unsigned int stageNum, s32 s, s32 t)
 {
   const TevStageIndirect& indirect = bpmem.tevind[stageNum];
-  const u8* indmap = IndirectTex[indirect.bt];
+  const u8* indmap = IndirectTex[pixel][indirect.bt];
+  u8& alpha_bump = AlphaBump[pixel];
+  TextureCoordinateType& tex_coord = TexCoord[pixel];
 
   s32 indcoord[3];
 
@@ -280,16 +159,16 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   switch (indirect.bs)
   {
   case IndTexBumpAlpha::Off:
-    AlphaBump = 0;
+    alpha_bump = 0;
     break;
   case IndTexBumpAlpha::S:
-    AlphaBump = indmap[TextureSampler::ALP_SMP];
+    alpha_bump = indmap[TextureSampler::ALP_SMP];
     break;
   case IndTexBumpAlpha::T:
-    AlphaBump = indmap[TextureSampler::BLU_SMP];
+    alpha_bump = indmap[TextureSampler::BLU_SMP];
     break;
   case IndTexBumpAlpha::U:
-    AlphaBump = indmap[TextureSampler::GRN_SMP];
+    alpha_bump = indmap[TextureSampler::GRN_SMP];
     break;
   default:
     PanicAlertFmt("Invalid alpha bump {}", indirect.bs);
@@ -310,25 +189,25 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
     indcoord[0] = indmap[TextureSampler::ALP_SMP] + bias[0];
     indcoord[1] = indmap[TextureSampler::BLU_SMP] + bias[1];
     indcoord[2] = indmap[TextureSampler::GRN_SMP] + bias[2];
-    AlphaBump = AlphaBump & 0xf8;
+    alpha_bump = alpha_bump & 0xf8;
     break;
   case IndTexFormat::ITF_5:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] >> 3) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] >> 3) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] >> 3) + bias[2];
-    AlphaBump = AlphaBump << 5;
+    alpha_bump = alpha_bump << 5;
     break;
   case IndTexFormat::ITF_4:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] >> 4) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] >> 4) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] >> 4) + bias[2];
-    AlphaBump = AlphaBump << 4;
+    alpha_bump = alpha_bump << 4;
     break;
   case IndTexFormat::ITF_3:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] >> 5) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] >> 5) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] >> 5) + bias[2];
-    AlphaBump = AlphaBump << 3;
+    alpha_bump = alpha_bump << 3;
     break;
   default:
     PanicAlertFmt("Invalid indirect format {}", indirect.fmt);
@@ -382,33 +261,54 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
 
   if (indirect.fb_addprev)
   {
-    TexCoord.s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    tex_coord.s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    tex_coord.t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
   else
   {
-    TexCoord.s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    tex_coord.s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    tex_coord.t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
 }
 
-void Tev::Draw()
+void Tev::SelectColorInput(const SourceColors& sources, TevColorArg arg,
+                           TevCombiner::PixelColor& input)
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+  const ColorInput& select = s_ColorInputLUT[arg];
+  const TevColor& color = sources[select.source];
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  input[BLU_C] = select.alpha ? color.a : color.b;
+  input[GRN_C] = select.alpha ? color.a : color.g;
+  input[RED_C] = select.alpha ? color.a : color.r;
+}
 
+void Tev::Draw(u32 mask, Rasterizer::ThreadCounters& counters)
+{
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
 
-  // initial color values
-  for (int i = 0; i < 4; i++)
+  for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
   {
-    Reg[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
-    Reg[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
-    Reg[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
-    Reg[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
+    if (!(mask & (1u << pixel)))
+      continue;
+
+    ASSERT(Position[pixel][0] >= 0 && Position[pixel][0] < s32(EFB_WIDTH));
+    ASSERT(Position[pixel][1] >= 0 && Position[pixel][1] < s32(EFB_HEIGHT));
+
+    counters.tev_pixels_in++;
+
+    // initial color values
+    SourceColors& sources = Sources[pixel];
+    for (int i = 0; i < 4; i++)
+    {
+      sources[i].r = pixel_shader_manager.constants.colors[i][0];
+      sources[i].g = pixel_shader_manager.constants.colors[i][1];
+      sources[i].b = pixel_shader_manager.constants.colors[i][2];
+      sources[i].a = pixel_shader_manager.constants.colors[i][3];
+    }
+    sources[SRC_ZERO] = TevColor::All(V0);
+    sources[SRC_ONE] = TevColor::All(V1);
+    sources[SRC_HALF] = TevColor::All(V1_2);
   }
 
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
@@ -430,9 +330,15 @@ void Tev::Draw()
     const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
     const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
 
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+    for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
+    {
+      if (!(mask & (1u << pixel)))
+        continue;
+
+      const TextureCoordinateType& uv = Uv[pixel][texcoordSel];
+      TextureSampler::Sample(m_TexelCache, uv.s >> scaleS, uv.t >> scaleT, IndirectLod[stageNum],
+                             IndirectLinear[stageNum], texmap, IndirectTex[pixel][stageNum]);
+    }
   }
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
@@ -453,33 +359,6 @@ void Tev::Draw()
     if (texcoordSel >= bpmem.genMode.numtexgens)
       texcoordSel = 0;
 
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
-
-    // sample texture
-    if (order.getEnable(stageOdd))
-    {
-      // RGBA
-      u8 texel[4];
-
-      if (bpmem.genMode.numtexgens > 0)
-      {
-        TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
-      }
-      else
-      {
-        // It seems like the result is always black when no tex coords are enabled, but further
-        // hardware testing is needed.
-        std::memset(texel, 0, 4);
-      }
-
-      const auto& swap = bpmem.tevksel.GetSwapTable(ac.tswap);
-      TexColor.r = texel[u32(swap[ColorChannel::Red])];
-      TexColor.g = texel[u32(swap[ColorChannel::Green])];
-      TexColor.b = texel[u32(swap[ColorChannel::Blue])];
-      TexColor.a = texel[u32(swap[ColorChannel::Alpha])];
-    }
-
     // set konst for this stage
     const auto kc = bpmem.tevksel.GetKonstColor(stageNum);
     const auto ka = bpmem.tevksel.GetKonstAlpha(stageNum);
@@ -488,64 +367,98 @@ void Tev::Draw()
     StageKonst.b = m_KonstLUT[kc].b;
     StageKonst.a = m_KonstLUT[ka].a;
 
-    // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap);
-
-    // combine inputs
-    InputRegType inputs[4];
-    inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
-    inputs[BLU_C].b = m_ColorInputLUT[cc.b].b;
-    inputs[BLU_C].c = m_ColorInputLUT[cc.c].b;
-    inputs[BLU_C].d = m_ColorInputLUT[cc.d].b;
-    inputs[GRN_C].a = m_ColorInputLUT[cc.a].g;
-    inputs[GRN_C].b = m_ColorInputLUT[cc.b].g;
-    inputs[GRN_C].c = m_ColorInputLUT[cc.c].g;
-    inputs[GRN_C].d = m_ColorInputLUT[cc.d].g;
-    inputs[RED_C].a = m_ColorInputLUT[cc.a].r;
-    inputs[RED_C].b = m_ColorInputLUT[cc.b].r;
-    inputs[RED_C].c = m_ColorInputLUT[cc.c].r;
-    inputs[RED_C].d = m_ColorInputLUT[cc.d].r;
-    inputs[ALP_C].a = m_AlphaInputLUT[ac.a].a;
-    inputs[ALP_C].b = m_AlphaInputLUT[ac.b].a;
-    inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
-    inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
-
-    if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
+    // The combiners run on the whole quad, so the inputs of pixels outside the mask are left at 0
+    TevCombiner::QuadInputs inputs{};
 
-    if (cc.clamp)
+    for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
     {
-      Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
+      if (!(mask & (1u << pixel)))
+        continue;
+
+      SourceColors& sources = Sources[pixel];
+
+      Indirect(pixel, stageNum, Uv[pixel][texcoordSel].s, Uv[pixel][texcoordSel].t);
+
+      // sample texture
+      if (order.getEnable(stageOdd))
+      {
+        // RGBA
+        u8 texel[4];
+
+        if (bpmem.genMode.numtexgens > 0)
+        {
+          TextureSampler::Sample(m_TexelCache, TexCoord[pixel].s, TexCoord[pixel].t,
+                                 TextureLod[stageNum], TextureLinear[stageNum], texmap, texel);
+        }
+        else
+        {
+          // It seems like the result is always black when no tex coords are enabled, but further
+          // hardware testing is needed.
+          std::memset(texel, 0, 4);
+        }
+
+        const auto& swap = bpmem.tevksel.GetSwapTable(ac.tswap);
+        TevColor& tex_color = sources[SRC_TEX];
+        tex_color.r = texel[u32(swap[ColorChannel::Red])];
+        tex_color.g = texel[u32(swap[ColorChannel::Green])];
+        tex_color.b = texel[u32(swap[ColorChannel::Blue])];
+        tex_color.a = texel[u32(swap[ColorChannel::Alpha])];
+      }
+
+      sources[SRC_KONST] = StageKonst;
+
+      // set color
+      SetRasColor(pixel, order.getColorChan(stageOdd), ac.rswap);
+
+      // combine inputs
+      SelectColorInput(sources, cc.a, inputs.a.pixels[pixel]);
+      SelectColorInput(sources, cc.b, inputs.b.pixels[pixel]);
+      SelectColorInput(sources, cc.c, inputs.c.pixels[pixel]);
+      SelectColorInput(sources, cc.d, inputs.d.pixels[pixel]);
+      inputs.a.pixels[pixel][ALP_C] = sources[s_AlphaInputLUT[ac.a]].a;
+      inputs.b.pixels[pixel][ALP_C] = sources[s_AlphaInputLUT[ac.b]].a;
+      inputs.c.pixels[pixel][ALP_C] = sources[s_AlphaInputLUT[ac.c]].a;
+      inputs.d.pixels[pixel][ALP_C] = sources[s_AlphaInputLUT[ac.d]].a;
     }
-    else
+
+    TevCombiner::QuadColors result;
+    m_Combine(cc, ac, inputs, result);
+
+    for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
     {
-      Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
+      if (!(mask & (1u << pixel)))
+        continue;
+
+      const TevCombiner::PixelColor& color = result.pixels[pixel];
+      TevColor& color_dest = Sources[pixel][static_cast<u32>(cc.dest.Value())];
+      color_dest.r = color[RED_C];
+      color_dest.g = color[GRN_C];
+      color_dest.b = color[BLU_C];
+      Sources[pixel][static_cast<u32>(ac.dest.Value())].a = color[ALP_C];
     }
+  }
 
-    if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
-
-    if (ac.clamp)
-      Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
-    else
-      Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+  for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
+  {
+    if (mask & (1u << pixel))
+      DrawPixel(pixel, counters);
   }
+}
+
+void Tev::DrawPixel(u32 pixel, Rasterizer::ThreadCounters& counters)
+{
+  const SourceColors& sources = Sources[pixel];
+  const TevColor& tex_color = sources[SRC_TEX];
+  s32* const position = Position[pixel];
 
   // convert to 8 bits per component
   // the results of the last tev stage are put onto the screen,
   // regardless of the used destination register - TODO: Verify!
   const auto& color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
   const auto& alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
-  u8 output[4] = {(u8)Reg[alpha_index].a, (u8)Reg[color_index].b, (u8)Reg[color_index].g,
-                  (u8)Reg[color_index].r};
+  const TevColor& color = sources[static_cast<u32>(color_index.Value())];
+  const TevColor& alpha = sources[static_cast<u32>(alpha_index.Value())];
+  u8 output[4] = {(u8)alpha.a, (u8)color.b, (u8)color.g, (u8)color.r};
 
   if (!TevAlphaTest(output[ALP_C]))
     return;
@@ -557,22 +470,22 @@ void Tev::Draw()
     switch (bpmem.ztex2.type)
     {
     case ZTexFormat::U8:
-      ztex += TexColor[ALP_C];
+      ztex += tex_color.a;
       break;
     case ZTexFormat::U16:
-      ztex += TexColor[ALP_C] << 8 | TexColor[RED_C];
+      ztex += tex_color.a << 8 | tex_color.r;
       break;
     case ZTexFormat::U24:
-      ztex += TexColor[RED_C] << 16 | TexColor[GRN_C] << 8 | TexColor[BLU_C];
+      ztex += tex_color.r << 16 | tex_color.g << 8 | tex_color.b;
       break;
     default:
       PanicAlertFmt("Invalid ztex format {}", bpmem.ztex2.type);
     }
 
     if (bpmem.ztex2.op == ZTexOp::Add)
-      ztex += Position[2];
+      ztex += position[2];
 
-    Position[2] = ztex & 0x00ffffff;
+    position[2] = ztex & 0x00ffffff;
   }
 
   // fog
@@ -584,7 +497,7 @@ void Tev::Draw()
     {
       // perspective
       // ze = A/(B - (Zs >> B_SHF))
-      const s32 denom = bpmem.fog.b_magnitude - (Position[2] >> bpmem.fog.b_shift);
+      const s32 denom = bpmem.fog.b_magnitude - (position[2] >> bpmem.fog.b_shift);
       // in addition downscale magnitude and zs to 0.24 bits
       ze = (bpmem.fog.GetA() * 16777215.0f) / static_cast<float>(denom);
     }
@@ -593,7 +506,7 @@ void Tev::Draw()
       // orthographic
       // ze = a*Zs
       // in addition downscale zs to 0.24 bits
-      ze = bpmem.fog.GetA() * (static_cast<float>(Position[2]) / 16777215.0f);
+      ze = bpmem.fog.GetA() * (static_cast<float>(position[2]) / 16777215.0f);
     }
 
     if (bpmem.fogRange.Base.Enabled)
@@ -605,7 +518,7 @@ void Tev::Draw()
 
       // First, calculate the offset from the viewport center (normalized to 0..1)
       const float offset =
-          (Position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
+          (position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
           static_cast<float>(xfmem.viewport.wd);
 
       // Based on that, choose the index such that points which are far away from the z-axis use the
@@ -666,23 +579,25 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    EfbInterface::IncPerfCounterQuadCount(counters.perf, PQ_ZCOMP_INPUT);
 
-    if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
+    if (!EfbInterface::ZCompare(position[0], position[1], position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    EfbInterface::IncPerfCounterQuadCount(counters.perf, PQ_ZCOMP_OUTPUT);
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  counters.bbox_left = std::min(counters.bbox_left, static_cast<u16>(position[0] & ~1));
+  counters.bbox_right = std::max(counters.bbox_right, static_cast<u16>(position[0] | 1));
+  counters.bbox_top = std::min(counters.bbox_top, static_cast<u16>(position[1] & ~1));
+  counters.bbox_bottom = std::max(counters.bbox_bottom, static_cast<u16>(position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  counters.tev_pixels_out++;
+  EfbInterface::IncPerfCounterQuadCount(counters.perf, PQ_BLEND_INPUT);
 
-  EfbInterface::BlendTev(Position[0], Position[1], output);
+  EfbInterface::BlendTev(position[0], position[1], output);
 }
 
 void Tev::SetKonstColors()
@@ -6,6 +6,9 @@
 #include <array>
 
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/TevCombiner.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/BPMemory.h"
 
 class Tev
@@ -41,33 +44,6 @@ class Tev
     }
   };
 
-  struct TevColorRef
-  {
-    constexpr explicit TevColorRef(const s16& r_, const s16& g_, const s16& b_)
-        : r(r_), g(g_), b(b_)
-    {
-    }
-
-    const s16& r;
-    const s16& g;
-    const s16& b;
-
-    constexpr static TevColorRef Color(const TevColor& color)
-    {
-      return TevColorRef(color.r, color.g, color.b);
-    }
-    constexpr static TevColorRef All(const s16& value) { return TevColorRef(value, value, value); }
-    constexpr static TevColorRef Alpha(const TevColor& color) { return All(color.a); }
-  };
-
-  struct TevAlphaRef
-  {
-    constexpr explicit TevAlphaRef(const TevColor& color) : a(color.a) {}
-    constexpr explicit TevAlphaRef(const s16& a_) : a(a_) {}
-
-    const s16& a;
-  };
-
   struct TevKonstRef
   {
     constexpr explicit TevKonstRef(const s16& a_, const s16& r_, const s16& g_, const s16& b_)
@@ -90,25 +66,39 @@ class Tev
     }
   };
 
-  struct InputRegType
-  {
-    unsigned a : 8;
-    unsigned b : 8;
-    unsigned c : 8;
-    signed d : 11;
-  };
-
   struct TextureCoordinateType
   {
     signed s : 24;
     signed t : 24;
   };
 
+  // The values the combiner inputs select from. The registers come first, in TevOutput order.
+  enum Source
+  {
+    SRC_PREV,
+    SRC_C0,
+    SRC_C1,
+    SRC_C2,
+    SRC_TEX,
+    SRC_RAS,
+    SRC_KONST,
+    SRC_ZERO,
+    SRC_ONE,
+    SRC_HALF,
+    NUM_SOURCES
+  };
+
+  struct ColorInput
+  {
+    u8 source;
+    bool alpha;
+  };
+
+  using SourceColors = std::array<TevColor, NUM_SOURCES>;
+
   // color order: ABGR
-  Common::EnumMap<TevColor, TevOutput::Color2> Reg;
+  std::array<SourceColors, TevCombiner::QUAD_SIZE> Sources{};
   std::array<TevColor, 4> KonstantColors;
-  TevColor TexColor;
-  TevColor RasColor;
   TevColor StageKonst;
 
   // Fixed constants, corresponding to KonstSel
@@ -122,37 +112,40 @@ class Tev
   static constexpr s16 V7_8 = 223;
   static constexpr s16 V1 = 255;
 
-  u8 AlphaBump = 0;
-  u8 IndirectTex[4][4]{};
-  TextureCoordinateType TexCoord{};
-
-  const Common::EnumMap<TevColorRef, TevColorArg::Zero> m_ColorInputLUT{
-      TevColorRef::Color(Reg[TevOutput::Prev]),    // prev.rgb
-      TevColorRef::Alpha(Reg[TevOutput::Prev]),    // prev.aaa
-      TevColorRef::Color(Reg[TevOutput::Color0]),  // c0.rgb
-      TevColorRef::Alpha(Reg[TevOutput::Color0]),  // c0.aaa
-      TevColorRef::Color(Reg[TevOutput::Color1]),  // c1.rgb
-      TevColorRef::Alpha(Reg[TevOutput::Color1]),  // c1.aaa
-      TevColorRef::Color(Reg[TevOutput::Color2]),  // c2.rgb
-      TevColorRef::Alpha(Reg[TevOutput::Color2]),  // c2.aaa
-      TevColorRef::Color(TexColor),                // tex.rgb
-      TevColorRef::Alpha(TexColor),                // tex.aaa
-      TevColorRef::Color(RasColor),                // ras.rgb
-      TevColorRef::Alpha(RasColor),                // ras.aaa
-      TevColorRef::All(V1),                        // one
-      TevColorRef::All(V1_2),                      // half
-      TevColorRef::Color(StageKonst),              // konst
-      TevColorRef::All(V0),                        // zero
+  u8 AlphaBump[TevCombiner::QUAD_SIZE]{};
+  u8 IndirectTex[TevCombiner::QUAD_SIZE][4][4]{};
+  TextureCoordinateType TexCoord[TevCombiner::QUAD_SIZE]{};
+
+  TevCombiner::CombineFunction m_Combine = TevCombiner::GetCombineFunction();
+  TextureSampler::TexelCache m_TexelCache;
+
+  static constexpr Common::EnumMap<ColorInput, TevColorArg::Zero> s_ColorInputLUT{
+      ColorInput{SRC_PREV, false},   // prev.rgb
+      ColorInput{SRC_PREV, true},    // prev.aaa
+      ColorInput{SRC_C0, false},     // c0.rgb
+      ColorInput{SRC_C0, true},      // c0.aaa
+      ColorInput{SRC_C1, false},     // c1.rgb
+      ColorInput{SRC_C1, true},      // c1.aaa
+      ColorInput{SRC_C2, false},     // c2.rgb
+      ColorInput{SRC_C2, true},      // c2.aaa
+      ColorInput{SRC_TEX, false},    // tex.rgb
+      ColorInput{SRC_TEX, true},     // tex.aaa
+      ColorInput{SRC_RAS, false},    // ras.rgb
+      ColorInput{SRC_RAS, true},     // ras.aaa
+      ColorInput{SRC_ONE, false},    // one
+      ColorInput{SRC_HALF, false},   // half
+      ColorInput{SRC_KONST, false},  // konst
+      ColorInput{SRC_ZERO, false},   // zero
   };
-  const Common::EnumMap<TevAlphaRef, TevAlphaArg::Zero> m_AlphaInputLUT{
-      TevAlphaRef(Reg[TevOutput::Prev]),    // prev
-      TevAlphaRef(Reg[TevOutput::Color0]),  // c0
-      TevAlphaRef(Reg[TevOutput::Color1]),  // c1
-      TevAlphaRef(Reg[TevOutput::Color2]),  // c2
-      TevAlphaRef(TexColor),                // tex
-      TevAlphaRef(RasColor),                // ras
-      TevAlphaRef(StageKonst),              // konst
-      TevAlphaRef(V0),                      // zero
+  static constexpr Common::EnumMap<u8, TevAlphaArg::Zero> s_AlphaInputLUT{
+      SRC_PREV,   // prev
+      SRC_C0,     // c0
+      SRC_C1,     // c1
+      SRC_C2,     // c2
+      SRC_TEX,    // tex
+      SRC_RAS,    // ras
+      SRC_KONST,  // konst
+      SRC_ZERO,   // zero
   };
   const Common::EnumMap<TevKonstRef, KonstSel::K3_A> m_KonstLUT{
       TevKonstRef::Value(V1),    // 1
@@ -192,10 +185,6 @@ class Tev
       TevKonstRef::Value(KonstantColors[2].a),  // Konst 2 Alpha
       TevKonstRef::Value(KonstantColors[3].a),  // Konst 3 Alpha
   };
-  static constexpr Common::EnumMap<s16, TevBias::Compare> s_BiasLUT{0, 128, -128, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleLShiftLUT{0, 1, 2, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleRShiftLUT{0, 0, 0, 1};
-
   enum BufferBase
   {
     DIRECT = 0,
@@ -203,19 +192,21 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, u32 swaptable);
+  static void SelectColorInput(const SourceColors& sources, TevColorArg arg,
+                               TevCombiner::PixelColor& input);
+  void SetRasColor(u32 pixel, RasColorChan colorChan, u32 swaptable);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
-  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  void Indirect(u32 pixel, unsigned int stageNum, s32 s, s32 t);
 
-  void Indirect(unsigned int stageNum, s32 s, s32 t);
+  void DrawPixel(u32 pixel, Rasterizer::ThreadCounters& counters);
 
 public:
-  s32 Position[3]{};
-  u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
-  TextureCoordinateType Uv[8]{};
+  // Per pixel of the quad, with pixel (x, y) at index y * 2 + x
+  s32 Position[TevCombiner::QUAD_SIZE][3]{};
+  u8 Color[TevCombiner::QUAD_SIZE][2][4]{};  // must be RGBA for correct swap table ordering
+  TextureCoordinateType Uv[TevCombiner::QUAD_SIZE][8]{};
+
+  // Per quad
   s32 IndirectLod[4]{};
   bool IndirectLinear[4]{};
   s32 TextureLod[16]{};
@@ -230,5 +221,6 @@ public:
   };
 
   void SetKonstColors();
-  void Draw();
+  // Draws the pixels of the quad that are set in mask, with pixel i at bit i
+  void Draw(u32 mask, Rasterizer::ThreadCounters& counters);
 };
@@ -0,0 +1,489 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/TevCombiner.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+#include "Common/Inline.h"
+#include "Common/MsgHandler.h"
+
+#if defined(_M_X86_64)
+#include <immintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace TevCombiner
+{
+namespace
+{
+enum
+{
+  ALP_C,
+  BLU_C,
+  GRN_C,
+  RED_C
+};
+
+constexpr Common::EnumMap<s16, TevBias::Compare> s_bias_lut{0, 128, -128, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_scale_lshift_lut{0, 1, 2, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_scale_rshift_lut{0, 0, 0, 1};
+
+struct InputRegType
+{
+  unsigned a : 8;
+  unsigned b : 8;
+  unsigned c : 8;
+  signed d : 11;
+};
+
+s16 Clamp255(s16 in)
+{
+  return std::clamp<s16>(in, 0, 255);
+}
+
+s16 Clamp1024(s16 in)
+{
+  return std::clamp<s16>(in, -1024, 1023);
+}
+
+void ColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4],
+                  PixelColor& output)
+{
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    const InputRegType& InputReg = inputs[i];
+
+    const u16 c = InputReg.c + (InputReg.c >> 7);
+
+    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+    temp <<= s_scale_lshift_lut[cc.scale];
+    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+    temp >>= 8;
+    temp = cc.op == TevOp::Sub ? -temp : temp;
+
+    s32 result = ((InputReg.d + s_bias_lut[cc.bias]) << s_scale_lshift_lut[cc.scale]) + temp;
+    result = result >> s_scale_rshift_lut[cc.scale];
+
+    output[i] = result;
+  }
+}
+
+void ColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4],
+                  PixelColor& output)
+{
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    u32 a, b;
+    switch (cc.compare_mode)
+    {
+    case TevCompareMode::R8:
+      a = inputs[RED_C].a;
+      b = inputs[RED_C].b;
+      break;
+
+    case TevCompareMode::GR16:
+      a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      break;
+
+    case TevCompareMode::BGR24:
+      a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      break;
+
+    case TevCompareMode::RGB8:
+      a = inputs[i].a;
+      b = inputs[i].b;
+      break;
+
+    default:
+      PanicAlertFmt("Invalid compare mode {}", cc.compare_mode);
+      continue;
+    }
+
+    if (cc.comparison == TevComparison::GT)
+      output[i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
+    else
+      output[i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+  }
+}
+
+void AlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4],
+                  PixelColor& output)
+{
+  const InputRegType& InputReg = inputs[ALP_C];
+
+  const u16 c = InputReg.c + (InputReg.c >> 7);
+
+  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+  temp <<= s_scale_lshift_lut[ac.scale];
+  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
+  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((InputReg.d + s_bias_lut[ac.bias]) << s_scale_lshift_lut[ac.scale]) + temp;
+  result = result >> s_scale_rshift_lut[ac.scale];
+
+  output[ALP_C] = result;
+}
+
+void AlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4],
+                  PixelColor& output)
+{
+  u32 a, b;
+  switch (ac.compare_mode)
+  {
+  case TevCompareMode::R8:
+    a = inputs[RED_C].a;
+    b = inputs[RED_C].b;
+    break;
+
+  case TevCompareMode::GR16:
+    a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    break;
+
+  case TevCompareMode::BGR24:
+    a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    break;
+
+  case TevCompareMode::A8:
+    a = inputs[ALP_C].a;
+    b = inputs[ALP_C].b;
+    break;
+
+  default:
+    PanicAlertFmt("Invalid compare mode {}", ac.compare_mode);
+    return;
+  }
+
+  if (ac.comparison == TevComparison::GT)
+    output[ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
+  else
+    output[ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+}
+
+// The arithmetic of both combiners with one 32-bit lane per channel, in the same order as the
+// colors. The alpha lane follows the alpha combiner, the others the color combiner.
+struct alignas(16) LaneParams
+{
+  std::array<s32, 4> lshift;
+  std::array<s32, 4> lmul;
+  std::array<s32, 4> rshift;
+  std::array<s32, 4> rmask;
+  std::array<s32, 4> round;
+  std::array<s32, 4> bias;
+  // All ones where the weighted sum is negated before the shift (alpha) or after it (color)
+  std::array<s32, 4> negate_before;
+  std::array<s32, 4> negate_after;
+  std::array<s32, 4> min;
+  std::array<s32, 4> max;
+};
+
+[[maybe_unused]] LaneParams GetLaneParams(const TevStageCombiner::ColorCombiner& cc,
+                                          const TevStageCombiner::AlphaCombiner& ac)
+{
+  LaneParams params;
+  for (int i = 0; i < 4; i++)
+  {
+    const bool alpha = i == ALP_C;
+    const TevScale scale = alpha ? ac.scale.Value() : cc.scale.Value();
+    const bool subtract = (alpha ? ac.op.Value() : cc.op.Value()) == TevOp::Sub;
+    const bool clamp = alpha ? ac.clamp.Value() : cc.clamp.Value();
+
+    params.lshift[i] = s_scale_lshift_lut[scale];
+    params.lmul[i] = 1 << params.lshift[i];
+    params.rshift[i] = s_scale_rshift_lut[scale];
+    params.rmask[i] = params.rshift[i] != 0 ? -1 : 0;
+    params.round[i] = scale == TevScale::Divide2 ? 0 : subtract ? 127 : 128;
+    params.bias[i] = s_bias_lut[alpha ? ac.bias.Value() : cc.bias.Value()];
+    params.negate_before[i] = alpha && subtract ? -1 : 0;
+    params.negate_after[i] = !alpha && subtract ? -1 : 0;
+    params.min[i] = clamp ? 0 : -1024;
+    params.max[i] = clamp ? 255 : 1023;
+  }
+  return params;
+}
+
+#if defined(_M_X86_64)
+
+#if defined(__GNUC__) && !defined(__SSE4_1__)
+#define ATTR_SSE41 __attribute__((target("sse4.1")))
+#else
+#define ATTR_SSE41
+#endif
+
+#if defined(__GNUC__) && !defined(__AVX2__)
+#define ATTR_AVX2 __attribute__((target("avx2")))
+#else
+#define ATTR_AVX2
+#endif
+
+struct LaneVectorsSSE41
+{
+  __m128i lmul;
+  __m128i rmask;
+  __m128i round;
+  __m128i bias;
+  __m128i negate_before;
+  __m128i negate_after;
+  __m128i min;
+  __m128i max;
+};
+
+ATTR_SSE41 DOLPHIN_FORCE_INLINE __m128i LoadSSE41(const std::array<s32, 4>& lanes)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes.data()));
+}
+
+ATTR_SSE41 DOLPHIN_FORCE_INLINE __m128i LoadPixelSSE41(const QuadColors& colors, u32 pixel)
+{
+  const __m128i color = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&colors.pixels[pixel]));
+  return _mm_cvtepi16_epi32(color);
+}
+
+ATTR_SSE41 DOLPHIN_FORCE_INLINE __m128i CombinePixelSSE41(const QuadInputs& inputs, u32 pixel,
+                                                          const LaneVectorsSSE41& v)
+{
+  const __m128i byte_mask = _mm_set1_epi32(0xff);
+  const __m128i a = _mm_and_si128(LoadPixelSSE41(inputs.a, pixel), byte_mask);
+  const __m128i b = _mm_and_si128(LoadPixelSSE41(inputs.b, pixel), byte_mask);
+  __m128i c = _mm_and_si128(LoadPixelSSE41(inputs.c, pixel), byte_mask);
+  const __m128i d = _mm_srai_epi32(_mm_slli_epi32(LoadPixelSSE41(inputs.d, pixel), 21), 21);
+
+  // a * (256 - c) + b * c == (a << 8) + (b - a) * c
+  c = _mm_add_epi32(c, _mm_srli_epi32(c, 7));
+  __m128i temp = _mm_add_epi32(_mm_slli_epi32(a, 8), _mm_mullo_epi32(_mm_sub_epi32(b, a), c));
+  temp = _mm_add_epi32(_mm_mullo_epi32(temp, v.lmul), v.round);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, v.negate_before), v.negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, v.negate_after), v.negate_after);
+
+  __m128i result = _mm_add_epi32(_mm_mullo_epi32(_mm_add_epi32(d, v.bias), v.lmul), temp);
+  result = _mm_blendv_epi8(result, _mm_srai_epi32(result, 1), v.rmask);
+  return _mm_max_epi32(_mm_min_epi32(result, v.max), v.min);
+}
+
+ATTR_AVX2 DOLPHIN_FORCE_INLINE __m256i LoadAVX2(const std::array<s32, 4>& lanes)
+{
+  const __m128i lanes128 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes.data()));
+  return _mm256_broadcastsi128_si256(lanes128);
+}
+
+ATTR_AVX2 DOLPHIN_FORCE_INLINE __m256i LoadPixelsAVX2(const QuadColors& colors, u32 pixel)
+{
+  const __m128i color = _mm_load_si128(reinterpret_cast<const __m128i*>(&colors.pixels[pixel]));
+  return _mm256_cvtepi16_epi32(color);
+}
+
+#endif
+}  // namespace
+
+void CombineScalar(const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                   QuadColors& output)
+{
+  for (u32 pixel = 0; pixel < QUAD_SIZE; pixel++)
+  {
+    InputRegType regs[4];
+    for (int i = 0; i < 4; i++)
+    {
+      regs[i].a = inputs.a.pixels[pixel][i];
+      regs[i].b = inputs.b.pixels[pixel][i];
+      regs[i].c = inputs.c.pixels[pixel][i];
+      regs[i].d = inputs.d.pixels[pixel][i];
+    }
+
+    PixelColor& color = output.pixels[pixel];
+
+    if (cc.bias != TevBias::Compare)
+      ColorRegular(cc, regs, color);
+    else
+      ColorCompare(cc, regs, color);
+
+    if (cc.clamp)
+    {
+      color[RED_C] = Clamp255(color[RED_C]);
+      color[GRN_C] = Clamp255(color[GRN_C]);
+      color[BLU_C] = Clamp255(color[BLU_C]);
+    }
+    else
+    {
+      color[RED_C] = Clamp1024(color[RED_C]);
+      color[GRN_C] = Clamp1024(color[GRN_C]);
+      color[BLU_C] = Clamp1024(color[BLU_C]);
+    }
+
+    if (ac.bias != TevBias::Compare)
+      AlphaRegular(ac, regs, color);
+    else
+      AlphaCompare(ac, regs, color);
+
+    if (ac.clamp)
+      color[ALP_C] = Clamp255(color[ALP_C]);
+    else
+      color[ALP_C] = Clamp1024(color[ALP_C]);
+  }
+}
+
+#if defined(_M_X86_64)
+
+ATTR_SSE41 void CombineSSE41(const TevStageCombiner::ColorCombiner& cc,
+                             const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                             QuadColors& output)
+{
+  // Compare mode is rare enough that it isn't worth vectorizing
+  if (cc.bias == TevBias::Compare || ac.bias == TevBias::Compare)
+  {
+    CombineScalar(cc, ac, inputs, output);
+    return;
+  }
+
+  const LaneParams params = GetLaneParams(cc, ac);
+  LaneVectorsSSE41 v;
+  v.lmul = LoadSSE41(params.lmul);
+  v.rmask = LoadSSE41(params.rmask);
+  v.round = LoadSSE41(params.round);
+  v.bias = LoadSSE41(params.bias);
+  v.negate_before = LoadSSE41(params.negate_before);
+  v.negate_after = LoadSSE41(params.negate_after);
+  v.min = LoadSSE41(params.min);
+  v.max = LoadSSE41(params.max);
+
+  for (u32 pixel = 0; pixel < QUAD_SIZE; pixel += 2)
+  {
+    const __m128i result0 = CombinePixelSSE41(inputs, pixel, v);
+    const __m128i result1 = CombinePixelSSE41(inputs, pixel + 1, v);
+
+    // The results always fit in 16 bits, so packing doesn't saturate them
+    _mm_store_si128(reinterpret_cast<__m128i*>(&output.pixels[pixel]),
+                    _mm_packs_epi32(result0, result1));
+  }
+}
+
+ATTR_AVX2 void CombineAVX2(const TevStageCombiner::ColorCombiner& cc,
+                           const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                           QuadColors& output)
+{
+  // Compare mode is rare enough that it isn't worth vectorizing
+  if (cc.bias == TevBias::Compare || ac.bias == TevBias::Compare)
+  {
+    CombineScalar(cc, ac, inputs, output);
+    return;
+  }
+
+  const LaneParams params = GetLaneParams(cc, ac);
+  const __m256i lshift = LoadAVX2(params.lshift);
+  const __m256i rshift = LoadAVX2(params.rshift);
+  const __m256i round = LoadAVX2(params.round);
+  const __m256i bias = LoadAVX2(params.bias);
+  const __m256i negate_before = LoadAVX2(params.negate_before);
+  const __m256i negate_after = LoadAVX2(params.negate_after);
+  const __m256i min = LoadAVX2(params.min);
+  const __m256i max = LoadAVX2(params.max);
+  const __m256i byte_mask = _mm256_set1_epi32(0xff);
+
+  // Two pixels per register
+  __m256i results[2];
+  for (u32 i = 0; i < 2; i++)
+  {
+    const u32 pixel = i * 2;
+    const __m256i a = _mm256_and_si256(LoadPixelsAVX2(inputs.a, pixel), byte_mask);
+    const __m256i b = _mm256_and_si256(LoadPixelsAVX2(inputs.b, pixel), byte_mask);
+    __m256i c = _mm256_and_si256(LoadPixelsAVX2(inputs.c, pixel), byte_mask);
+    const __m256i d =
+        _mm256_srai_epi32(_mm256_slli_epi32(LoadPixelsAVX2(inputs.d, pixel), 21), 21);
+
+    // a * (256 - c) + b * c == (a << 8) + (b - a) * c
+    c = _mm256_add_epi32(c, _mm256_srli_epi32(c, 7));
+    __m256i temp = _mm256_add_epi32(_mm256_slli_epi32(a, 8),
+                                    _mm256_mullo_epi32(_mm256_sub_epi32(b, a), c));
+    temp = _mm256_add_epi32(_mm256_sllv_epi32(temp, lshift), round);
+    temp = _mm256_sub_epi32(_mm256_xor_si256(temp, negate_before), negate_before);
+    temp = _mm256_srai_epi32(temp, 8);
+    temp = _mm256_sub_epi32(_mm256_xor_si256(temp, negate_after), negate_after);
+
+    __m256i result = _mm256_add_epi32(_mm256_sllv_epi32(_mm256_add_epi32(d, bias), lshift), temp);
+    result = _mm256_srav_epi32(result, rshift);
+    results[i] = _mm256_max_epi32(_mm256_min_epi32(result, max), min);
+  }
+
+  // Packing works within each 128-bit half, which leaves the pixels in the order 0, 2, 1, 3. The
+  // results always fit in 16 bits, so it doesn't saturate them.
+  const __m256i packed = _mm256_packs_epi32(results[0], results[1]);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(&output.pixels[0]),
+                     _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+#elif defined(_M_ARM_64)
+
+void CombineNEON(const TevStageCombiner::ColorCombiner& cc,
+                 const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                 QuadColors& output)
+{
+  // Compare mode is rare enough that it isn't worth vectorizing
+  if (cc.bias == TevBias::Compare || ac.bias == TevBias::Compare)
+  {
+    CombineScalar(cc, ac, inputs, output);
+    return;
+  }
+
+  const LaneParams params = GetLaneParams(cc, ac);
+  const int32x4_t lshift = vld1q_s32(params.lshift.data());
+  // Shifting by a negative amount shifts right
+  const int32x4_t rshift = vnegq_s32(vld1q_s32(params.rshift.data()));
+  const int32x4_t round = vld1q_s32(params.round.data());
+  const int32x4_t bias = vld1q_s32(params.bias.data());
+  const int32x4_t negate_before = vld1q_s32(params.negate_before.data());
+  const int32x4_t negate_after = vld1q_s32(params.negate_after.data());
+  const int32x4_t min = vld1q_s32(params.min.data());
+  const int32x4_t max = vld1q_s32(params.max.data());
+  const int32x4_t byte_mask = vdupq_n_s32(0xff);
+
+  for (u32 pixel = 0; pixel < QUAD_SIZE; pixel++)
+  {
+    const int32x4_t a = vandq_s32(vmovl_s16(vld1_s16(inputs.a.pixels[pixel].data())), byte_mask);
+    const int32x4_t b = vandq_s32(vmovl_s16(vld1_s16(inputs.b.pixels[pixel].data())), byte_mask);
+    int32x4_t c = vandq_s32(vmovl_s16(vld1_s16(inputs.c.pixels[pixel].data())), byte_mask);
+    const int32x4_t d =
+        vshrq_n_s32(vshlq_n_s32(vmovl_s16(vld1_s16(inputs.d.pixels[pixel].data())), 21), 21);
+
+    // a * (256 - c) + b * c == (a << 8) + (b - a) * c
+    c = vaddq_s32(c, vshrq_n_s32(c, 7));
+    int32x4_t temp = vmlaq_s32(vshlq_n_s32(a, 8), vsubq_s32(b, a), c);
+    temp = vaddq_s32(vshlq_s32(temp, lshift), round);
+    temp = vsubq_s32(veorq_s32(temp, negate_before), negate_before);
+    temp = vshrq_n_s32(temp, 8);
+    temp = vsubq_s32(veorq_s32(temp, negate_after), negate_after);
+
+    int32x4_t result = vaddq_s32(vshlq_s32(vaddq_s32(d, bias), lshift), temp);
+    result = vshlq_s32(result, rshift);
+    result = vmaxq_s32(vminq_s32(result, max), min);
+
+    // The results always fit in 16 bits
+    vst1_s16(output.pixels[pixel].data(), vmovn_s32(result));
+  }
+}
+
+#endif
+
+CombineFunction GetCombineFunction()
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bAVX2)
+    return CombineAVX2;
+  if (cpu_info.bSSE4_1)
+    return CombineSSE41;
+  return CombineScalar;
+#elif defined(_M_ARM_64)
+  return CombineNEON;
+#else
+  return CombineScalar;
+#endif
+}
+}  // namespace TevCombiner
@@ -0,0 +1,58 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// The color and alpha combiners of a TEV stage, run on the four pixels of a 2x2 quad at once.
+namespace TevCombiner
+{
+constexpr u32 QUAD_SIZE = 4;
+
+// The channels are in the same order as Tev's registers: alpha, blue, green, red
+using PixelColor = std::array<s16, 4>;
+
+struct alignas(32) QuadColors
+{
+  std::array<PixelColor, QUAD_SIZE> pixels;
+};
+
+// The inputs selected for a stage. Like on hardware, only the low 8 bits of a, b and c are used,
+// and the low 11 bits of d, sign extended.
+struct QuadInputs
+{
+  QuadColors a;
+  QuadColors b;
+  QuadColors c;
+  QuadColors d;
+};
+
+// Writes the result of the color combiner to the color channels of output and the result of the
+// alpha combiner to its alpha channel, both clamped. All the functions give the same results.
+using CombineFunction = void (*)(const TevStageCombiner::ColorCombiner& cc,
+                                 const TevStageCombiner::AlphaCombiner& ac,
+                                 const QuadInputs& inputs, QuadColors& output);
+
+void CombineScalar(const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                   QuadColors& output);
+#if defined(_M_X86_64)
+void CombineSSE41(const TevStageCombiner::ColorCombiner& cc,
+                  const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                  QuadColors& output);
+void CombineAVX2(const TevStageCombiner::ColorCombiner& cc,
+                 const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                 QuadColors& output);
+#elif defined(_M_ARM_64)
+void CombineNEON(const TevStageCombiner::ColorCombiner& cc,
+                 const TevStageCombiner::AlphaCombiner& ac, const QuadInputs& inputs,
+                 QuadColors& output);
+#endif
+
+// Returns the fastest function the host supports
+CombineFunction GetCombineFunction();
+}  // namespace TevCombiner
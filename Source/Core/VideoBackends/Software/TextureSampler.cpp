@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <span>
 
 #include "Common/CommonTypes.h"
@@ -16,6 +18,12 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureDecoder.h"
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
@@ -70,7 +78,150 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
+// Blends the four texels around a linear sample location. The weights add up to 128 * 128, which
+// is divided out again with truncation.
+static inline void BilinearFilter(const u8* texel00, const u8* texel10, const u8* texel01,
+                                  const u8* texel11, int fractS, int fractT, u8* sample)
+{
+  const u32 weight00 = (128 - fractS) * (128 - fractT);
+  const u32 weight10 = fractS * (128 - fractT);
+  const u32 weight01 = (128 - fractS) * fractT;
+  const u32 weight11 = fractS * fractT;
+
+#if defined(_M_X86_64)
+  // All weights are at most 128 * 128, so two texels can be multiplied and added with one pmaddwd
+  // by interleaving their channels.
+  u32 raw[4];
+  std::memcpy(&raw[0], texel00, sizeof(u32));
+  std::memcpy(&raw[1], texel10, sizeof(u32));
+  std::memcpy(&raw[2], texel01, sizeof(u32));
+  std::memcpy(&raw[3], texel11, sizeof(u32));
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(raw[0]), _mm_cvtsi32_si128(raw[1])), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(raw[2]), _mm_cvtsi32_si128(raw[3])), zero);
+  const __m128i top_weights = _mm_set1_epi32(static_cast<s32>(weight00 | (weight10 << 16)));
+  const __m128i bottom_weights = _mm_set1_epi32(static_cast<s32>(weight01 | (weight11 << 16)));
+
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(top, top_weights),
+                              _mm_madd_epi16(bottom, bottom_weights));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packs_epi32(sum, sum);
+  sum = _mm_packus_epi16(sum, sum);
+
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(u32));
+#elif defined(_M_ARM_64)
+  const auto widen = [](const u8* texel) {
+    u32 raw;
+    std::memcpy(&raw, texel, sizeof(u32));
+    return vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(raw))));
+  };
+
+  uint32x4_t sum = vmull_n_u16(widen(texel00), static_cast<u16>(weight00));
+  sum = vmlal_n_u16(sum, widen(texel10), static_cast<u16>(weight10));
+  sum = vmlal_n_u16(sum, widen(texel01), static_cast<u16>(weight01));
+  sum = vmlal_n_u16(sum, widen(texel11), static_cast<u16>(weight11));
+
+  const uint16x4_t narrowed = vshrn_n_u32(sum, 14);
+  const uint8x8_t bytes = vmovn_u16(vcombine_u16(narrowed, narrowed));
+
+  const u32 result = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+  std::memcpy(sample, &result, sizeof(u32));
+#else
+  u32 texel[4];
+  SetTexel(texel00, texel, weight00);
+  AddTexel(texel10, texel, weight10);
+  AddTexel(texel01, texel, weight01);
+  AddTexel(texel11, texel, weight11);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
+namespace
+{
+// A mip level of the texture being sampled
+struct TextureLevel
+{
+  TexelCacheKey key;
+  std::span<const u8> image;
+  std::span<const u8> image_odd;
+  std::span<const u8> tlut;
+  int width_minus_1;
+  int height_minus_1;
+};
+}  // namespace
+
+static u32 s_texel_cache_generation = 1;
+
+void InvalidateTexelCaches()
+{
+  s_texel_cache_generation++;
+}
+
+static void DecodeTile(const TextureLevel& level, u32 tile_s, u32 tile_t,
+                       TexelCache::Entry& entry)
+{
+  constexpr int TILE_SIZE = TexelCache::TILE_SIZE;
+
+  const int first_s = tile_s * TILE_SIZE;
+  const int first_t = tile_t * TILE_SIZE;
+  // Texels past the edge of the image are never looked up
+  const int last_s = std::min(first_s + TILE_SIZE - 1, level.width_minus_1);
+  const int last_t = std::min(first_t + TILE_SIZE - 1, level.height_minus_1);
+
+  for (int t = first_t; t <= last_t; t++)
+  {
+    for (int s = first_s; s <= last_s; s++)
+    {
+      u8* texel = entry.texels[(t - first_t) * TILE_SIZE + (s - first_s)];
+
+      if (level.key.rgba8_from_tmem)
+      {
+        TexDecoder_DecodeTexelRGBA8FromTmem(texel, level.image, level.image_odd, s, t,
+                                            level.width_minus_1);
+      }
+      else
+      {
+        TexDecoder_DecodeTexel(texel, level.image, s, t, level.width_minus_1, level.key.format,
+                               level.tlut, level.key.tlut_format);
+      }
+    }
+  }
+}
+
+// Returns the decoded texel at s, t, which must already be wrapped into the image
+static const u8* GetTexel(TexelCache& cache, const TextureLevel& level, int s, int t)
+{
+  const u32 tile_s = static_cast<u32>(s) / TexelCache::TILE_SIZE;
+  const u32 tile_t = static_cast<u32>(t) / TexelCache::TILE_SIZE;
+
+  u32 hash = static_cast<u32>(reinterpret_cast<uintptr_t>(level.image.data()) >> 5);
+  hash ^= tile_s * 0x9e3779b1 ^ tile_t * 0x85ebca77;
+  hash ^= hash >> 15;
+
+  TexelCache::Entry& entry = cache.entries[hash % TexelCache::NUM_ENTRIES];
+  if (entry.generation != s_texel_cache_generation || entry.tile_s != tile_s ||
+      entry.tile_t != tile_t || !(entry.key == level.key))
+  {
+    entry.key = level.key;
+    entry.generation = s_texel_cache_generation;
+    entry.tile_s = static_cast<u16>(tile_s);
+    entry.tile_t = static_cast<u16>(tile_t);
+    DecodeTile(level, tile_s, tile_t, entry);
+  }
+
+  return entry.texels[(t % TexelCache::TILE_SIZE) * TexelCache::TILE_SIZE +
+                      s % TexelCache::TILE_SIZE];
+}
+
+void Sample(TexelCache& cache, s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
   bool mipLinear = false;
@@ -97,10 +248,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
     u8 sampledTex[4];
     u32 texel[4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
+    SampleMip(cache, s, t, baseMip, linear, texmap, sampledTex);
     SetTexel(sampledTex, texel, (16 - lodFract));
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
+    SampleMip(cache, s, t, baseMip + 1, linear, texmap, sampledTex);
     AddTexel(sampledTex, texel, lodFract);
 
     sample[0] = (u8)(texel[0] >> 4);
@@ -111,11 +262,11 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   else
 #endif
   {
-    SampleMip(s, t, baseMip, linear, texmap, sample);
+    SampleMip(cache, s, t, baseMip, linear, texmap, sample);
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+void SampleMip(TexelCache& cache, s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -177,6 +328,22 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     }
   }
 
+  TextureLevel level;
+  level.key.image = image_src.data();
+  level.key.image_odd = image_src_odd.data();
+  level.key.tlut = tlut.data();
+  level.key.width_minus_1 = static_cast<u16>(image_width_minus_1);
+  level.key.height_minus_1 = static_cast<u16>(image_height_minus_1);
+  level.key.format = texfmt;
+  level.key.tlut_format = tlutfmt;
+  level.key.rgba8_from_tmem =
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed;
+  level.image = image_src;
+  level.image_odd = image_src_odd;
+  level.tlut = tlut;
+  level.width_minus_1 = image_width_minus_1;
+  level.height_minus_1 = image_height_minus_1;
+
   if (linear)
   {
     // offset linear sampling
@@ -194,55 +361,15 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageT, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1, imageT,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1,
-                                          imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    BilinearFilter(GetTexel(cache, level, imageS, imageT),
+                   GetTexel(cache, level, imageSPlus1, imageT),
+                   GetTexel(cache, level, imageS, imageTPlus1),
+                   GetTexel(cache, level, imageSPlus1, imageTPlus1), fractS, fractT, sample);
   }
   else
   {
@@ -254,16 +381,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sample, image_src, imageS, imageT, image_width_minus_1, texfmt, tlut,
-                             tlutfmt);
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-    }
+    std::memcpy(sample, GetTexel(cache, level, imageS, imageT), 4);
   }
 }
 }  // namespace TextureSampler
@@ -3,13 +3,57 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 
+enum class TextureFormat;
+enum class TLUTFormat;
+
 namespace TextureSampler
 {
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
+// Identifies the decoded texels of a texture's mip level
+struct TexelCacheKey
+{
+  const u8* image = nullptr;
+  const u8* image_odd = nullptr;
+  const u8* tlut = nullptr;
+  u16 width_minus_1 = 0;
+  // Tiles at the bottom edge only decode the rows within the texture
+  u16 height_minus_1 = 0;
+  TextureFormat format{};
+  TLUTFormat tlut_format{};
+  bool rgba8_from_tmem = false;
+
+  bool operator==(const TexelCacheKey&) const = default;
+};
+
+// Decoded texels of the textures sampled by one rasterizer thread, in tiles of 4x4 texels, so the
+// four taps of a bilinear sample and neighbouring pixels don't decode the same texels again.
+struct TexelCache
+{
+  static constexpr u32 TILE_SIZE = 4;
+  static constexpr u32 NUM_ENTRIES = 512;
+
+  struct Entry
+  {
+    TexelCacheKey key;
+    u32 generation = 0;
+    u16 tile_s = 0;
+    u16 tile_t = 0;
+    u8 texels[TILE_SIZE * TILE_SIZE][4]{};
+  };
+
+  std::array<Entry, NUM_ENTRIES> entries{};
+};
+
+// Marks the contents of all the texel caches as stale. Must be called whenever texture or TLUT
+// data may have changed, and not while the rasterizer threads are drawing.
+void InvalidateTexelCaches();
+
+void Sample(TexelCache& cache, s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
+void SampleMip(TexelCache& cache, s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
 
 enum
 {
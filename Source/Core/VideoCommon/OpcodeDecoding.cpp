@@ -24,6 +24,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -260,6 +261,9 @@ public:
 template <bool is_preprocess>
 u8* RunFifo(DataReader src, u32* cycles)
 {
+  // Preprocessing runs on the CPU thread alongside the GPU thread, so only the latter is timed
+  StageTimings::ScopedTimer timer(StageTimings::Stage::OpcodeDecoding, !is_preprocess);
+
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
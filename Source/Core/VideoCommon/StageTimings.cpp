@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/StageTimings.h"
+
+#include <array>
+#include <atomic>
+
+namespace StageTimings
+{
+namespace
+{
+struct Counters
+{
+  std::atomic<u64> calls{0};
+  std::atomic<s64> nanoseconds{0};
+};
+
+std::atomic<bool> s_enabled{false};
+std::array<Counters, static_cast<size_t>(Stage::Count)> s_counters;
+
+// The innermost running timer of this thread
+thread_local ScopedTimer* s_current_timer = nullptr;
+}  // namespace
+
+void SetEnabled(bool enabled)
+{
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+void Reset()
+{
+  for (Counters& counters : s_counters)
+  {
+    counters.calls.store(0, std::memory_order_relaxed);
+    counters.nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Add(Stage stage, std::chrono::nanoseconds time)
+{
+  Counters& counters = s_counters[static_cast<size_t>(stage)];
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.nanoseconds.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+Totals GetTotals(Stage stage)
+{
+  const Counters& counters = s_counters[static_cast<size_t>(stage)];
+  return {counters.calls.load(std::memory_order_relaxed),
+          std::chrono::nanoseconds(counters.nanoseconds.load(std::memory_order_relaxed))};
+}
+
+void ScopedTimer::Begin()
+{
+  m_parent = s_current_timer;
+  s_current_timer = this;
+  m_start = std::chrono::steady_clock::now();
+}
+
+void ScopedTimer::End()
+{
+  const std::chrono::nanoseconds time = std::chrono::steady_clock::now() - m_start;
+  Add(m_stage, time - m_nested_time);
+
+  if (m_parent)
+    m_parent->m_nested_time += time;
+  s_current_timer = m_parent;
+}
+}  // namespace StageTimings
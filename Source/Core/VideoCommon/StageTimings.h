@@ -0,0 +1,74 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+
+// Host time spent in the stages of the video frontend, for benchmarking. Nothing is recorded
+// unless timing has been enabled, so the timers can stay in place in normal builds.
+//
+// Timers nest: the time of a timer running inside another one is only added to the inner stage,
+// so the totals of the stages can be added up.
+namespace StageTimings
+{
+enum class Stage
+{
+  // Parsing the FIFO and display lists, and loading BP/CP/XF registers
+  OpcodeDecoding,
+  VertexLoading,
+  // Looking up and decoding textures in the texture cache. The software renderer decodes texels
+  // while rasterizing instead.
+  TextureDecoding,
+  ShaderLookup,
+  // Drawing a batch in the backend, which is where the software renderer rasterizes
+  Drawing,
+  Count,
+};
+
+struct Totals
+{
+  u64 calls = 0;
+  std::chrono::nanoseconds time{};
+};
+
+void SetEnabled(bool enabled);
+bool IsEnabled();
+void Reset();
+
+void Add(Stage stage, std::chrono::nanoseconds time);
+Totals GetTotals(Stage stage);
+
+// Adds the time spent in its scope, minus the time of any timers nested in it, to a stage
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Stage stage, bool active = true)
+      : m_stage(stage), m_enabled(active && IsEnabled())
+  {
+    if (m_enabled)
+      Begin();
+  }
+
+  ~ScopedTimer()
+  {
+    if (m_enabled)
+      End();
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  void Begin();
+  void End();
+
+  Stage m_stage;
+  bool m_enabled;
+  ScopedTimer* m_parent = nullptr;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::nanoseconds m_nested_time{};
+};
+}  // namespace StageTimings
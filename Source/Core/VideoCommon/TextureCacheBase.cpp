@@ -47,6 +47,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureConversionShader.h"
@@ -1245,6 +1246,8 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  StageTimings::ScopedTimer timer(StageTimings::Stage::TextureDecoding);
+
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
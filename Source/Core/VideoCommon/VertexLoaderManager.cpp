@@ -27,6 +27,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -427,14 +428,18 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
-
-    if (can_cpu_cull && !cullall)
     {
-      if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+      StageTimings::ScopedTimer timer(StageTimings::Stage::VertexLoading);
+
+      count = loader->RunVertices(src, dst.GetPointer(), count);
+
+      if (can_cpu_cull && !cullall)
       {
-        DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
-        memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
+        if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+        {
+          DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
+          memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
+        }
       }
     }
 
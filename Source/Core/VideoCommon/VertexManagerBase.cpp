@@ -33,6 +33,7 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/StageTimings.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureInfo.h"
@@ -879,6 +880,8 @@ void VertexManagerBase::UpdatePipelineObject()
   if (!m_pipeline_config_changed)
     return;
 
+  StageTimings::ScopedTimer timer(StageTimings::Stage::ShaderLookup);
+
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
 
@@ -1103,6 +1106,7 @@ void VertexManagerBase::RenderDrawCall(
     base_vertex <<= 2;
   }
 
+  StageTimings::ScopedTimer timer(StageTimings::Stage::Drawing);
   DrawCurrentBatch(base_index, m_index_generator.GetIndexLen(), base_vertex);
 }
 
@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/MsgHandler.h"
+#include "Core/HW/DVD/AMCommandTrace.h"
+#include "Core/HW/DVD/AMMediaboard.h"
+
+#include <gtest/gtest.h>
+
+using namespace AMMediaboard;
+
+namespace
+{
+constexpr u32 READ = 0xA8000000;
+constexpr u32 WRITE = 0xAA000000;
+constexpr u32 FIRMWARE_MEMORY = 0x00400000;
+
+// Runs the media board through the trace replay path, which needs no emulated console
+class AMMediaboardTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // The test writes the firmware it reads, so a missing segaboot.gcm doesn't matter here
+    Common::SetEnableAlert(false);
+    InitReplay(0);
+    Common::SetEnableAlert(true);
+  }
+
+  void TearDown() override { ShutdownReplay(); }
+
+  // With the firmware mapped, as after entering test mode
+  static u32 Replay(u32 command, u32 offset, std::array<u8, 0x20>& data)
+  {
+    TraceRecord record{};
+    record.kind = TraceRecordKind::Command;
+    record.command = command;
+    record.offset = offset;
+    record.length = static_cast<u32>(data.size());
+    record.flags = TRACE_TEST_MODE;
+    return ReplayCommand(record, data.data());
+  }
+
+  static void WriteFirmware(u32 firmware_offset, u8 value)
+  {
+    std::array<u8, 0x20> data;
+    data.fill(value);
+    Replay(WRITE, FIRMWARE_MEMORY + firmware_offset, data);
+  }
+
+  static u8 ReadFirmware(u32 offset)
+  {
+    std::array<u8, 0x20> data{};
+    EXPECT_EQ(Replay(READ, offset, data), 0u);
+    return data[0];
+  }
+};
+}  // namespace
+
+TEST_F(AMMediaboardTest, SegaBootFirmwareReads)
+{
+  WriteFirmware(0x00000420, 0x11);
+  WriteFirmware(0x00000440, 0x22);
+  WriteFirmware(0x00100460, 0x33);
+
+  EXPECT_EQ(ReadFirmware(0x00000420), 0x11);
+  EXPECT_EQ(ReadFirmware(0x00100460), 0x33);
+
+  // Reading 0x00100440 is how SegaBoot is recognized, and that read is adjusted already
+  EXPECT_EQ(ReadFirmware(0x00100440), 0x11);
+  EXPECT_EQ(ReadFirmware(0x00100460), 0x22);
+
+  // Only offsets with bit 20 set are adjusted
+  EXPECT_EQ(ReadFirmware(0x00000420), 0x11);
+}
+
+TEST_F(AMMediaboardTest, StatusReadWithFirmwareMapped)
+{
+  // Recognize SegaBoot first, the status registers must not go through its firmware adjustment
+  std::array<u8, 0x20> data{};
+  Replay(READ, 0x00100440, data);
+
+  // An unhandled read raises a panic alert, which fails the test
+  data.fill(0xFF);
+  EXPECT_EQ(Replay(READ, 0x80000000, data), 0u);
+  const u16 status = 0x0100;
+  EXPECT_EQ(std::memcmp(data.data(), &status, sizeof(status)), 0);
+
+  data.fill(0xFF);
+  EXPECT_EQ(Replay(READ, 0x80000020, data), 0u);
+  EXPECT_EQ(data, (std::array<u8, 0x20>{}));
+}
@@ -0,0 +1,209 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DVD/AMNetworkTransport.h"
+#include "Core/HW/DVD/AMVirtualLAN.h"
+#include "Core/IOS/Network/Socket.h"
+
+#include <gtest/gtest.h>
+
+using namespace AMMediaboard;
+
+namespace
+{
+// Kept apart from the switch real instances use
+constexpr char SWITCH_NAME[] = "DolphinTriforceVirtualLANTest";
+constexpr u16 SERVER_PORT = 50000;
+
+sockaddr_in MakeAddress(const char* ip, u16 port)
+{
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = inet_addr(ip);
+  return addr;
+}
+
+// Two instances on the same switch, as two Dolphin processes would be
+class VirtualLANTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_server = CreateVirtualLANTransport("10.0.0.1", SWITCH_NAME);
+    m_client = CreateVirtualLANTransport("10.0.0.2", SWITCH_NAME);
+    ASSERT_NE(m_server, nullptr);
+    ASSERT_NE(m_client, nullptr);
+
+    m_listener = m_server->Socket(AF_INET, SOCK_STREAM);
+    ASSERT_NE(m_listener, INVALID_TRANSPORT_HANDLE);
+    ASSERT_EQ(m_server->Bind(m_listener, MakeAddress("10.0.0.1", SERVER_PORT)), 0);
+    ASSERT_EQ(m_server->Listen(m_listener, 1), 0);
+  }
+
+  // Connects the client and accepts the connection on the server
+  void Connect()
+  {
+    m_client_socket = m_client->Socket(AF_INET, SOCK_STREAM);
+    ASSERT_NE(m_client_socket, INVALID_TRANSPORT_HANDLE);
+    ASSERT_EQ(m_client->Connect(m_client_socket, MakeAddress("10.0.0.1", SERVER_PORT)).status,
+              TransportStatus::Success);
+
+    sockaddr_in peer{};
+    const TransportResult accepted = m_server->Accept(m_listener, &peer);
+    ASSERT_EQ(accepted.status, TransportStatus::Success);
+    EXPECT_EQ(peer.sin_addr.s_addr, inet_addr("10.0.0.2"));
+    m_server_socket = accepted.value;
+  }
+
+  std::unique_ptr<NetworkTransport> m_server;
+  std::unique_ptr<NetworkTransport> m_client;
+  TransportHandle m_listener = INVALID_TRANSPORT_HANDLE;
+  TransportHandle m_server_socket = INVALID_TRANSPORT_HANDLE;
+  TransportHandle m_client_socket = INVALID_TRANSPORT_HANDLE;
+};
+}  // namespace
+
+TEST_F(VirtualLANTest, SendAndReceive)
+{
+  ASSERT_NO_FATAL_FAILURE(Connect());
+
+  const std::array<u8, 4> request = {1, 2, 3, 4};
+  EXPECT_EQ(m_client->Send(m_client_socket, request.data(), request.size()).value, 4);
+
+  std::array<u8, 8> received{};
+  const TransportResult result = m_server->Recv(m_server_socket, received.data(), 8);
+  ASSERT_EQ(result.status, TransportStatus::Success);
+  ASSERT_EQ(result.value, 4);
+  EXPECT_TRUE(std::equal(request.begin(), request.end(), received.begin()));
+
+  // Nothing left to read
+  EXPECT_EQ(m_server->Recv(m_server_socket, received.data(), 8).status,
+            TransportStatus::WouldBlock);
+
+  const std::array<u8, 2> reply = {5, 6};
+  EXPECT_EQ(m_server->Send(m_server_socket, reply.data(), reply.size()).value, 2);
+  EXPECT_EQ(m_client->Recv(m_client_socket, received.data(), 8).value, 2);
+  EXPECT_EQ(received[0], 5);
+  EXPECT_EQ(received[1], 6);
+}
+
+TEST_F(VirtualLANTest, ConnectionRefused)
+{
+  const TransportHandle socket = m_client->Socket(AF_INET, SOCK_STREAM);
+  EXPECT_EQ(m_client->Connect(socket, MakeAddress("10.0.0.1", SERVER_PORT + 1)).status,
+            TransportStatus::Failure);
+  EXPECT_EQ(m_client->GetLastError(), ECONNREFUSED);
+}
+
+TEST_F(VirtualLANTest, CloseEndsTheStream)
+{
+  ASSERT_NO_FATAL_FAILURE(Connect());
+
+  const u8 byte = 42;
+  m_client->Send(m_client_socket, &byte, 1);
+  EXPECT_EQ(m_client->Close(m_client_socket), 0);
+
+  // What was sent before closing can still be read, then the stream ends
+  u8 received = 0;
+  EXPECT_EQ(m_server->Recv(m_server_socket, &received, 1).value, 1);
+  EXPECT_EQ(received, byte);
+  const TransportResult result = m_server->Recv(m_server_socket, &received, 1);
+  EXPECT_EQ(result.status, TransportStatus::Success);
+  EXPECT_EQ(result.value, 0);
+
+  EXPECT_EQ(m_server->Send(m_server_socket, &byte, 1).status, TransportStatus::Failure);
+}
+
+TEST_F(VirtualLANTest, OtherInstancesHandlesAreNotReady)
+{
+  ASSERT_NO_FATAL_FAILURE(Connect());
+
+  const u8 byte = 0;
+  m_client->Send(m_client_socket, &byte, 1);
+
+  const u32 events = TRANSPORT_READABLE | TRANSPORT_WRITABLE;
+  EXPECT_EQ(m_server->GetReadiness(m_server_socket, events), events);
+  EXPECT_EQ(m_client->GetReadiness(m_server_socket, events), 0u);
+  EXPECT_EQ(m_client->Recv(m_server_socket, nullptr, 0).status, TransportStatus::Failure);
+}
+
+TEST_F(VirtualLANTest, WaitWakesUpOnData)
+{
+  ASSERT_NO_FATAL_FAILURE(Connect());
+
+  std::thread sender([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const u8 byte = 1;
+    m_client->Send(m_client_socket, &byte, 1);
+  });
+
+  const std::array<TransportWaitEntry, 1> entries = {{{m_server_socket, TRANSPORT_READABLE}}};
+  const auto start = std::chrono::steady_clock::now();
+  m_server->Wait(entries, std::chrono::seconds(10));
+  const auto waited = std::chrono::steady_clock::now() - start;
+  sender.join();
+
+  EXPECT_EQ(m_server->GetReadiness(m_server_socket, TRANSPORT_READABLE), TRANSPORT_READABLE);
+  EXPECT_LT(waited, std::chrono::seconds(5));
+}
+
+TEST_F(VirtualLANTest, WaitTimesOut)
+{
+  ASSERT_NO_FATAL_FAILURE(Connect());
+
+  const std::array<TransportWaitEntry, 1> entries = {{{m_server_socket, TRANSPORT_READABLE}}};
+  const auto start = std::chrono::steady_clock::now();
+  m_server->Wait(entries, std::chrono::milliseconds(20));
+
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+  EXPECT_EQ(m_server->GetReadiness(m_server_socket, TRANSPORT_READABLE), 0u);
+}
+
+#ifndef _WIN32
+// Named shared memory survives its users on POSIX unless someone removes it
+static bool SwitchExists(const char* name)
+{
+  const int fd = shm_open((std::string("/") + name).c_str(), O_RDONLY, 0);
+  if (fd == -1)
+    return false;
+  close(fd);
+  return true;
+}
+
+TEST(VirtualLANSwitchTest, LastInstanceRemovesTheSwitch)
+{
+  constexpr char NAME[] = "DolphinTriforceVirtualLANUnlinkTest";
+
+  auto first = CreateVirtualLANTransport("10.0.0.1", NAME);
+  auto second = CreateVirtualLANTransport("10.0.0.2", NAME);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_TRUE(SwitchExists(NAME));
+
+  first.reset();
+  EXPECT_TRUE(SwitchExists(NAME));
+  second.reset();
+  EXPECT_FALSE(SwitchExists(NAME));
+
+  // The next instance sets up a new switch
+  auto third = CreateVirtualLANTransport("10.0.0.3", NAME);
+  ASSERT_NE(third, nullptr);
+  EXPECT_NE(third->Socket(AF_INET, SOCK_STREAM), INVALID_TRANSPORT_HANDLE);
+  third.reset();
+  EXPECT_FALSE(SwitchExists(NAME));
+}
+#endif
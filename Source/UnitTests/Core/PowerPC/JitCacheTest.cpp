@@ -0,0 +1,213 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class JitCacheFakeJit : public JitBase
+{
+public:
+  explicit JitCacheFakeJit(Core::System& system) : JitBase(system) {}
+
+  // CPUCoreBase methods
+  void Init() override {}
+  void Shutdown() override {}
+  void ClearCache() override {}
+  void Run() override {}
+  void SingleStep() override {}
+  const char* GetName() const override { return nullptr; }
+  // JitBase methods
+  JitBaseBlockCache* GetBlockCache() override { return nullptr; }
+  void Jit(u32 em_address) override {}
+  const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  bool HandleFault(uintptr_t access_address, SContext* ctx) override { return false; }
+};
+
+class FakeBlockCache : public JitBaseBlockCache
+{
+public:
+  using JitBaseBlockCache::JitBaseBlockCache;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override {}
+};
+
+constexpr CPUEmuFeatureFlags NO_FLAGS = static_cast<CPUEmuFeatureFlags>(0);
+constexpr u32 CODE_BASE = 0x80003000;
+constexpr u32 BLOCK_INSTRUCTIONS = 16;
+
+// Compiles a fake block covering BLOCK_INSTRUCTIONS instructions at address, which exits to the
+// block right after it
+JitBlock* AddBlock(JitBaseBlockCache& cache, u32 address)
+{
+  JitBlock* block = cache.AllocateBlock(address);
+  JitBlock::LinkData& exit = block->linkData.emplace_back();
+  exit.exitPtrs = nullptr;
+  exit.exitAddress = address + BLOCK_INSTRUCTIONS * 4;
+  exit.linkStatus = false;
+  exit.call = false;
+
+  std::set<u32> physical_addresses;
+  for (u32 i = 0; i < BLOCK_INSTRUCTIONS; ++i)
+    physical_addresses.insert(address + i * 4);
+  cache.FinalizeBlock(*block, true, physical_addresses);
+  return block;
+}
+}  // namespace
+
+class JitCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Core::DeclareAsCPUThread();
+    m_jit = std::make_unique<JitCacheFakeJit>(Core::System::GetInstance());
+    m_cache = std::make_unique<FakeBlockCache>(*m_jit);
+    m_cache->Clear();
+  }
+
+  void TearDown() override
+  {
+    m_cache->Clear();
+    m_cache.reset();
+    m_jit.reset();
+    Core::UndeclareAsCPUThread();
+  }
+
+  bool HasBlock(u32 address)
+  {
+    return m_cache->GetBlockFromStartAddress(address, NO_FLAGS) != nullptr;
+  }
+
+  std::unique_ptr<JitCacheFakeJit> m_jit;
+  std::unique_ptr<FakeBlockCache> m_cache;
+};
+
+TEST_F(JitCacheTest, EraseOnlyOverlappingBlocks)
+{
+  constexpr u32 block_size = BLOCK_INSTRUCTIONS * 4;
+  for (u32 i = 0; i < 256; ++i)
+    AddBlock(*m_cache, CODE_BASE + i * block_size);
+
+  // Invalidate the last instruction of block 99 and the first of block 100
+  m_cache->ErasePhysicalRange(CODE_BASE + 100 * block_size - 4, 8);
+
+  for (u32 i = 0; i < 256; ++i)
+  {
+    const bool erased = i == 99 || i == 100;
+    EXPECT_EQ(HasBlock(CODE_BASE + i * block_size), !erased) << "block " << i;
+  }
+
+  // Erased blocks are reused, and the new ones are found again
+  AddBlock(*m_cache, CODE_BASE + 99 * block_size);
+  EXPECT_TRUE(HasBlock(CODE_BASE + 99 * block_size));
+  EXPECT_FALSE(HasBlock(CODE_BASE + 100 * block_size));
+
+  // A range crossing page boundaries takes out every block in it
+  m_cache->ErasePhysicalRange(CODE_BASE, 128 * block_size);
+  for (u32 i = 0; i < 256; ++i)
+    EXPECT_EQ(HasBlock(CODE_BASE + i * block_size), i >= 128) << "block " << i;
+}
+
+TEST_F(JitCacheTest, BlocksDifferingOnlyInFlags)
+{
+  JitBlock* block = AddBlock(*m_cache, CODE_BASE);
+  m_jit->m_ppc_state.feature_flags = FEATURE_FLAG_PERFMON;
+  JitBlock* perfmon_block = AddBlock(*m_cache, CODE_BASE);
+  m_jit->m_ppc_state.feature_flags = NO_FLAGS;
+
+  EXPECT_EQ(m_cache->GetBlockFromStartAddress(CODE_BASE, NO_FLAGS), block);
+  EXPECT_EQ(m_cache->GetBlockFromStartAddress(CODE_BASE, FEATURE_FLAG_PERFMON), perfmon_block);
+
+  m_cache->ErasePhysicalRange(CODE_BASE, 4);
+  EXPECT_EQ(m_cache->GetBlockFromStartAddress(CODE_BASE, NO_FLAGS), nullptr);
+  EXPECT_EQ(m_cache->GetBlockFromStartAddress(CODE_BASE, FEATURE_FLAG_PERFMON), nullptr);
+}
+
+TEST_F(JitCacheTest, InvalidateCacheLinesAndRecompile)
+{
+  constexpr u32 block_count = 0x400;
+  constexpr u32 block_size = BLOCK_INSTRUCTIONS * 4;
+
+  // Erased blocks leave holes in the cache that the next round has to reuse
+  for (int round = 0; round < 4; ++round)
+  {
+    for (u32 i = 0; i < block_count; ++i)
+      ASSERT_NE(AddBlock(*m_cache, CODE_BASE + i * block_size), nullptr);
+
+    // Invalidate one cache line at a time, as dcbi/icbi do, across all of the code
+    for (u32 i = 0; i < block_count; ++i)
+    {
+      const u32 block_address = CODE_BASE + i * block_size;
+      m_cache->ErasePhysicalRange(block_address, 32);
+
+      ASSERT_FALSE(HasBlock(block_address)) << "block " << i;
+      if (i + 1 < block_count)
+      {
+        ASSERT_TRUE(HasBlock(block_address + block_size)) << "block " << i + 1;
+      }
+
+      for (u32 offset = 32; offset < block_size; offset += 32)
+        m_cache->ErasePhysicalRange(block_address + offset, 32);
+    }
+
+    for (u32 i = 0; i < block_count; ++i)
+      ASSERT_FALSE(HasBlock(CODE_BASE + i * block_size)) << "block " << i;
+  }
+}
+
+// A benchmark rather than a test, run it with --gtest_also_run_disabled_tests
+TEST_F(JitCacheTest, DISABLED_InvalidationThroughput)
+{
+  constexpr u32 block_count = 0x4000;
+  constexpr u32 block_size = BLOCK_INSTRUCTIONS * 4;
+  constexpr int rounds = 16;
+
+  using Clock = std::chrono::steady_clock;
+  Clock::duration compile_time{};
+  Clock::duration invalidate_time{};
+  u64 invalidations = 0;
+
+  for (int round = 0; round < rounds; ++round)
+  {
+    auto start = Clock::now();
+    for (u32 i = 0; i < block_count; ++i)
+      AddBlock(*m_cache, CODE_BASE + i * block_size);
+    compile_time += Clock::now() - start;
+
+    // Invalidate one cache line at a time, as dcbi/icbi do, across all of the code
+    start = Clock::now();
+    for (u32 address = CODE_BASE; address < CODE_BASE + block_count * block_size; address += 32)
+    {
+      m_cache->ErasePhysicalRange(address, 32);
+      ++invalidations;
+    }
+    invalidate_time += Clock::now() - start;
+
+    ASSERT_FALSE(HasBlock(CODE_BASE));
+  }
+
+  const auto ns = [](Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  };
+
+  fmt::print("jit cache timing ({} blocks, {} rounds):\n", block_count, rounds);
+  fmt::print("allocate+finalize      {} ns/block\n", ns(compile_time) / (block_count * rounds));
+  fmt::print("invalidate cache line  {} ns/line\n", ns(invalidate_time) / invalidations);
+}
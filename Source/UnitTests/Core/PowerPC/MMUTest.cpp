@@ -0,0 +1,200 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+using namespace PowerPC;
+
+namespace
+{
+// The smallest page table, 64 KiB
+constexpr u32 PAGE_TABLE = 0x00100000;
+constexpr u32 VSID = 0x123;
+
+constexpr u32 PAGE_A = 0x00010000;
+// In the same tlbie congruence class as PAGE_A, but in another soft TLB entry
+constexpr u32 PAGE_B = PAGE_A + ((HW_PAGE_INDEX_MASK + 1) << HW_PAGE_INDEX_SHIFT);
+// In the congruence class after PAGE_A
+constexpr u32 PAGE_C = PAGE_A + HW_PAGE_SIZE;
+
+class MMUTest : public testing::Test
+{
+protected:
+  MMUTest()
+      : m_memory(Core::System::GetInstance().GetMemory()),
+        m_ppc_state(Core::System::GetInstance().GetPPCState()),
+        m_mmu(Core::System::GetInstance().GetMMU())
+  {
+  }
+
+  void SetUp() override
+  {
+    m_memory.Init();
+
+    m_ppc_state.spr[SPR_SDR] = PAGE_TABLE;
+    m_mmu.SDRUpdated();
+    m_ppc_state.SetSR(0, VSID);
+    m_ppc_state.SetSR(1, VSID + 1);
+    m_mmu.SRUpdated();
+    // Like tlbia, the hardware TLB outlives the page table of the previous test
+    for (u32 i = 0; i <= HW_PAGE_INDEX_MASK; ++i)
+      m_mmu.InvalidateTLBEntry(i << HW_PAGE_INDEX_SHIFT);
+
+    m_ppc_state.msr.DR = 1;
+  }
+
+  void TearDown() override
+  {
+    m_ppc_state.msr.DR = 0;
+    m_ppc_state.SetSR(0, 0);
+    m_ppc_state.SetSR(1, 0);
+    m_ppc_state.spr[SPR_SDR] = 0;
+    m_mmu.SDRUpdated();
+
+    m_memory.Shutdown();
+  }
+
+  // Adds a read/write page table entry, using the primary hash
+  void MapPage(u32 effective_address, u32 physical_address)
+  {
+    const u32 vsid = UReg_SR{m_ppc_state.sr[effective_address >> 28]}.VSID;
+    const u32 page_index = (effective_address >> HW_PAGE_INDEX_SHIFT) & 0xFFFF;
+
+    UPTE_Lo pte1;
+    pte1.VSID = vsid;
+    pte1.API = page_index >> 10;
+    pte1.V = 1;
+
+    UPTE_Hi pte2;
+    pte2.RPN = physical_address >> HW_PAGE_INDEX_SHIFT;
+    pte2.PP = 2;
+
+    u32 pteg_addr = (((vsid ^ page_index) & 0x3ff) << 6) | PAGE_TABLE;
+    while (m_memory.Read_U32(pteg_addr) != 0)
+      pteg_addr += 8;
+
+    m_memory.Write_U32(pte1.Hex, pteg_addr);
+    m_memory.Write_U32(pte2.Hex, pteg_addr + 4);
+  }
+
+  // Fills both soft TLBs through the page table
+  void Access(u32 effective_address)
+  {
+    m_mmu.Read_U32(effective_address);
+    m_mmu.Write_U32(0, effective_address);
+  }
+
+  bool Cached(u32 effective_address) const
+  {
+    return m_mmu.LookupSoftTLB(effective_address, 32, false) != nullptr &&
+           m_mmu.LookupSoftTLB(effective_address, 32, true) != nullptr;
+  }
+
+  Memory::MemoryManager& m_memory;
+  PowerPCState& m_ppc_state;
+  MMU& m_mmu;
+};
+}  // namespace
+
+TEST_F(MMUTest, SoftTLBFillOnPageTableRead)
+{
+  MapPage(PAGE_A, 0x00200000);
+  m_memory.Write_U32(0x12345678, 0x00200004);
+
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 4, 32, false), nullptr);
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_A + 4), 0x12345678u);
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 4, 32, false), m_memory.GetRAM() + 0x00200004);
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 0xFFC, 32, false), m_memory.GetRAM() + 0x00200FFC);
+
+  // A read doesn't set the C bit, so writes still have to go through the MMU
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 4, 32, true), nullptr);
+}
+
+TEST_F(MMUTest, SoftTLBFillOnPageTableWrite)
+{
+  MapPage(PAGE_A, 0x00200000);
+
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 8, 32, true), nullptr);
+  m_mmu.Write_U32(0xCAFEBABE, PAGE_A + 8);
+  EXPECT_EQ(m_memory.Read_U32(0x00200008), 0xCAFEBABEu);
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 8, 32, true), m_memory.GetRAM() + 0x00200008);
+
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 8, 32, false), nullptr);
+}
+
+TEST_F(MMUTest, SoftTLBMisalignedAccessMisses)
+{
+  MapPage(PAGE_A, 0x00200000);
+  m_mmu.Read_U32(PAGE_A);
+
+  EXPECT_NE(m_mmu.LookupSoftTLB(PAGE_A + 1, 8, false), nullptr);
+  EXPECT_NE(m_mmu.LookupSoftTLB(PAGE_A + 2, 16, false), nullptr);
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 2, 32, false), nullptr);
+  EXPECT_NE(m_mmu.LookupSoftTLB(PAGE_A + 8, 64, false), nullptr);
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 4, 64, false), nullptr);
+
+  // This one would cross into the next page
+  EXPECT_EQ(m_mmu.LookupSoftTLB(PAGE_A + 0xFFE, 32, false), nullptr);
+}
+
+TEST_F(MMUTest, SoftTLBTlbieInvalidatesCongruenceClass)
+{
+  MapPage(PAGE_A, 0x00200000);
+  MapPage(PAGE_B, 0x00201000);
+  MapPage(PAGE_C, 0x00202000);
+  Access(PAGE_A);
+  Access(PAGE_B);
+  Access(PAGE_C);
+  ASSERT_TRUE(Cached(PAGE_A));
+  ASSERT_TRUE(Cached(PAGE_B));
+  ASSERT_TRUE(Cached(PAGE_C));
+
+  // The page in the other segment isn't even mapped
+  m_mmu.InvalidateTLBEntry(0x10000000 | PAGE_A);
+
+  EXPECT_FALSE(Cached(PAGE_A));
+  EXPECT_FALSE(Cached(PAGE_B));
+  EXPECT_TRUE(Cached(PAGE_C));
+}
+
+TEST_F(MMUTest, SoftTLBInvalidatedOnSRUpdate)
+{
+  MapPage(PAGE_A, 0x00200000);
+  Access(PAGE_A);
+  ASSERT_TRUE(Cached(PAGE_A));
+
+  m_ppc_state.SetSR(0, VSID + 2);
+  m_mmu.SRUpdated();
+
+  EXPECT_FALSE(Cached(PAGE_A));
+}
+
+TEST_F(MMUTest, SoftTLBInvalidatedOnSDRUpdate)
+{
+  MapPage(PAGE_A, 0x00200000);
+  Access(PAGE_A);
+  ASSERT_TRUE(Cached(PAGE_A));
+
+  m_ppc_state.spr[SPR_SDR] = PAGE_TABLE + 0x00010000;
+  m_mmu.SDRUpdated();
+
+  EXPECT_FALSE(Cached(PAGE_A));
+}
+
+TEST_F(MMUTest, SoftTLBInvalidatedOnDBATUpdate)
+{
+  MapPage(PAGE_A, 0x00200000);
+  Access(PAGE_A);
+  ASSERT_TRUE(Cached(PAGE_A));
+
+  m_mmu.DBATUpdated();
+
+  EXPECT_FALSE(Cached(PAGE_A));
+}
@@ -0,0 +1,140 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TevCombiner.h"
+#include "VideoCommon/BPMemory.h"
+
+namespace
+{
+struct CombineImplementation
+{
+  const char* name;
+  TevCombiner::CombineFunction function;
+};
+
+std::vector<CombineImplementation> GetSIMDImplementations()
+{
+  std::vector<CombineImplementation> implementations;
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    implementations.push_back({"SSE4.1", TevCombiner::CombineSSE41});
+  if (cpu_info.bAVX2)
+    implementations.push_back({"AVX2", TevCombiner::CombineAVX2});
+#elif defined(_M_ARM_64)
+  implementations.push_back({"NEON", TevCombiner::CombineNEON});
+#endif
+  return implementations;
+}
+
+void ExpectSameAsScalar(const std::vector<CombineImplementation>& implementations,
+                        const TevStageCombiner::ColorCombiner& cc,
+                        const TevStageCombiner::AlphaCombiner& ac,
+                        const TevCombiner::QuadInputs& inputs)
+{
+  TevCombiner::QuadColors expected;
+  TevCombiner::CombineScalar(cc, ac, inputs, expected);
+
+  for (const CombineImplementation& implementation : implementations)
+  {
+    TevCombiner::QuadColors actual;
+    implementation.function(cc, ac, inputs, actual);
+
+    for (u32 pixel = 0; pixel < TevCombiner::QUAD_SIZE; pixel++)
+    {
+      EXPECT_EQ(expected.pixels[pixel], actual.pixels[pixel])
+          << implementation.name << " pixel " << pixel << " cc " << std::hex << cc.hex << " ac "
+          << ac.hex;
+    }
+  }
+}
+}  // namespace
+
+TEST(TevCombiner, RandomStages)
+{
+  const std::vector<CombineImplementation> implementations = GetSIMDImplementations();
+  if (implementations.empty())
+    GTEST_SKIP() << "No SIMD implementation is supported by the host";
+
+  std::mt19937 rng(0x7e7);
+  std::uniform_int_distribution<u32> stage_dist(0, 0xffffff);
+  // The range of the TEV registers; the other inputs are within 0-255
+  std::uniform_int_distribution<int> input_dist(-1024, 1023);
+
+  for (int i = 0; i < 100000; i++)
+  {
+    TevStageCombiner::ColorCombiner cc;
+    TevStageCombiner::AlphaCombiner ac;
+    cc.hex = stage_dist(rng);
+    ac.hex = stage_dist(rng);
+
+    TevCombiner::QuadInputs inputs;
+    for (TevCombiner::QuadColors* colors : {&inputs.a, &inputs.b, &inputs.c, &inputs.d})
+    {
+      for (TevCombiner::PixelColor& pixel : colors->pixels)
+      {
+        for (s16& channel : pixel)
+          channel = static_cast<s16>(input_dist(rng));
+      }
+    }
+
+    ExpectSameAsScalar(implementations, cc, ac, inputs);
+  }
+}
+
+TEST(TevCombiner, EdgeValues)
+{
+  const std::vector<CombineImplementation> implementations = GetSIMDImplementations();
+  if (implementations.empty())
+    GTEST_SKIP() << "No SIMD implementation is supported by the host";
+
+  static constexpr std::array<s16, 9> values{-1024, -1, 0, 1, 127, 128, 255, 256, 1023};
+  static constexpr u32 num_values = static_cast<u32>(values.size());
+  static constexpr u32 num_combinations = num_values * num_values * num_values * num_values;
+  static constexpr u32 lanes_per_call = TevCombiner::QUAD_SIZE * 4;
+
+  // Every combination of the regular (non-compare) modes, used for both combiners
+  for (u32 bias = 0; bias < 3; bias++)
+  {
+    for (u32 op = 0; op < 2; op++)
+    {
+      for (u32 clamp = 0; clamp < 2; clamp++)
+      {
+        for (u32 scale = 0; scale < 4; scale++)
+        {
+          TevStageCombiner::ColorCombiner cc;
+          TevStageCombiner::AlphaCombiner ac;
+          cc.hex = (bias << 16) | (op << 18) | (clamp << 19) | (scale << 20);
+          ac.hex = cc.hex;
+
+          // Spread every combination of a, b, c and d over the lanes of the quad
+          for (u32 first = 0; first < num_combinations; first += lanes_per_call)
+          {
+            TevCombiner::QuadInputs inputs{};
+            for (u32 lane = 0; lane < lanes_per_call; lane++)
+            {
+              const u32 combination = (first + lane) % num_combinations;
+              const u32 pixel = lane / 4;
+              const u32 channel = lane % 4;
+              inputs.a.pixels[pixel][channel] = values[combination % num_values];
+              inputs.b.pixels[pixel][channel] = values[combination / num_values % num_values];
+              inputs.c.pixels[pixel][channel] =
+                  values[combination / (num_values * num_values) % num_values];
+              inputs.d.pixels[pixel][channel] =
+                  values[combination / (num_values * num_values * num_values)];
+            }
+
+            ExpectSameAsScalar(implementations, cc, ac, inputs);
+          }
+        }
+      }
+    }
+  }
+}